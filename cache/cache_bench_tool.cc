@@ -52,6 +52,10 @@ DEFINE_int32(
     eviction_effort_cap,
     ROCKSDB_NAMESPACE::HyperClockCacheOptions(1, 1).eviction_effort_cap,
     "HyperClockCacheOptions::eviction_effort_cap");
+DEFINE_double(
+    probationary_ratio,
+    ROCKSDB_NAMESPACE::HyperClockCacheOptions(1, 1).probationary_ratio,
+    "HyperClockCacheOptions::probationary_ratio");
 
 DEFINE_double(resident_ratio, 0.25,
               "Ratio of keys fitting in cache to keyspace.");
@@ -395,6 +399,7 @@ class CacheBench {
       opts.hash_seed = BitwiseAnd(FLAGS_seed, INT32_MAX);
       opts.memory_allocator = allocator;
       opts.eviction_effort_cap = FLAGS_eviction_effort_cap;
+      opts.probationary_ratio = FLAGS_probationary_ratio;
       if (FLAGS_cache_type == "fixed_hyper_clock_cache" ||
           FLAGS_cache_type == "hyper_clock_cache") {
         opts.estimated_entry_charge = FLAGS_value_bytes_estimate > 0
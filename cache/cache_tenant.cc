@@ -0,0 +1,96 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/cache_tenant.h"
+
+#include <cstring>
+
+namespace ROCKSDB_NAMESPACE {
+
+thread_local uint8_t tl_cache_tenant = 0;
+
+Status CacheTenant::Insert(const Slice& key, ObjectPtr value,
+                           const CacheItemHelper* helper, size_t charge,
+                           Handle** handle, Priority priority,
+                           const Slice& compressed_value,
+                           CompressionType type) {
+  CacheTenantScope scope(id_);
+  return target_->Insert(key, value, helper, charge, handle, priority,
+                         compressed_value, type);
+}
+
+Cache::Handle* CacheTenant::CreateStandalone(const Slice& key, ObjectPtr obj,
+                                             const CacheItemHelper* helper,
+                                             size_t charge,
+                                             bool allow_uncharged) {
+  CacheTenantScope scope(id_);
+  return target_->CreateStandalone(key, obj, helper, charge, allow_uncharged);
+}
+
+Cache::Handle* CacheTenant::Lookup(const Slice& key,
+                                   const CacheItemHelper* helper,
+                                   CreateContext* create_context,
+                                   Priority priority, Statistics* stats) {
+  // Entries promoted from a secondary cache belong to the tenant too
+  CacheTenantScope scope(id_);
+  Handle* handle =
+      target_->Lookup(key, helper, create_context, priority, stats);
+  RecordLookup(handle != nullptr);
+  return handle;
+}
+
+void CacheTenant::StartAsyncLookup(AsyncLookupHandle& async_handle) {
+  CacheTenantScope scope(id_);
+  target_->StartAsyncLookup(async_handle);
+  if (!async_handle.IsPending()) {
+    RecordLookup(async_handle.Result() != nullptr);
+  }
+}
+
+void CacheTenant::WaitAll(AsyncLookupHandle* async_handles, size_t count) {
+  CacheTenantScope scope(id_);
+  // Only the lookups completed here are still to be counted
+  std::unique_ptr<bool[]> pending(new bool[count]);
+  for (size_t i = 0; i < count; ++i) {
+    pending[i] = async_handles[i].IsPending();
+  }
+  target_->WaitAll(async_handles, count);
+  for (size_t i = 0; i < count; ++i) {
+    if (pending[i] && !async_handles[i].IsPending()) {
+      RecordLookup(async_handles[i].Result() != nullptr);
+    }
+  }
+}
+
+void CacheTenant::GetStats(CacheTenantStats* stats) const {
+  stats->name = opts_.name;
+  stats->reserved_ratio = opts_.reserved_ratio;
+  stats->max_ratio = opts_.max_ratio;
+  stats->usage = target_->GetTenantUsage(id_);
+  stats->hits = hits_.LoadRelaxed();
+  stats->misses = misses_.LoadRelaxed();
+}
+
+std::shared_ptr<Cache> NewCacheTenant(const std::shared_ptr<Cache>& cache,
+                                      const CacheTenantOptions& opts) {
+  if (!cache) {
+    return nullptr;
+  }
+  uint8_t id = 0;
+  if (!cache->AddTenant(opts, &id).ok()) {
+    return nullptr;
+  }
+  return std::make_shared<CacheTenant>(cache, id, opts);
+}
+
+Status GetCacheTenantStats(const Cache& cache, CacheTenantStats* stats) {
+  if (strcmp(cache.Name(), CacheTenant::kClassName())) {
+    return Status::InvalidArgument("Not a cache tenant");
+  }
+  static_cast<const CacheTenant&>(cache).GetStats(stats);
+  return Status::OK();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,144 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "rocksdb/advanced_cache.h"
+#include "util/atomic.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Tenants of a cache are numbered from 1. Tenant 0 owns the entries that
+// are not inserted through a CacheTenant, which are neither protected nor
+// limited.
+constexpr uint8_t kMaxCacheTenants = 16;
+
+// The tenant owning the entries inserted by the current thread, set by
+// CacheTenantScope
+extern thread_local uint8_t tl_cache_tenant;
+
+inline uint8_t GetCurrentCacheTenant() { return tl_cache_tenant; }
+
+// Makes the current thread insert entries on behalf of `tenant` until the
+// end of the scope
+class CacheTenantScope {
+ public:
+  explicit CacheTenantScope(uint8_t tenant) : saved_(tl_cache_tenant) {
+    tl_cache_tenant = tenant;
+  }
+  ~CacheTenantScope() { tl_cache_tenant = saved_; }
+
+  CacheTenantScope(const CacheTenantScope&) = delete;
+  CacheTenantScope& operator=(const CacheTenantScope&) = delete;
+
+ private:
+  const uint8_t saved_;
+};
+
+// The usage of a cache shard by each tenant, along with the share of the
+// shard reserved for each tenant and the ceiling on its usage, which guide
+// the choice of the entries to evict (see CacheTenantOptions). Usage is
+// only tracked for tenants other than 0.
+class CacheTenantUsage {
+ public:
+  // Whether any tenant has been added, so that the entries to evict might
+  // have to be chosen by tenant
+  bool IsActive() const { return active_.LoadRelaxed(); }
+
+  void SetLimits(uint8_t tenant, size_t reserved, size_t max) {
+    assert(tenant > 0 && tenant < kMaxCacheTenants);
+    tenants_[tenant].reserved.StoreRelaxed(reserved);
+    tenants_[tenant].max.StoreRelaxed(max);
+    active_.StoreRelaxed(true);
+  }
+
+  void Charge(uint8_t tenant, size_t charge) {
+    if (tenant != 0) {
+      tenants_[tenant].usage.FetchAddRelaxed(charge);
+    }
+  }
+
+  void Uncharge(uint8_t tenant, size_t charge) {
+    if (tenant != 0) {
+      assert(tenants_[tenant].usage.LoadRelaxed() >= charge);
+      tenants_[tenant].usage.FetchSubRelaxed(charge);
+    }
+  }
+
+  size_t GetUsage(uint8_t tenant) const {
+    return tenants_[tenant].usage.LoadRelaxed();
+  }
+
+  // Under its reservation: its entries are to be evicted last
+  bool IsProtected(uint8_t tenant) const {
+    return tenant != 0 && tenants_[tenant].usage.LoadRelaxed() <
+                              tenants_[tenant].reserved.LoadRelaxed();
+  }
+
+  // Over its ceiling: its entries are to be evicted first
+  bool IsOverLimit(uint8_t tenant) const {
+    return tenant != 0 && tenants_[tenant].usage.LoadRelaxed() >
+                              tenants_[tenant].max.LoadRelaxed();
+  }
+
+ private:
+  struct Tenant {
+    RelaxedAtomic<size_t> usage{0};
+    RelaxedAtomic<size_t> reserved{0};
+    RelaxedAtomic<size_t> max{SIZE_MAX};
+  };
+  std::array<Tenant, kMaxCacheTenants> tenants_;
+  RelaxedAtomic<bool> active_{false};
+};
+
+// The view of a cache returned by NewCacheTenant(), which inserts entries on
+// behalf of its tenant and counts its hits and misses
+class CacheTenant : public CacheWrapper {
+ public:
+  CacheTenant(std::shared_ptr<Cache> target, uint8_t id,
+              const CacheTenantOptions& opts)
+      : CacheWrapper(std::move(target)), id_(id), opts_(opts) {}
+
+  static const char* kClassName() { return "CacheTenant"; }
+  const char* Name() const override { return kClassName(); }
+
+  Status Insert(
+      const Slice& key, ObjectPtr value, const CacheItemHelper* helper,
+      size_t charge, Handle** handle = nullptr,
+      Priority priority = Priority::LOW,
+      const Slice& compressed_value = Slice(),
+      CompressionType type = CompressionType::kNoCompression) override;
+
+  Handle* CreateStandalone(const Slice& key, ObjectPtr obj,
+                           const CacheItemHelper* helper, size_t charge,
+                           bool allow_uncharged) override;
+
+  Handle* Lookup(const Slice& key, const CacheItemHelper* helper,
+                 CreateContext* create_context,
+                 Priority priority = Priority::LOW,
+                 Statistics* stats = nullptr) override;
+
+  void StartAsyncLookup(AsyncLookupHandle& async_handle) override;
+
+  void WaitAll(AsyncLookupHandle* async_handles, size_t count) override;
+
+  void GetStats(CacheTenantStats* stats) const;
+
+ private:
+  void RecordLookup(bool hit) {
+    (hit ? hits_ : misses_).FetchAddRelaxed(1);
+  }
+
+  const uint8_t id_;
+  const CacheTenantOptions opts_;
+  RelaxedAtomic<uint64_t> hits_{0};
+  RelaxedAtomic<uint64_t> misses_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -18,6 +18,7 @@
 #include "cache/lru_cache.h"
 #include "cache/typed_cache.h"
 #include "port/stack_trace.h"
+#include "rocksdb/statistics.h"
 #include "table/block_based/block_cache.h"
 #include "test_util/secondary_cache_test_util.h"
 #include "test_util/testharness.h"
@@ -809,6 +810,180 @@ TEST_P(CacheTest, OverCapacity) {
   }
 }
 
+TEST_P(CacheTest, FrequencyAdmission) {
+  std::shared_ptr<Statistics> stats = CreateDBStatistics();
+  const size_t kCapacity = 10;
+  std::shared_ptr<Cache> cache =
+      NewCache(kCapacity, [&](ShardedCacheOptions& opts) {
+        opts.num_shard_bits = 0;
+        opts.metadata_charge_policy = kDontChargeCacheMetadata;
+        opts.frequency_admission = true;
+        opts.admission_statistics = stats;
+      });
+  auto insert = [&](int key, Cache::Handle** handle = nullptr) {
+    ASSERT_OK(cache->Insert(EncodeKey(key), EncodeValue(key), &kHelper,
+                            /*charge=*/1, handle, Cache::Priority::LOW));
+  };
+
+  // A working set filling the cache, looked up repeatedly
+  for (int i = 0; i < static_cast<int>(kCapacity); ++i) {
+    ASSERT_EQ(Lookup(cache, i), -1);
+    insert(i);
+  }
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < static_cast<int>(kCapacity); ++i) {
+      ASSERT_EQ(Lookup(cache, i), i);
+    }
+  }
+  ASSERT_EQ(stats->getTickerCount(CACHE_ADMISSION_ADMITTED), 0);
+  ASSERT_EQ(stats->getTickerCount(CACHE_ADMISSION_REJECTED), 0);
+
+  // A scan of keys accessed once does not flush the working set
+  for (int i = 100; i < 200; ++i) {
+    ASSERT_EQ(Lookup(cache, i), -1);
+    insert(i);
+  }
+  int num_retained = 0;
+  for (int i = 0; i < static_cast<int>(kCapacity); ++i) {
+    num_retained += Lookup(cache, i) == i ? 1 : 0;
+  }
+  ASSERT_GE(num_retained, static_cast<int>(kCapacity) - 2);
+  ASSERT_GE(stats->getTickerCount(CACHE_ADMISSION_REJECTED), 95);
+  ASSERT_LE(stats->getTickerCount(CACHE_ADMISSION_ADMITTED), 5);
+  ASSERT_LE(cache->GetUsage(), kCapacity);
+
+  // A rejected entry is still usable through its handle
+  Cache::Handle* handle = nullptr;
+  insert(500, &handle);
+  ASSERT_NE(handle, nullptr);
+  ASSERT_EQ(DecodeValue(cache->Value(handle)), 500);
+  cache->Release(handle);
+  ASSERT_EQ(Lookup(cache, 500), -1);
+  ASSERT_LE(cache->GetUsage(), kCapacity);
+
+  // High priority entries are always admitted
+  ASSERT_OK(cache->Insert(EncodeKey(600), EncodeValue(600), &kHelper,
+                          /*charge=*/1, /*handle=*/nullptr,
+                          Cache::Priority::HIGH));
+  ASSERT_EQ(Lookup(cache, 600), 600);
+}
+
+TEST_P(CacheTest, ProbationaryQueue) {
+  if (GetParam() != kFixedHyperClock) {
+    ROCKSDB_GTEST_BYPASS("Only for FixedHyperClockCache");
+    return;
+  }
+  const int kCapacity = 100;
+  std::shared_ptr<Cache> cache =
+      NewCache(kCapacity, [](ShardedCacheOptions& opts) {
+        opts.num_shard_bits = 0;
+        opts.metadata_charge_policy = kDontChargeCacheMetadata;
+        static_cast<HyperClockCacheOptions&>(opts).probationary_ratio = 0.1;
+      });
+  auto insert = [&](int key) {
+    ASSERT_OK(cache->Insert(EncodeKey(key), EncodeValue(key), &kHelper,
+                            /*charge=*/1));
+  };
+  auto num_resident = [&](int begin, int end) {
+    int count = 0;
+    for (int i = begin; i < end; ++i) {
+      count += Lookup(cache, i) == i ? 1 : 0;
+    }
+    return count;
+  };
+
+  // A working set filling half of the cache, hit once
+  for (int i = 0; i < kCapacity / 2; ++i) {
+    insert(i);
+    ASSERT_EQ(Lookup(cache, i), i);
+  }
+  // Keys inserted and never hit are evicted before it
+  for (int i = 1000; i < 1500; ++i) {
+    insert(i);
+  }
+  ASSERT_EQ(num_resident(0, kCapacity / 2), kCapacity / 2);
+  ASSERT_LE(cache->GetUsage(), static_cast<size_t>(kCapacity));
+
+  // The key evicted last from probation skips it when inserted again
+  const int evicted = 1500 - kCapacity / 2 - 1;
+  ASSERT_EQ(Lookup(cache, evicted), -1);
+  insert(evicted);
+  for (int i = 2000; i < 2500; ++i) {
+    insert(i);
+  }
+  ASSERT_EQ(Lookup(cache, evicted), evicted);
+  ASSERT_EQ(num_resident(0, kCapacity / 2), kCapacity / 2);
+}
+
+TEST_P(CacheTest, Tenants) {
+  const size_t kCapacity = 100;
+  std::shared_ptr<Cache> cache = NewCache(kCapacity, 0, false);
+  CacheTenantOptions serving_opts;
+  serving_opts.name = "serving";
+  serving_opts.reserved_ratio = 0.5;
+  std::shared_ptr<Cache> serving = NewCacheTenant(cache, serving_opts);
+  if (GetParam() == kAutoHyperClock) {
+    ASSERT_EQ(serving, nullptr);
+    return;
+  }
+  ASSERT_NE(serving, nullptr);
+  CacheTenantOptions scan_opts;
+  scan_opts.name = "scan";
+  scan_opts.max_ratio = 0.2;
+  std::shared_ptr<Cache> scan = NewCacheTenant(cache, scan_opts);
+  ASSERT_NE(scan, nullptr);
+
+  // Invalid options
+  CacheTenantOptions bad_opts;
+  bad_opts.reserved_ratio = 0.6;
+  ASSERT_EQ(NewCacheTenant(cache, bad_opts), nullptr);
+  bad_opts.reserved_ratio = 0.3;
+  bad_opts.max_ratio = 0.2;
+  ASSERT_EQ(NewCacheTenant(cache, bad_opts), nullptr);
+
+  auto get_stats = [](const std::shared_ptr<Cache>& tenant) {
+    CacheTenantStats stats;
+    EXPECT_OK(GetCacheTenantStats(*tenant, &stats));
+    return stats;
+  };
+  CacheTenantStats stats;
+  ASSERT_TRUE(GetCacheTenantStats(*cache, &stats).IsInvalidArgument());
+
+  // A working set within the reservation of its tenant survives a scan
+  // through another tenant
+  for (int i = 0; i < 40; ++i) {
+    Insert(serving, i, i);
+  }
+  ASSERT_EQ(get_stats(serving).usage, 40U);
+  for (int i = 1000; i < 2000; ++i) {
+    Insert(scan, i, i);
+  }
+  ASSERT_LE(cache->GetUsage(), kCapacity);
+  for (int i = 0; i < 40; ++i) {
+    ASSERT_EQ(Lookup(serving, i), i);
+  }
+  ASSERT_EQ(Lookup(serving, 5000), -1);
+  stats = get_stats(serving);
+  ASSERT_EQ(stats.name, "serving");
+  ASSERT_EQ(stats.usage, 40U);
+  ASSERT_EQ(stats.hits, 40U);
+  ASSERT_EQ(stats.misses, 1U);
+
+  // A tenant over its ceiling gives way to all other entries
+  ASSERT_GT(get_stats(scan).usage, kCapacity / 5);
+  for (int i = 3000; i < 3060; ++i) {
+    Insert(cache, i, i);
+  }
+  ASSERT_LE(get_stats(scan).usage, kCapacity / 5);
+  ASSERT_EQ(get_stats(serving).usage, 40U);
+
+  // Usage is released along with the entries
+  for (int i = 0; i < 40; ++i) {
+    Erase(serving, i);
+  }
+  ASSERT_EQ(get_stats(serving).usage, 0U);
+}
+
 TEST_P(CacheTest, ApplyToAllEntriesTest) {
   std::vector<std::string> callback_state;
   const auto callback = [&](const Slice& key, Cache::ObjectPtr value,
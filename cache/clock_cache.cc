@@ -95,8 +95,17 @@ inline void Unref(const ClockHandle& h, uint64_t count = 1) {
   (void)old_meta;
 }
 
+// Identifies a key in the probationary FIFO and the ghost set of
+// FixedHyperClockTable, from hash bits independent of those selecting its
+// home slot. Never 0.
+inline uint32_t ProbationFingerprint(const UniqueId64x2& hashed_key) {
+  return Upper32of64(hashed_key[0]) | 1U;
+}
+
+// With `expire`, an unreferenced entry is evicted regardless of its clock
+// countdown.
 inline bool ClockUpdate(ClockHandle& h, BaseClockTable::EvictionData* data,
-                        bool* purgeable = nullptr) {
+                        bool* purgeable = nullptr, bool expire = false) {
   uint64_t meta;
   if (purgeable) {
     assert(*purgeable == false);
@@ -132,7 +141,7 @@ inline bool ClockUpdate(ClockHandle& h, BaseClockTable::EvictionData* data,
     return false;
   }
   if ((meta >> ClockHandle::kStateShift == ClockHandle::kStateVisible) &&
-      acquire_count > 0) {
+      acquire_count > 0 && !expire) {
     // Decrement clock
     uint64_t new_count =
         std::min(acquire_count - 1, uint64_t{ClockHandle::kMaxCountdown} - 1);
@@ -553,6 +562,10 @@ inline bool BaseClockTable::ChargeUsageMaybeEvictNonStrict(
 }
 
 void BaseClockTable::TrackAndReleaseEvictedEntry(ClockHandle* h) {
+  if (admission_sketch_ != nullptr) {
+    last_victim_frequency_.StoreRelaxed(
+        admission_sketch_->Estimate(h->GetHash()[1]));
+  }
   bool took_value_ownership = false;
   if (eviction_callback_) {
     // For key reconstructed from hash
@@ -578,6 +591,20 @@ bool IsEvictionEffortExceeded(const BaseClockTable::EvictionData& data,
          data.seen_pinned_count;
 }
 
+bool BaseClockTable::Admit(const ClockHandleBasicData& proto,
+                           Cache::Priority priority, size_t capacity,
+                           uint32_t eec_and_scl) const {
+  if (admission_sketch_ == nullptr || priority == Cache::Priority::HIGH ||
+      (eec_and_scl & kStrictCapacityLimitBit) ||
+      usage_.LoadRelaxed() + proto.GetTotalCharge() <= capacity) {
+    // No admission policy, or no eviction needed for the entry
+    return true;
+  }
+  return admission_sketch_->Admit(proto.hashed_key[1],
+                                  last_victim_frequency_.LoadRelaxed(),
+                                  admission_statistics_);
+}
+
 template <class Table>
 Status BaseClockTable::Insert(const ClockHandleBasicData& proto,
                               typename Table::HandleImpl** handle,
@@ -586,6 +613,18 @@ Status BaseClockTable::Insert(const ClockHandleBasicData& proto,
   using HandleImpl = typename Table::HandleImpl;
   Table& derived = static_cast<Table&>(*this);
 
+  if (!Admit(proto, priority, capacity, eec_and_scl)) {
+    // As if inserted and evicted immediately. A requested handle refers to
+    // a standalone entry.
+    if (handle == nullptr) {
+      proto.FreeData(allocator_);
+    } else {
+      usage_.FetchAddRelaxed(proto.GetTotalCharge());
+      *handle = StandaloneInsert<HandleImpl>(proto);
+    }
+    return Status::OK();
+  }
+
   typename Table::InsertState state;
   derived.StartInsert(state);
 
@@ -723,13 +762,31 @@ FixedHyperClockTable::FixedHyperClockTable(
     const Cache::EvictionCallback* eviction_callback, const uint32_t* hash_seed,
     const Opts& opts)
     : BaseClockTable(metadata_charge_policy, allocator, eviction_callback,
-                     hash_seed),
+                     hash_seed, opts, capacity / opts.estimated_value_size),
       length_bits_(CalcHashBits(capacity, opts.estimated_value_size,
                                 metadata_charge_policy)),
       length_bits_mask_((size_t{1} << length_bits_) - 1),
       occupancy_limit_(static_cast<size_t>((uint64_t{1} << length_bits_) *
                                            kStrictLoadFactor)),
-      array_(new HandleImpl[size_t{1} << length_bits_]) {
+      array_(new HandleImpl[size_t{1} << length_bits_]),
+      probation_target_(
+          opts.probationary_ratio > 0.0
+              ? std::max(size_t{1},
+                         static_cast<size_t>(
+                             std::min(opts.probationary_ratio, 1.0) *
+                             static_cast<double>(capacity) /
+                             static_cast<double>(opts.estimated_value_size)))
+              : 0),
+      // Room for twice the target, so that the ring rarely wraps around
+      probation_length_bits_(
+          probation_target_ > 0 ? FloorLog2(probation_target_) + 2 : 0),
+      probation_(probation_target_ > 0
+                     ? new RelaxedAtomic<uint64_t>[size_t{1}
+                                                   << probation_length_bits_]
+                     : nullptr),
+      ghost_(probation_target_ > 0
+                 ? new RelaxedAtomic<uint32_t>[size_t{1} << length_bits_]
+                 : nullptr) {
   if (metadata_charge_policy ==
       CacheMetadataChargePolicy::kFullChargeCacheMetadata) {
     usage_.FetchAddRelaxed(size_t{GetTableSize()} * sizeof(HandleImpl));
@@ -785,11 +842,22 @@ FixedHyperClockTable::HandleImpl* FixedHyperClockTable::DoInsert(
     const ClockHandleBasicData& proto, uint64_t initial_countdown,
     bool keep_ref, InsertState&) {
   bool already_matches = false;
+  const uint8_t tenant = GetCurrentCacheTenant();
   HandleImpl* e = FindSlot(
       proto.hashed_key,
       [&](HandleImpl* h) {
-        return TryInsert(proto, *h, initial_countdown, keep_ref,
-                         &already_matches);
+        if (!BeginSlotInsert(proto, *h, initial_countdown, &already_matches)) {
+          return false;
+        }
+        // Before the entry becomes visible, and so evictable
+        h->tenant.StoreRelaxed(tenant);
+        tenant_usage_.Charge(tenant, proto.GetTotalCharge());
+        FinishSlotInsert(proto, *h, initial_countdown, keep_ref);
+        if (probation_ != nullptr &&
+            StartsOnProbation(proto.hashed_key, initial_countdown)) {
+          PushProbation(*h);
+        }
+        return true;
       },
       [&](HandleImpl* h) {
         if (already_matches) {
@@ -863,8 +931,10 @@ FixedHyperClockTable::HandleImpl* FixedHyperClockTable::Lookup(
           // Acquired a read reference
           if (h->hashed_key == hashed_key) {
             // Match
-            // Update the hit bit
-            if (eviction_callback_) {
+            // Update the hit bit, which also ends probation
+            if (eviction_callback_ ||
+                (probation_ != nullptr &&
+                 (old_meta & ClockHandle::kHitBitMask) == 0)) {
               h->meta.FetchOrRelaxed(uint64_t{1} << ClockHandle::kHitBitShift);
             }
             return true;
@@ -954,6 +1024,7 @@ bool FixedHyperClockTable::Release(HandleImpl* h, bool useful,
       usage_.FetchSubRelaxed(total_charge);
     } else {
       Rollback(h->hashed_key, h);
+      tenant_usage_.Uncharge(h->tenant.LoadRelaxed(), total_charge);
       FreeDataMarkEmpty(*h, allocator_);
       ReclaimEntryUsage(total_charge);
     }
@@ -1010,6 +1081,7 @@ void FixedHyperClockTable::Erase(const UniqueId64x2& hashed_key) {
                 // Took ownership
                 assert(hashed_key == h->hashed_key);
                 size_t total_charge = h->GetTotalCharge();
+                tenant_usage_.Uncharge(h->tenant.LoadRelaxed(), total_charge);
                 FreeDataMarkEmpty(*h, allocator_);
                 ReclaimEntryUsage(total_charge);
                 // We already have a copy of hashed_key in this case, so OK to
@@ -1049,6 +1121,7 @@ void FixedHyperClockTable::EraseUnRefEntries() {
       // Took ownership
       size_t total_charge = h.GetTotalCharge();
       Rollback(h.hashed_key, &h);
+      tenant_usage_.Uncharge(h.tenant.LoadRelaxed(), total_charge);
       FreeDataMarkEmpty(h, allocator_);
       ReclaimEntryUsage(total_charge);
     }
@@ -1118,6 +1191,13 @@ inline void FixedHyperClockTable::Evict(size_t requested_charge, InsertState&,
   // precondition
   assert(requested_charge > 0);
 
+  if (probation_ != nullptr) {
+    EvictFromProbation(requested_charge, data);
+    if (data->freed_charge >= requested_charge) {
+      return;
+    }
+  }
+
   // TODO: make a tuning parameter?
   constexpr size_t step_size = 4;
 
@@ -1132,11 +1212,25 @@ inline void FixedHyperClockTable::Evict(size_t requested_charge, InsertState&,
   uint64_t max_clock_pointer =
       old_clock_pointer + (ClockHandle::kMaxCountdown << length_bits_);
 
+  const bool by_tenant = tenant_usage_.IsActive();
+
   for (;;) {
     for (size_t i = 0; i < step_size; i++) {
       HandleImpl& h = array_[ModTableSize(Lower32of64(old_clock_pointer + i))];
-      bool evicting = ClockUpdate(h, data);
+      bool expire = false;
+      if (by_tenant) {
+        // Possibly stale unless the entry is evicted, which is fine for a
+        // hint
+        const uint8_t tenant = h.tenant.LoadRelaxed();
+        if (tenant_usage_.IsProtected(tenant)) {
+          // Kept, without aging, while under its reservation
+          continue;
+        }
+        expire = tenant_usage_.IsOverLimit(tenant);
+      }
+      bool evicting = ClockUpdate(h, data, /*purgeable=*/nullptr, expire);
       if (evicting) {
+        tenant_usage_.Uncharge(h.tenant.LoadRelaxed(), h.GetTotalCharge());
         Rollback(h.hashed_key, &h);
         TrackAndReleaseEvictedEntry(&h);
       }
@@ -1159,6 +1253,86 @@ inline void FixedHyperClockTable::Evict(size_t requested_charge, InsertState&,
   }
 }
 
+bool FixedHyperClockTable::StartsOnProbation(const UniqueId64x2& hashed_key,
+                                             uint64_t initial_countdown) {
+  if (initial_countdown >= ClockHandle::kHighCountdown) {
+    // High priority entries are trusted to be worth keeping
+    return false;
+  }
+  const uint32_t fingerprint = ProbationFingerprint(hashed_key);
+  auto& ghost = ghost_[ModTableSize(hashed_key[1])];
+  uint32_t expected = fingerprint;
+  // Evicted from probation recently: re-admitted to the main CLOCK
+  return !ghost.CasStrongRelaxed(expected, 0);
+}
+
+void FixedHyperClockTable::PushProbation(const HandleImpl& h) {
+  const uint64_t item =
+      (uint64_t{ProbationFingerprint(h.hashed_key)} << 32) |
+      (static_cast<uint64_t>(&h - array_.get()) + 1);
+  const uint64_t pos = probation_tail_.FetchAddRelaxed(1);
+  probation_[BottomNBits(pos, probation_length_bits_)].StoreRelaxed(item);
+}
+
+void FixedHyperClockTable::EvictFromProbation(size_t requested_charge,
+                                              EvictionData* data) {
+  const uint64_t ring_length = uint64_t{1} << probation_length_bits_;
+  const bool by_tenant = tenant_usage_.IsActive();
+  for (;;) {
+    uint64_t head = probation_head_.LoadRelaxed();
+    const uint64_t tail = probation_tail_.LoadRelaxed();
+    if (head >= tail || tail - head <= probation_target_) {
+      // Probation within its target, evict from the main CLOCK
+      return;
+    }
+    // Skip over entries already overwritten by newer ones
+    const uint64_t new_head =
+        (tail - head > ring_length ? tail - ring_length : head) + 1;
+    if (!probation_head_.CasWeakRelaxed(head, new_head)) {
+      continue;
+    }
+    const uint64_t item =
+        probation_[BottomNBits(new_head - 1, probation_length_bits_)]
+            .ExchangeRelaxed(0);
+    if (item == 0) {
+      // Not yet stored by its inserter, or taken by a concurrent eviction
+      continue;
+    }
+    HandleImpl& h = array_[Lower32of64(item) - 1];
+
+    // Reference the entry to check whether it is still the one pushed, like
+    // a Lookup
+    const uint64_t old_meta = h.meta.FetchAdd(ClockHandle::kAcquireIncrement);
+    const uint64_t state = old_meta >> ClockHandle::kStateShift;
+    if (state != ClockHandle::kStateVisible) {
+      if (state == ClockHandle::kStateInvisible) {
+        Unref(h);
+      }
+      continue;
+    }
+    const bool same_entry =
+        ProbationFingerprint(h.hashed_key) == Upper32of64(item);
+    Unref(h);
+    if (!same_entry || (old_meta & ClockHandle::kHitBitMask)) {
+      // Gone, or hit while on probation and so promoted to the main CLOCK
+      continue;
+    }
+    if (by_tenant && tenant_usage_.IsProtected(h.tenant.LoadRelaxed())) {
+      continue;
+    }
+    if (ClockUpdate(h, data, /*purgeable=*/nullptr, /*expire=*/true)) {
+      ghost_[ModTableSize(h.hashed_key[1])].StoreRelaxed(
+          ProbationFingerprint(h.hashed_key));
+      tenant_usage_.Uncharge(h.tenant.LoadRelaxed(), h.GetTotalCharge());
+      Rollback(h.hashed_key, &h);
+      TrackAndReleaseEvictedEntry(&h);
+      if (data->freed_charge >= requested_charge) {
+        return;
+      }
+    }
+  }
+}
+
 template <class Table>
 ClockCacheShard<Table>::ClockCacheShard(
     size_t capacity, bool strict_capacity_limit,
@@ -1299,6 +1473,7 @@ typename ClockCacheShard<Table>::HandleImpl* ClockCacheShard<Table>::Lookup(
   if (UNLIKELY(key.size() != kCacheKeySize)) {
     return nullptr;
   }
+  table_.RecordLookup(hashed_key);
   return table_.Lookup(hashed_key);
 }
 
@@ -1974,7 +2149,8 @@ AutoHyperClockTable::AutoHyperClockTable(
     const Cache::EvictionCallback* eviction_callback, const uint32_t* hash_seed,
     const Opts& opts)
     : BaseClockTable(metadata_charge_policy, allocator, eviction_callback,
-                     hash_seed),
+                     hash_seed, opts,
+                     capacity / std::max(opts.min_avg_value_size, size_t{1})),
       array_(MemMapping::AllocateLazyZeroed(
           sizeof(HandleImpl) * CalcMaxUsableLength(capacity,
                                                    opts.min_avg_value_size,
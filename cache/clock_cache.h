@@ -18,6 +18,8 @@
 #include <string>
 
 #include "cache/cache_key.h"
+#include "cache/cache_tenant.h"
+#include "cache/frequency_sketch.h"
 #include "cache/sharded_cache.h"
 #include "port/lang.h"
 #include "port/malloc.h"
@@ -379,18 +381,30 @@ class BaseClockTable {
     explicit BaseOpts(int _eviction_effort_cap)
         : eviction_effort_cap(_eviction_effort_cap) {}
     explicit BaseOpts(const HyperClockCacheOptions& opts)
-        : BaseOpts(opts.eviction_effort_cap) {}
+        : BaseOpts(opts.eviction_effort_cap) {
+      frequency_admission = opts.frequency_admission;
+      admission_statistics = opts.admission_statistics.get();
+    }
     int eviction_effort_cap;
+    // See ShardedCacheOptions::frequency_admission
+    bool frequency_admission = false;
+    Statistics* admission_statistics = nullptr;
   };
 
+  // `expected_entries` sizes the admission sketch, if any
   BaseClockTable(CacheMetadataChargePolicy metadata_charge_policy,
                  MemoryAllocator* allocator,
                  const Cache::EvictionCallback* eviction_callback,
-                 const uint32_t* hash_seed)
+                 const uint32_t* hash_seed, const BaseOpts& opts,
+                 size_t expected_entries)
       : metadata_charge_policy_(metadata_charge_policy),
         allocator_(allocator),
         eviction_callback_(*eviction_callback),
-        hash_seed_(*hash_seed) {}
+        hash_seed_(*hash_seed),
+        admission_sketch_(opts.frequency_admission
+                              ? new FrequencySketch(expected_entries)
+                              : nullptr),
+        admission_statistics_(opts.admission_statistics) {}
 
   template <class Table>
   typename Table::HandleImpl* CreateStandalone(ClockHandleBasicData& proto,
@@ -405,6 +419,13 @@ class BaseClockTable {
 
   void Ref(ClockHandle& handle);
 
+  // Records a lookup of `hashed_key`, for frequency-based admission
+  void RecordLookup(const UniqueId64x2& hashed_key) {
+    if (admission_sketch_ != nullptr) {
+      admission_sketch_->Increment(hashed_key[1]);
+    }
+  }
+
   size_t GetOccupancy() const { return occupancy_.LoadRelaxed(); }
 
   size_t GetUsage() const { return usage_.LoadRelaxed(); }
@@ -441,6 +462,12 @@ class BaseClockTable {
   template <class HandleImpl>
   HandleImpl* StandaloneInsert(const ClockHandleBasicData& proto);
 
+  // Whether a new entry should be inserted, according to admission_sketch_.
+  // As the next eviction victim is not known ahead of the eviction, the
+  // entry is compared to the entry evicted last.
+  bool Admit(const ClockHandleBasicData& proto, Cache::Priority priority,
+             size_t capacity, uint32_t eec_and_scl) const;
+
   // Helper for updating `usage_` for new entry with given `total_charge`
   // and evicting if needed under strict_capacity_limit=true rules. This
   // means the operation might fail with Status::MemoryLimit. If
@@ -508,6 +535,14 @@ class BaseClockTable {
 
   // A reference to ShardedCacheBase::hash_seed_
   const uint32_t& hash_seed_;
+
+  // Recent lookups, for frequency-based admission. nullptr if disabled.
+  const std::unique_ptr<FrequencySketch> admission_sketch_;
+  Statistics* const admission_statistics_;
+
+  // Estimated frequency of the entry evicted last, if admission_sketch_
+  // (Relaxed: an approximation anyway)
+  RelaxedAtomic<uint32_t> last_victim_frequency_{};
 };
 
 // Hash table for cache entries with size determined at creation time.
@@ -534,6 +569,12 @@ class FixedHyperClockTable : public BaseClockTable {
     // regression.
     bool standalone = false;
 
+    // Tenant owning the entry (see CacheTenantUsage). Standalone entries
+    // are not accounted to any tenant.
+    // (Relaxed: set before the entry becomes visible, and only read
+    // reliably by its owner)
+    RelaxedAtomic<uint8_t> tenant{};
+
     inline bool IsStandalone() const { return standalone; }
 
     inline void SetStandalone() { standalone = true; }
@@ -543,12 +584,14 @@ class FixedHyperClockTable : public BaseClockTable {
     explicit Opts(size_t _estimated_value_size, int _eviction_effort_cap)
         : BaseOpts(_eviction_effort_cap),
           estimated_value_size(_estimated_value_size) {}
-    explicit Opts(const HyperClockCacheOptions& opts)
-        : BaseOpts(opts.eviction_effort_cap) {
+    explicit Opts(const HyperClockCacheOptions& opts) : BaseOpts(opts) {
       assert(opts.estimated_entry_charge > 0);
       estimated_value_size = opts.estimated_entry_charge;
+      probationary_ratio = opts.probationary_ratio;
     }
     size_t estimated_value_size;
+    // See HyperClockCacheOptions::probationary_ratio
+    double probationary_ratio = 0.0;
   };
 
   FixedHyperClockTable(size_t capacity,
@@ -588,6 +631,8 @@ class FixedHyperClockTable : public BaseClockTable {
 
   size_t GetOccupancyLimit() const { return occupancy_limit_; }
 
+  CacheTenantUsage* GetTenantUsage() { return &tenant_usage_; }
+
   const HandleImpl* HandlePtr(size_t idx) const { return &array_[idx]; }
 
 #ifndef NDEBUG
@@ -653,6 +698,20 @@ class FixedHyperClockTable : public BaseClockTable {
   // before releasing it so that it can be provided to this function.
   inline void ReclaimEntryUsage(size_t total_charge);
 
+  // Whether a new entry starts on probation (see probation_), rather than
+  // directly in the main CLOCK, in which case it is taken out of the ghost
+  // set if there
+  bool StartsOnProbation(const UniqueId64x2& hashed_key,
+                         uint64_t initial_countdown);
+
+  // Appends a new entry to the probationary FIFO
+  void PushProbation(const HandleImpl& h);
+
+  // Evicts from the head of the probationary FIFO while it holds more than
+  // its target number of entries, until `requested_charge` is reclaimed.
+  // Entries that were hit while on probation are left to the main CLOCK.
+  void EvictFromProbation(size_t requested_charge, EvictionData* data);
+
   MemoryAllocator* GetAllocator() const { return allocator_; }
 
   // Returns the number of bits used to hash an element in the hash
@@ -673,6 +732,28 @@ class FixedHyperClockTable : public BaseClockTable {
 
   // Array of slots comprising the hash table.
   const std::unique_ptr<HandleImpl[]> array_;
+
+  // Part of usage_ by each tenant
+  CacheTenantUsage tenant_usage_;
+
+  // S3-FIFO style probation (see HyperClockCacheOptions::probationary_ratio),
+  // disabled if probation_ is nullptr. probation_ is a ring of the entries
+  // inserted on probation, oldest at probation_head_, each as its slot index
+  // + 1 in the lower 32 bits and the fingerprint of its key in the upper 32
+  // bits. Entries evicted, erased or replaced since are skipped when they
+  // reach the head. Entries overwritten when the ring wraps around are
+  // left to the main CLOCK.
+  // (Relaxed: a heuristic, with entry ownership handled through meta)
+  const size_t probation_target_;
+  const int probation_length_bits_;
+  const std::unique_ptr<RelaxedAtomic<uint64_t>[]> probation_;
+  RelaxedAtomic<uint64_t> probation_head_{};
+  RelaxedAtomic<uint64_t> probation_tail_{};
+
+  // Fingerprints of the keys recently evicted from probation, indexed by
+  // hash, so that they skip probation when inserted again. Sized like the
+  // table, so about as many keys as the main CLOCK holds.
+  const std::unique_ptr<RelaxedAtomic<uint32_t>[]> ghost_;
 };  // class FixedHyperClockTable
 
 // Hash table for cache entries that resizes automatically based on occupancy.
@@ -833,8 +914,7 @@ class AutoHyperClockTable : public BaseClockTable {
         : BaseOpts(_eviction_effort_cap),
           min_avg_value_size(_min_avg_value_size) {}
 
-    explicit Opts(const HyperClockCacheOptions& opts)
-        : BaseOpts(opts.eviction_effort_cap) {
+    explicit Opts(const HyperClockCacheOptions& opts) : BaseOpts(opts) {
       assert(opts.estimated_entry_charge == 0);
       min_avg_value_size = opts.min_avg_entry_charge;
     }
@@ -883,6 +963,9 @@ class AutoHyperClockTable : public BaseClockTable {
 
   size_t GetOccupancyLimit() const;
 
+  // No room in HandleImpl for the tenant of an entry
+  CacheTenantUsage* GetTenantUsage() { return nullptr; }
+
   const HandleImpl* HandlePtr(size_t idx) const { return &array_[idx]; }
 
 #ifndef NDEBUG
@@ -1071,6 +1154,8 @@ class ALIGN_AS(CACHE_LINE_SIZE) ClockCacheShard final : public CacheShardBase {
 
   size_t GetTableAddressCount() const;
 
+  CacheTenantUsage* GetTenantUsage() { return table_.GetTenantUsage(); }
+
   void ApplyToSomeEntries(
       const std::function<void(const Slice& key, Cache::ObjectPtr obj,
                                size_t charge,
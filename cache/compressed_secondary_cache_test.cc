@@ -1365,6 +1365,90 @@ TEST_P(CompressedSecCacheTestWithTiered, ReservationOverCapacity) {
   ASSERT_OK(cache_res_mgr()->UpdateCacheReservation(0));
 }
 
+TEST_P(CompressedSecCacheTestWithTiered, AdaptiveRatio) {
+  if (std::get<0>(GetParam()) != PrimaryCacheType::kCacheTypeLRU) {
+    ROCKSDB_GTEST_BYPASS("Needs exact LRU behavior in the primary cache");
+    return;
+  }
+  constexpr size_t kTotalCapacity = 4 << 20;
+  constexpr size_t kItemSize = 1 << 10;
+  constexpr size_t kNumItems = kTotalCapacity / kItemSize;
+
+  // Reads a loop of `loop_size` items `num_passes` times, inserting the
+  // ones that are not found, and returns the resulting ratio
+  auto run = [&](size_t loop_size, int num_passes) {
+    LRUCacheOptions lru_opts;
+    lru_opts.num_shard_bits = 0;
+    lru_opts.high_pri_pool_ratio = 0;
+    lru_opts.metadata_charge_policy = kDontChargeCacheMetadata;
+    TieredCacheOptions opts;
+    opts.cache_opts = &lru_opts;
+    opts.cache_type = PrimaryCacheType::kCacheTypeLRU;
+    opts.adm_policy = TieredAdmissionPolicy::kAdmPolicyAllowAll;
+    opts.comp_cache_opts.num_shard_bits = 0;
+    opts.comp_cache_opts.compression_type = kNoCompression;
+    opts.total_capacity = kTotalCapacity;
+    opts.compressed_secondary_ratio = 0.5;
+    opts.adaptive_compressed_secondary_ratio = true;
+    opts.min_compressed_secondary_ratio = 0.2;
+    opts.max_compressed_secondary_ratio = 0.8;
+    opts.adaptive_ratio_step = 0.1;
+    opts.adaptive_tuning_interval = kNumItems;
+    std::shared_ptr<Cache> tiered_cache = NewTieredCache(opts);
+    EXPECT_NE(tiered_cache, nullptr);
+
+    Random rnd(301);
+    std::string val = rnd.RandomString(kItemSize);
+    std::vector<CacheKey> keys;
+    for (size_t i = 0; i < loop_size; ++i) {
+      keys.emplace_back(
+          CacheKey::CreateUniqueForCacheLifetime(tiered_cache.get()));
+    }
+    for (int pass = 0; pass < num_passes; ++pass) {
+      for (const CacheKey& key : keys) {
+        Cache::Handle* handle =
+            tiered_cache->Lookup(key.AsSlice(), GetHelper(),
+                                 /*context*/ this, Cache::Priority::LOW);
+        if (handle != nullptr) {
+          tiered_cache->Release(handle);
+        } else {
+          EXPECT_OK(tiered_cache->Insert(key.AsSlice(),
+                                         new TestItem(val.data(), val.size()),
+                                         GetHelper(), val.size()));
+        }
+      }
+    }
+    size_t sec_capacity = 0;
+    EXPECT_OK(tiered_cache->GetSecondaryCacheCapacity(sec_capacity));
+    return static_cast<double>(sec_capacity) / kTotalCapacity;
+  };
+
+  // Slightly more than fits in the primary cache, but a larger primary cache
+  // would hit where the secondary cache does
+  double ratio = run(kNumItems / 2 + kNumItems / 20, 20);
+  EXPECT_LT(ratio, 0.45);
+  EXPECT_GE(ratio, 0.2 - 0.01);
+
+  // Slightly more than fits in both, and nothing would be gained from a
+  // larger primary cache
+  ratio = run(kNumItems + kNumItems / 20, 20);
+  EXPECT_GT(ratio, 0.55);
+  EXPECT_LE(ratio, 0.8 + 0.01);
+
+  // Invalid bounds
+  LRUCacheOptions lru_opts;
+  TieredCacheOptions opts;
+  opts.cache_opts = &lru_opts;
+  opts.total_capacity = kTotalCapacity;
+  opts.compressed_secondary_ratio = 0.5;
+  opts.adaptive_compressed_secondary_ratio = true;
+  opts.min_compressed_secondary_ratio = 0.0;
+  ASSERT_EQ(NewTieredCache(opts), nullptr);
+  opts.min_compressed_secondary_ratio = 0.6;
+  opts.max_compressed_secondary_ratio = 0.4;
+  ASSERT_EQ(NewTieredCache(opts), nullptr);
+}
+
 INSTANTIATE_TEST_CASE_P(
     CompressedSecCacheTests, CompressedSecCacheTestWithTiered,
     ::testing::Values(
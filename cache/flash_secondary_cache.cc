@@ -0,0 +1,450 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/flash_secondary_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "file/file_util.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/hash.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+FlashSecondaryCacheResultHandle::FlashSecondaryCacheResultHandle(
+    FileSystem* fs, const Slice& key, const Cache::CacheItemHelper* helper,
+    Cache::CreateContext* create_context)
+    : fs_(fs),
+      key_(key.ToString()),
+      helper_(helper),
+      create_context_(create_context) {}
+
+FlashSecondaryCacheResultHandle::~FlashSecondaryCacheResultHandle() {
+  if (io_handle_ != nullptr) {
+    if (!read_done_) {
+      // The read must not complete into scratch_ once it is freed
+      std::vector<void*> io_handles{io_handle_};
+      fs_->AbortIO(io_handles).PermitUncheckedError();
+    }
+    del_fn_(io_handle_);
+  }
+  req_.status.PermitUncheckedError();
+}
+
+void FlashSecondaryCacheResultHandle::Wait() {
+  if (ready_) {
+    return;
+  }
+  if (!read_done_) {
+    assert(io_handle_ != nullptr);
+    std::vector<void*> io_handles{io_handle_};
+    fs_->Poll(io_handles, 1).PermitUncheckedError();
+  }
+  CompleteRead();
+}
+
+void FlashSecondaryCacheResultHandle::OnReadDone(FSReadRequest& req,
+                                                 void* cb_arg) {
+  auto* handle = static_cast<FlashSecondaryCacheResultHandle*>(cb_arg);
+  // Without FileSystem support, ReadAsync reads synchronously into req_
+  if (&req != &handle->req_) {
+    handle->req_.status = req.status;
+    handle->req_.result = req.result;
+  }
+  handle->read_done_ = true;
+}
+
+void FlashSecondaryCacheResultHandle::CompleteRead() {
+  if (req_.status.ok() && req_.result.size() == req_.len) {
+    Complete(req_.result);
+  } else {
+    req_.status.PermitUncheckedError();
+    ready_ = true;
+  }
+}
+
+void FlashSecondaryCacheResultHandle::Complete(const Slice& record) {
+  assert(!ready_);
+  ready_ = true;
+  if (record.size() < FlashSecondaryCache::kRecordHeaderSize) {
+    return;
+  }
+  const char* p = record.data();
+  const uint32_t value_size = DecodeFixed32(p + 4);
+  const auto type = static_cast<CompressionType>(p[8]);
+  const auto source = static_cast<CacheTier>(p[9]);
+  const uint16_t key_size = DecodeFixed16(p + 10);
+  const size_t record_size =
+      FlashSecondaryCache::kRecordHeaderSize + key_size + size_t{value_size};
+  if (record_size > record.size() ||
+      crc32c::Unmask(DecodeFixed32(p)) !=
+          crc32c::Value(p + 4, record_size - 4)) {
+    return;
+  }
+  const char* key = p + FlashSecondaryCache::kRecordHeaderSize;
+  if (Slice(key, key_size) != key_) {
+    return;
+  }
+  Cache::ObjectPtr value = nullptr;
+  size_t charge = 0;
+  Status s = helper_->create_cb(Slice(key + key_size, value_size), type,
+                                source, create_context_,
+                                /*allocator=*/nullptr, &value, &charge);
+  if (s.ok()) {
+    value_ = value;
+    size_ = charge;
+  }
+}
+
+Status FlashSecondaryCache::Create(const FlashSecondaryCacheOptions& opts,
+                                   std::shared_ptr<SecondaryCache>* result) {
+  assert(result);
+  if (opts.path.empty()) {
+    return Status::InvalidArgument("FlashSecondaryCache requires a path");
+  }
+  if (opts.region_size < kAlignment || opts.region_size > kMaxRegionSize ||
+      opts.region_size % kAlignment != 0) {
+    return Status::InvalidArgument(
+        "FlashSecondaryCache region_size must be a multiple of 64 and at "
+        "most 32MB");
+  }
+  std::vector<size_t> size_classes;
+  for (uint32_t size_class : opts.size_classes) {
+    const size_t rounded =
+        (size_t{size_class} + kAlignment - 1) / kAlignment * kAlignment;
+    if (rounded == 0 || rounded > opts.region_size ||
+        (!size_classes.empty() && rounded <= size_classes.back())) {
+      return Status::InvalidArgument(
+          "FlashSecondaryCache size_classes must be increasing and fit in a "
+          "region");
+    }
+    size_classes.push_back(rounded);
+  }
+  const size_t num_regions = opts.capacity / opts.region_size;
+  // One region being filled per size class and for large entries, plus two
+  // so that one can be written out while another is reclaimed.
+  if (num_regions < size_classes.size() + 3 ||
+      num_regions > (size_t{1} << 24)) {
+    return Status::InvalidArgument(
+        "FlashSecondaryCache capacity does not allow enough regions");
+  }
+  std::shared_ptr<FileSystem> fs = opts.file_system;
+  if (!fs) {
+    fs = FileSystem::Default();
+  }
+  std::unique_ptr<FlashSecondaryCache> cache(new FlashSecondaryCache(
+      opts, std::move(fs), num_regions, std::move(size_classes)));
+  Status s = cache->Open();
+  if (s.ok()) {
+    result->reset(cache.release());
+  }
+  return s;
+}
+
+FlashSecondaryCache::FlashSecondaryCache(
+    const FlashSecondaryCacheOptions& opts, std::shared_ptr<FileSystem> fs,
+    size_t num_regions, std::vector<size_t> size_classes)
+    : opts_(opts),
+      fs_(std::move(fs)),
+      region_size_(opts.region_size),
+      num_regions_(num_regions),
+      size_classes_(std::move(size_classes)),
+      regions_(num_regions),
+      active_regions_(size_classes_.size() + 1, kNoRegion) {
+  free_regions_.reserve(num_regions_);
+  for (size_t i = num_regions_; i > 0; --i) {
+    free_regions_.push_back(static_cast<uint32_t>(i - 1));
+  }
+}
+
+FlashSecondaryCache::~FlashSecondaryCache() {
+  write_file_.reset();
+  read_file_.reset();
+  fs_->DeleteFile(opts_.path, IOOptions(), nullptr).PermitUncheckedError();
+}
+
+Status FlashSecondaryCache::Open() {
+  FileOptions file_opts;
+  IOStatus s;
+  {
+    // Create or truncate the file
+    std::unique_ptr<FSWritableFile> file;
+    s = fs_->NewWritableFile(opts_.path, file_opts, &file, nullptr);
+    if (s.ok()) {
+      s = file->Close(IOOptions(), nullptr);
+    }
+  }
+  if (s.ok()) {
+    s = fs_->NewRandomRWFile(opts_.path, file_opts, &write_file_, nullptr);
+  }
+  if (s.ok()) {
+    s = fs_->NewRandomAccessFile(opts_.path, file_opts, &read_file_, nullptr);
+  }
+  use_async_io_ = CheckFSFeatureSupport(fs_.get(), FSSupportedOps::kAsyncIO);
+  return s;
+}
+
+Status FlashSecondaryCache::Insert(const Slice& key, Cache::ObjectPtr obj,
+                                   const Cache::CacheItemHelper* helper,
+                                   bool /*force_insert*/) {
+  if (!helper->IsSecondaryCacheCompatible()) {
+    return Status::OK();
+  }
+  const size_t size = helper->size_cb(obj);
+  std::string saved(size, '\0');
+  Status s = helper->saveto_cb(obj, 0, size, saved.data());
+  if (!s.ok()) {
+    return s;
+  }
+  return InsertSaved(key, saved, kNoCompression, CacheTier::kVolatileTier);
+}
+
+Status FlashSecondaryCache::InsertSaved(const Slice& key, const Slice& saved,
+                                        CompressionType type,
+                                        CacheTier source) {
+  const size_t record_size = kRecordHeaderSize + key.size() + saved.size();
+  if (key.size() > UINT16_MAX || saved.size() > UINT32_MAX ||
+      record_size > region_size_) {
+    // Not cached
+    return Status::OK();
+  }
+  const size_t size_class =
+      std::lower_bound(size_classes_.begin(), size_classes_.end(),
+                       record_size) -
+      size_classes_.begin();
+  const size_t slot_size =
+      size_class < size_classes_.size()
+          ? size_classes_[size_class]
+          : (record_size + kAlignment - 1) / kAlignment * kAlignment;
+
+  std::string record;
+  record.reserve(slot_size);
+  PutFixed32(&record, 0);
+  PutFixed32(&record, static_cast<uint32_t>(saved.size()));
+  record.push_back(static_cast<char>(type));
+  record.push_back(static_cast<char>(source));
+  PutFixed16(&record, static_cast<uint16_t>(key.size()));
+  record.append(key.data(), key.size());
+  record.append(saved.data(), saved.size());
+  const uint32_t checksum =
+      crc32c::Value(record.data() + 4, record_size - 4);
+  EncodeFixed32(record.data(), crc32c::Mask(checksum));
+  record.resize(slot_size);
+
+  const uint64_t hash = GetSliceNPHash64(key);
+  uint32_t filled = kNoRegion;
+  std::shared_ptr<std::string> filled_buffer;
+  {
+    MutexLock l(&mutex_);
+    uint32_t& active = active_regions_[size_class];
+    if (active != kNoRegion &&
+        regions_[active].buffer->size() + slot_size > region_size_) {
+      filled = active;
+      filled_buffer = regions_[active].buffer;
+      filled_regions_.push_back(active);
+      active = kNoRegion;
+    }
+    if (active == kNoRegion && AllocateRegion(&active)) {
+      Region& region = regions_[active];
+      region.size_class = size_class;
+      region.buffer = std::make_shared<std::string>();
+      region.buffer->reserve(region_size_);
+    }
+    // Otherwise all regions are being filled or written out; drop the entry
+    if (active != kNoRegion) {
+      Region& region = regions_[active];
+      const size_t offset = region.buffer->size();
+      region.buffer->append(record);
+      region.hashes.push_back(hash);
+      index_[hash] = PackLocation(active, offset, slot_size);
+    }
+  }
+  if (filled != kNoRegion) {
+    FlushRegion(filled, std::move(filled_buffer));
+  }
+  return Status::OK();
+}
+
+bool FlashSecondaryCache::AllocateRegion(uint32_t* region) {
+  mutex_.AssertHeld();
+  if (free_regions_.empty()) {
+    // A region still being written out cannot be reused yet
+    if (filled_regions_.empty() || regions_[filled_regions_.front()].buffer) {
+      return false;
+    }
+    const uint32_t victim = filled_regions_.front();
+    filled_regions_.pop_front();
+    EvictRegion(victim);
+    ++num_evicted_regions_;
+    free_regions_.push_back(victim);
+  }
+  *region = free_regions_.back();
+  free_regions_.pop_back();
+  return true;
+}
+
+void FlashSecondaryCache::EvictRegion(uint32_t region) {
+  mutex_.AssertHeld();
+  for (uint64_t hash : regions_[region].hashes) {
+    auto it = index_.find(hash);
+    // The key might have been inserted again elsewhere
+    if (it != index_.end() && LocationRegion(it->second) == region) {
+      index_.erase(it);
+    }
+  }
+  regions_[region].hashes.clear();
+}
+
+void FlashSecondaryCache::FlushRegion(uint32_t region,
+                                      std::shared_ptr<std::string> buffer) {
+  IOStatus s = write_file_->Write(uint64_t{region} * region_size_,
+                                  Slice(*buffer), IOOptions(), nullptr);
+  MutexLock l(&mutex_);
+  if (!s.ok()) {
+    // The entries cannot be served from flash, so forget them
+    EvictRegion(region);
+    filled_regions_.erase(
+        std::find(filled_regions_.begin(), filled_regions_.end(), region));
+    free_regions_.push_back(region);
+  }
+  regions_[region].buffer.reset();
+}
+
+std::unique_ptr<SecondaryCacheResultHandle> FlashSecondaryCache::Lookup(
+    const Slice& key, const Cache::CacheItemHelper* helper,
+    Cache::CreateContext* create_context, bool wait, bool advise_erase,
+    Statistics* /*stats*/, bool& kept_in_sec_cache) {
+  kept_in_sec_cache = false;
+  const uint64_t hash = GetSliceNPHash64(key);
+  uint64_t loc = 0;
+  // Entries not yet written out are copied from their region's buffer
+  std::string record;
+  bool in_buffer = false;
+  {
+    MutexLock l(&mutex_);
+    auto it = index_.find(hash);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    loc = it->second;
+    const Region& region = regions_[LocationRegion(loc)];
+    if (region.buffer) {
+      record.assign(region.buffer->data() + LocationOffset(loc),
+                    LocationSize(loc));
+      in_buffer = true;
+    }
+    if (advise_erase) {
+      index_.erase(it);
+    } else {
+      kept_in_sec_cache = true;
+    }
+  }
+
+  std::unique_ptr<FlashSecondaryCacheResultHandle> handle(
+      new FlashSecondaryCacheResultHandle(fs_.get(), key, helper,
+                                          create_context));
+  if (in_buffer) {
+    handle->Complete(record);
+  } else {
+    FSReadRequest& req = handle->req_;
+    req.offset =
+        uint64_t{LocationRegion(loc)} * region_size_ + LocationOffset(loc);
+    req.len = LocationSize(loc);
+    handle->scratch_.reset(new char[req.len]);
+    req.scratch = handle->scratch_.get();
+    bool read_issued = false;
+    if (!wait && use_async_io_) {
+      IOStatus s = read_file_->ReadAsync(
+          req, IOOptions(), &FlashSecondaryCacheResultHandle::OnReadDone,
+          handle.get(), &handle->io_handle_, &handle->del_fn_, nullptr);
+      if (s.ok()) {
+        read_issued = true;
+      } else if (handle->io_handle_ != nullptr) {
+        handle->del_fn_(handle->io_handle_);
+        handle->io_handle_ = nullptr;
+      }
+    }
+    if (!read_issued) {
+      req.status = read_file_->Read(req.offset, req.len, IOOptions(),
+                                    &req.result, req.scratch, nullptr);
+      handle->read_done_ = true;
+    }
+    if (handle->read_done_) {
+      handle->CompleteRead();
+    }
+  }
+
+  if (handle->IsReady() && handle->Value() == nullptr) {
+    // The entry was overwritten or could not be read
+    kept_in_sec_cache = false;
+    return nullptr;
+  }
+  return handle;
+}
+
+void FlashSecondaryCache::Erase(const Slice& key) {
+  MutexLock l(&mutex_);
+  index_.erase(GetSliceNPHash64(key));
+}
+
+void FlashSecondaryCache::WaitAll(
+    std::vector<SecondaryCacheResultHandle*> handles) {
+  std::vector<void*> io_handles;
+  std::vector<FlashSecondaryCacheResultHandle*> pending;
+  for (SecondaryCacheResultHandle* h : handles) {
+    auto* handle = static_cast<FlashSecondaryCacheResultHandle*>(h);
+    if (handle->IsReady()) {
+      continue;
+    }
+    if (!handle->read_done_) {
+      io_handles.push_back(handle->io_handle_);
+    }
+    pending.push_back(handle);
+  }
+  if (!io_handles.empty()) {
+    fs_->Poll(io_handles, io_handles.size()).PermitUncheckedError();
+  }
+  for (FlashSecondaryCacheResultHandle* handle : pending) {
+    handle->Wait();
+  }
+}
+
+std::string FlashSecondaryCache::GetPrintableOptions() const {
+  std::string ret;
+  const int kBufferSize{200};
+  char buffer[kBufferSize];
+  snprintf(buffer, kBufferSize, "    path : %s\n", opts_.path.c_str());
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    capacity : %" ROCKSDB_PRIszt "\n",
+           num_regions_ * region_size_);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    region_size : %" ROCKSDB_PRIszt "\n",
+           region_size_);
+  ret.append(buffer);
+  ret.append("    size_classes :");
+  for (size_t size_class : size_classes_) {
+    snprintf(buffer, kBufferSize, " %" ROCKSDB_PRIszt, size_class);
+    ret.append(buffer);
+  }
+  ret.append("\n");
+  snprintf(buffer, kBufferSize, "    async_io : %d\n", use_async_io_);
+  ret.append(buffer);
+  return ret;
+}
+
+uint64_t FlashSecondaryCache::TEST_NumEvictedRegions() const {
+  MutexLock l(&mutex_);
+  return num_evicted_regions_;
+}
+
+Status NewFlashSecondaryCache(const FlashSecondaryCacheOptions& opts,
+                              std::shared_ptr<SecondaryCache>* result) {
+  return FlashSecondaryCache::Create(opts, result);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
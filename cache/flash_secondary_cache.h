@@ -0,0 +1,196 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/cache.h"
+#include "rocksdb/file_system.h"
+#include "rocksdb/secondary_cache.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class FlashSecondaryCache;
+
+// Result of a lookup in FlashSecondaryCache. If the entry had to be read
+// from the file asynchronously, the object is only created once the read is
+// waited for.
+class FlashSecondaryCacheResultHandle : public SecondaryCacheResultHandle {
+ public:
+  FlashSecondaryCacheResultHandle(FileSystem* fs, const Slice& key,
+                                  const Cache::CacheItemHelper* helper,
+                                  Cache::CreateContext* create_context);
+  ~FlashSecondaryCacheResultHandle() override;
+
+  FlashSecondaryCacheResultHandle(const FlashSecondaryCacheResultHandle&) =
+      delete;
+  FlashSecondaryCacheResultHandle& operator=(
+      const FlashSecondaryCacheResultHandle&) = delete;
+
+  bool IsReady() override { return ready_; }
+
+  void Wait() override;
+
+  Cache::ObjectPtr Value() override { return value_; }
+
+  size_t Size() override { return size_; }
+
+ private:
+  friend class FlashSecondaryCache;
+
+  static void OnReadDone(FSReadRequest& req, void* cb_arg);
+
+  // Creates the object from the record in `record`, or leaves the handle
+  // without a value if the record is not the one for key_, e.g. because its
+  // region was reused while it was being read.
+  void Complete(const Slice& record);
+  void CompleteRead();
+
+  FileSystem* const fs_;
+  const std::string key_;
+  const Cache::CacheItemHelper* const helper_;
+  Cache::CreateContext* const create_context_;
+
+  FSReadRequest req_;
+  std::unique_ptr<char[]> scratch_;
+  void* io_handle_ = nullptr;
+  IOHandleDeleter del_fn_;
+  bool read_done_ = false;
+
+  bool ready_ = false;
+  Cache::ObjectPtr value_ = nullptr;
+  size_t size_ = 0;
+};
+
+// See FlashSecondaryCacheOptions. All state except the file contents is
+// protected by a single mutex, which is not held while reading from or
+// writing to the file.
+//
+// Each entry is stored as a record:
+//   checksum: fixed32, masked crc32c of the rest of the record
+//   value size: fixed32
+//   compression type: 1 byte
+//   source cache tier: 1 byte
+//   key size: fixed16
+//   key, value
+// padded to the size of its slot.
+class FlashSecondaryCache : public SecondaryCache {
+ public:
+  static constexpr size_t kAlignment = 64;
+  static constexpr size_t kRecordHeaderSize = 12;
+  static constexpr size_t kMaxRegionSize = size_t{32} << 20;
+
+  static Status Create(const FlashSecondaryCacheOptions& opts,
+                       std::shared_ptr<SecondaryCache>* result);
+
+  ~FlashSecondaryCache() override;
+
+  const char* Name() const override { return "FlashSecondaryCache"; }
+
+  Status Insert(const Slice& key, Cache::ObjectPtr obj,
+                const Cache::CacheItemHelper* helper,
+                bool force_insert) override;
+
+  Status InsertSaved(const Slice& key, const Slice& saved,
+                     CompressionType type = kNoCompression,
+                     CacheTier source = CacheTier::kVolatileTier) override;
+
+  std::unique_ptr<SecondaryCacheResultHandle> Lookup(
+      const Slice& key, const Cache::CacheItemHelper* helper,
+      Cache::CreateContext* create_context, bool wait, bool advise_erase,
+      Statistics* stats, bool& kept_in_sec_cache) override;
+
+  bool SupportForceErase() const override { return true; }
+
+  void Erase(const Slice& key) override;
+
+  void WaitAll(std::vector<SecondaryCacheResultHandle*> handles) override;
+
+  Status GetCapacity(size_t& capacity) override {
+    capacity = num_regions_ * region_size_;
+    return Status::OK();
+  }
+
+  std::string GetPrintableOptions() const override;
+
+  // Number of regions reclaimed to make room for new entries
+  uint64_t TEST_NumEvictedRegions() const;
+
+ private:
+  // A location in the file, packed into 64 bits as
+  //   region (24 bits) | offset in region / kAlignment (20 bits) |
+  //   slot size / kAlignment (20 bits)
+  static uint64_t PackLocation(uint32_t region, size_t offset, size_t size) {
+    return (uint64_t{region} << 40) |
+           (static_cast<uint64_t>(offset / kAlignment) << 20) |
+           (size / kAlignment);
+  }
+  static uint32_t LocationRegion(uint64_t loc) {
+    return static_cast<uint32_t>(loc >> 40);
+  }
+  static size_t LocationOffset(uint64_t loc) {
+    return static_cast<size_t>((loc >> 20) & 0xfffff) * kAlignment;
+  }
+  static size_t LocationSize(uint64_t loc) {
+    return static_cast<size_t>(loc & 0xfffff) * kAlignment;
+  }
+
+  struct Region {
+    // Index into size_classes_, or size_classes_.size() for regions holding
+    // entries larger than the largest size class
+    size_t size_class = 0;
+    // Contents while the region is being filled or written to the file,
+    // null once they are on flash
+    std::shared_ptr<std::string> buffer;
+    // Hashes of the keys inserted into the region, to remove them from the
+    // index when the region is reclaimed
+    std::vector<uint64_t> hashes;
+  };
+
+  FlashSecondaryCache(const FlashSecondaryCacheOptions& opts,
+                      std::shared_ptr<FileSystem> fs, size_t num_regions,
+                      std::vector<size_t> size_classes);
+
+  Status Open();
+
+  // Returns a free region, reclaiming the oldest one if needed, or false if
+  // there is none that can be reclaimed right now. REQUIRES: mutex_ held
+  bool AllocateRegion(uint32_t* region);
+  // REQUIRES: mutex_ held
+  void EvictRegion(uint32_t region);
+  // Writes out the buffer of a region that was just filled. REQUIRES: mutex_
+  // not held
+  void FlushRegion(uint32_t region, std::shared_ptr<std::string> buffer);
+
+  const FlashSecondaryCacheOptions opts_;
+  const std::shared_ptr<FileSystem> fs_;
+  const size_t region_size_;
+  const size_t num_regions_;
+  const std::vector<size_t> size_classes_;
+  bool use_async_io_ = false;
+  std::unique_ptr<FSRandomRWFile> write_file_;
+  std::unique_ptr<FSRandomAccessFile> read_file_;
+
+  mutable port::Mutex mutex_;
+  std::vector<Region> regions_;
+  std::vector<uint32_t> free_regions_;
+  // Regions that were filled, oldest first
+  std::deque<uint32_t> filled_regions_;
+  // Region being filled for each size class, if any
+  std::vector<uint32_t> active_regions_;
+  static constexpr uint32_t kNoRegion = UINT32_MAX;
+  // Key hash -> packed location
+  std::unordered_map<uint64_t, uint64_t> index_;
+  uint64_t num_evicted_regions_ = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
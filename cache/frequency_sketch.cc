@@ -0,0 +1,81 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/frequency_sketch.h"
+
+#include <algorithm>
+
+#include "monitoring/statistics_impl.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Keep the sketch within 4 * 2^22 bytes per cache shard
+constexpr int kMinWidthBits = 6;
+constexpr int kMaxWidthBits = 22;
+
+// One odd multiplier per row, so each row uses different bits of the hash
+constexpr uint64_t kRowMultipliers[] = {
+    0x9E3779B97F4A7C15U, 0xC2B2AE3D27D4EB4FU, 0x165667B19E3779F9U,
+    0xD6E8FEB86659FD93U};
+}  // namespace
+
+FrequencySketch::FrequencySketch(size_t expected_entries) {
+  int bits = kMinWidthBits;
+  while (bits < kMaxWidthBits && (size_t{1} << bits) < expected_entries) {
+    ++bits;
+  }
+  width_bits_ = bits;
+  sample_size_ = uint64_t{10} << width_bits_;
+  counters_.reset(new RelaxedAtomic<uint8_t>[size_t{kDepth} << width_bits_]);
+}
+
+size_t FrequencySketch::Index(uint64_t hash, int row) const {
+  const uint64_t mixed = (hash + static_cast<uint64_t>(row)) *
+                         kRowMultipliers[row];
+  return (static_cast<size_t>(row) << width_bits_) +
+         static_cast<size_t>(mixed >> (64 - width_bits_));
+}
+
+void FrequencySketch::Increment(uint64_t hash) {
+  for (int row = 0; row < kDepth; ++row) {
+    RelaxedAtomic<uint8_t>& counter = counters_[Index(hash, row)];
+    const uint8_t count = counter.LoadRelaxed();
+    if (count < kMaxFrequency) {
+      counter.StoreRelaxed(static_cast<uint8_t>(count + 1));
+    }
+  }
+  // Exactly one thread sees each multiple of the sample size
+  if ((num_increments_.FetchAddRelaxed(1) + 1) % sample_size_ == 0) {
+    Age();
+  }
+}
+
+uint32_t FrequencySketch::Estimate(uint64_t hash) const {
+  uint32_t estimate = kMaxFrequency;
+  for (int row = 0; row < kDepth; ++row) {
+    estimate = std::min(
+        estimate, uint32_t{counters_[Index(hash, row)].LoadRelaxed()});
+  }
+  return estimate;
+}
+
+bool FrequencySketch::Admit(uint64_t candidate, uint32_t victim_frequency,
+                            Statistics* stats) const {
+  const bool admit = Estimate(candidate) > victim_frequency;
+  RecordTick(stats,
+             admit ? CACHE_ADMISSION_ADMITTED : CACHE_ADMISSION_REJECTED);
+  return admit;
+}
+
+void FrequencySketch::Age() {
+  const size_t num_counters = size_t{kDepth} << width_bits_;
+  for (size_t i = 0; i < num_counters; ++i) {
+    counters_[i].StoreRelaxed(
+        static_cast<uint8_t>(counters_[i].LoadRelaxed() >> 1));
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,66 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "rocksdb/rocksdb_namespace.h"
+#include "util/atomic.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class Statistics;
+
+// Approximate recent access frequencies of cache keys, for TinyLFU admission
+// (see ShardedCacheOptions::frequency_admission). A count-min sketch with
+// kDepth rows of 4-bit saturating counters (stored in bytes): a key is counted
+// in one counter per row, and its estimate is the minimum of them. To keep
+// the estimates about recent accesses, all counters are halved every
+// 10 * width recorded accesses.
+//
+// Thread-safe without locking. Counters are updated with relaxed loads and
+// stores, so concurrent updates can be lost, which only makes the estimates
+// slightly less accurate.
+class FrequencySketch {
+ public:
+  static constexpr uint32_t kMaxFrequency = 15;
+
+  // Sized for about `expected_entries` distinct keys in the cache.
+  explicit FrequencySketch(size_t expected_entries);
+
+  // Records an access to the key with hash `hash`. The hash bits should be
+  // well distributed.
+  void Increment(uint64_t hash);
+
+  // Estimated number of recent accesses to the key with hash `hash`, at most
+  // kMaxFrequency.
+  uint32_t Estimate(uint64_t hash) const;
+
+  // Whether a new entry with hash `candidate` should replace an entry with
+  // an estimated frequency of `victim_frequency`, recording the decision in
+  // `stats`.
+  bool Admit(uint64_t candidate, uint32_t victim_frequency,
+             Statistics* stats) const;
+
+  size_t ApproximateMemoryUsage() const {
+    return sizeof(FrequencySketch) + (kDepth << width_bits_);
+  }
+
+ private:
+  static constexpr int kDepth = 4;
+
+  size_t Index(uint64_t hash, int row) const;
+  void Age();
+
+  int width_bits_;
+  uint64_t sample_size_;
+  // counters_[(row << width_bits_) + column]
+  std::unique_ptr<RelaxedAtomic<uint8_t>[]> counters_;
+  RelaxedAtomic<uint64_t> num_increments_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
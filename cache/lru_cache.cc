@@ -119,7 +119,9 @@ LRUCacheShard::LRUCacheShard(size_t capacity, bool strict_capacity_limit,
                              CacheMetadataChargePolicy metadata_charge_policy,
                              int max_upper_hash_bits,
                              MemoryAllocator* allocator,
-                             const Cache::EvictionCallback* eviction_callback)
+                             const Cache::EvictionCallback* eviction_callback,
+                             bool frequency_admission,
+                             Statistics* admission_statistics)
     : CacheShardBase(metadata_charge_policy),
       capacity_(0),
       high_pri_pool_usage_(0),
@@ -133,7 +135,12 @@ LRUCacheShard::LRUCacheShard(size_t capacity, bool strict_capacity_limit,
       usage_(0),
       lru_usage_(0),
       mutex_(use_adaptive_mutex),
-      eviction_callback_(*eviction_callback) {
+      eviction_callback_(*eviction_callback),
+      admission_statistics_(admission_statistics) {
+  if (frequency_admission) {
+    // Sized for entries of a typical data block size
+    admission_sketch_.reset(new FrequencySketch(capacity / 4096));
+  }
   // Make empty circular linked list.
   lru_.next = &lru_;
   lru_.prev = &lru_;
@@ -155,6 +162,7 @@ void LRUCacheShard::EraseUnRefEntries() {
       old->SetInCache(false);
       assert(usage_ >= old->total_charge);
       usage_ -= old->total_charge;
+      tenant_usage_.Uncharge(old->tenant, old->total_charge);
       last_reference_list.push_back(old);
     }
   }
@@ -323,7 +331,7 @@ void LRUCacheShard::MaintainPoolSize() {
 void LRUCacheShard::EvictFromLRU(size_t charge,
                                  autovector<LRUHandle*>* deleted) {
   while ((usage_ + charge) > capacity_ && lru_.next != &lru_) {
-    LRUHandle* old = lru_.next;
+    LRUHandle* old = NextVictim();
     // LRU list contains only elements which can be evicted.
     assert(old->InCache() && !old->HasRefs());
     LRU_Remove(old);
@@ -331,10 +339,41 @@ void LRUCacheShard::EvictFromLRU(size_t charge,
     old->SetInCache(false);
     assert(usage_ >= old->total_charge);
     usage_ -= old->total_charge;
+    tenant_usage_.Uncharge(old->tenant, old->total_charge);
     deleted->push_back(old);
   }
 }
 
+LRUHandle* LRUCacheShard::NextVictim() {
+  LRUHandle* oldest = lru_.next;
+  assert(oldest != &lru_);
+  if (!tenant_usage_.IsActive()) {
+    return oldest;
+  }
+  // Bounds the extra work per eviction
+  constexpr int kMaxScan = 32;
+  int scanned = 0;
+  for (LRUHandle* e = oldest; e != &lru_ && scanned < kMaxScan;
+       e = e->next, ++scanned) {
+    if (tenant_usage_.IsOverLimit(e->tenant)) {
+      return e;
+    }
+  }
+  // Give the entries of tenants under their reservation another round in
+  // the LRU list, unless there is nothing else to evict
+  size_t max_rotations = table_.GetOccupancyCount();
+  while (tenant_usage_.IsProtected(oldest->tenant) && max_rotations-- > 0) {
+    LRU_Remove(oldest);
+    LRU_Insert(oldest);
+    if (lru_.next == oldest) {
+      // Back at the tail of the LRU list
+      break;
+    }
+    oldest = lru_.next;
+  }
+  return oldest;
+}
+
 void LRUCacheShard::NotifyEvicted(
     const autovector<LRUHandle*>& evicted_handles) {
   MemoryAllocator* alloc = table_.GetAllocator();
@@ -376,48 +415,68 @@ Status LRUCacheShard::InsertItem(LRUHandle* e, LRUHandle** handle) {
   {
     DMutexLock l(mutex_);
 
-    // Free the space following strict LRU policy until enough space
-    // is freed or the lru list is empty.
-    EvictFromLRU(e->total_charge, &last_reference_list);
-
-    if ((usage_ + e->total_charge) > capacity_ &&
-        (strict_capacity_limit_ || handle == nullptr)) {
+    if (!Admit(*e)) {
+      // As if inserted and evicted immediately. A requested handle refers to
+      // an entry outside of the cache, freed on release.
       e->SetInCache(false);
       if (handle == nullptr) {
-        // Don't insert the entry but still return ok, as if the entry inserted
-        // into cache and get evicted immediately.
         last_reference_list.push_back(e);
       } else {
-        free(e);
-        e = nullptr;
-        *handle = nullptr;
-        s = Status::MemoryLimit("Insert failed due to LRU cache being full.");
+        if (!e->HasRefs()) {
+          e->Ref();
+        }
+        usage_ += e->total_charge;
+        tenant_usage_.Charge(e->tenant, e->total_charge);
+        *handle = e;
       }
     } else {
-      // Insert into the cache. Note that the cache might get larger than its
-      // capacity if not enough space was freed up.
-      LRUHandle* old = table_.Insert(e);
-      usage_ += e->total_charge;
-      if (old != nullptr) {
-        s = Status::OkOverwritten();
-        assert(old->InCache());
-        old->SetInCache(false);
-        if (!old->HasRefs()) {
-          // old is on LRU because it's in cache and its reference count is 0.
-          LRU_Remove(old);
-          assert(usage_ >= old->total_charge);
-          usage_ -= old->total_charge;
-          last_reference_list.push_back(old);
+      // Free the space following strict LRU policy until enough space
+      // is freed or the lru list is empty.
+      EvictFromLRU(e->total_charge, &last_reference_list);
+
+      if ((usage_ + e->total_charge) > capacity_ &&
+          (strict_capacity_limit_ || handle == nullptr)) {
+        e->SetInCache(false);
+        if (handle == nullptr) {
+          // Don't insert the entry but still return ok, as if the entry
+          // inserted into cache and get evicted immediately.
+          last_reference_list.push_back(e);
+        } else {
+          free(e);
+          e = nullptr;
+          *handle = nullptr;
+          s = Status::MemoryLimit(
+              "Insert failed due to LRU cache being full.");
         }
-      }
-      if (handle == nullptr) {
-        LRU_Insert(e);
       } else {
-        // If caller already holds a ref, no need to take one here.
-        if (!e->HasRefs()) {
-          e->Ref();
+        // Insert into the cache. Note that the cache might get larger than
+        // its capacity if not enough space was freed up.
+        LRUHandle* old = table_.Insert(e);
+        usage_ += e->total_charge;
+        tenant_usage_.Charge(e->tenant, e->total_charge);
+        if (old != nullptr) {
+          s = Status::OkOverwritten();
+          assert(old->InCache());
+          old->SetInCache(false);
+          if (!old->HasRefs()) {
+            // old is on LRU because it's in cache and its reference count is
+            // 0.
+            LRU_Remove(old);
+            assert(usage_ >= old->total_charge);
+            usage_ -= old->total_charge;
+            tenant_usage_.Uncharge(old->tenant, old->total_charge);
+            last_reference_list.push_back(old);
+          }
+        }
+        if (handle == nullptr) {
+          LRU_Insert(e);
+        } else {
+          // If caller already holds a ref, no need to take one here.
+          if (!e->HasRefs()) {
+            e->Ref();
+          }
+          *handle = e;
         }
-        *handle = e;
       }
     }
   }
@@ -427,12 +486,26 @@ Status LRUCacheShard::InsertItem(LRUHandle* e, LRUHandle** handle) {
   return s;
 }
 
+bool LRUCacheShard::Admit(const LRUHandle& e) {
+  if (admission_sketch_ == nullptr || strict_capacity_limit_ || e.IsHighPri() ||
+      usage_ + e.total_charge <= capacity_ || lru_.next == &lru_) {
+    // No admission policy, or nothing to evict for the entry
+    return true;
+  }
+  return admission_sketch_->Admit(e.hash,
+                                  admission_sketch_->Estimate(lru_.next->hash),
+                                  admission_statistics_);
+}
+
 LRUHandle* LRUCacheShard::Lookup(const Slice& key, uint32_t hash,
                                  const Cache::CacheItemHelper* /*helper*/,
                                  Cache::CreateContext* /*create_context*/,
                                  Cache::Priority /*priority*/,
                                  Statistics* /*stats*/) {
   DMutexLock l(mutex_);
+  if (admission_sketch_ != nullptr) {
+    admission_sketch_->Increment(hash);
+  }
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     assert(e->InCache());
@@ -498,6 +571,7 @@ bool LRUCacheShard::Release(LRUHandle* e, bool /*useful*/,
     if (must_free) {
       assert(usage_ >= e->total_charge);
       usage_ -= e->total_charge;
+      tenant_usage_.Uncharge(e->tenant, e->total_charge);
     }
   }
 
@@ -534,6 +608,7 @@ LRUHandle* LRUCacheShard::CreateHandle(const Slice& key, uint32_t hash,
   e->value = value;
   e->m_flags = 0;
   e->im_flags = 0;
+  e->tenant = GetCurrentCacheTenant();
   e->helper = helper;
   e->key_length = key.size();
   e->hash = hash;
@@ -581,6 +656,7 @@ LRUHandle* LRUCacheShard::CreateStandalone(const Slice& key, uint32_t hash,
       }
     } else {
       usage_ += e->total_charge;
+      tenant_usage_.Charge(e->tenant, e->total_charge);
     }
   }
 
@@ -602,6 +678,7 @@ void LRUCacheShard::Erase(const Slice& key, uint32_t hash) {
         LRU_Remove(e);
         assert(usage_ >= e->total_charge);
         usage_ -= e->total_charge;
+        tenant_usage_.Uncharge(e->tenant, e->total_charge);
         last_reference = true;
       }
     }
@@ -656,7 +733,9 @@ LRUCache::LRUCache(const LRUCacheOptions& opts) : ShardedCache(opts) {
                            opts.high_pri_pool_ratio, opts.low_pri_pool_ratio,
                            opts.use_adaptive_mutex, opts.metadata_charge_policy,
                            /* max_upper_hash_bits */ 32 - opts.num_shard_bits,
-                           alloc, &eviction_callback_);
+                           alloc, &eviction_callback_,
+                           opts.frequency_admission,
+                           opts.admission_statistics.get());
   });
 }
 
@@ -11,6 +11,8 @@
 #include <memory>
 #include <string>
 
+#include "cache/cache_tenant.h"
+#include "cache/frequency_sketch.h"
 #include "cache/sharded_cache.h"
 #include "port/lang.h"
 #include "port/likely.h"
@@ -87,6 +89,9 @@ struct LRUHandle : public Cache::Handle {
     IM_IS_STANDALONE = (1 << 2),
   };
 
+  // Tenant owning the entry (see CacheTenantUsage), also immutable
+  uint8_t tenant;
+
   // Beginning of the key (MUST BE THE LAST FIELD IN THIS STRUCT!)
   char key_data[1];
 
@@ -271,7 +276,8 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
                 bool use_adaptive_mutex,
                 CacheMetadataChargePolicy metadata_charge_policy,
                 int max_upper_hash_bits, MemoryAllocator* allocator,
-                const Cache::EvictionCallback* eviction_callback);
+                const Cache::EvictionCallback* eviction_callback,
+                bool frequency_admission, Statistics* admission_statistics);
 
  public:  // Type definitions expected as parameter to ShardedCache
   using HandleImpl = LRUHandle;
@@ -325,6 +331,8 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
   size_t GetOccupancyCount() const;
   size_t GetTableAddressCount() const;
 
+  CacheTenantUsage* GetTenantUsage() { return &tenant_usage_; }
+
   void ApplyToSomeEntries(
       const std::function<void(const Slice& key, Cache::ObjectPtr value,
                                size_t charge,
@@ -369,8 +377,19 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
   // holding the mutex_.
   void EvictFromLRU(size_t charge, autovector<LRUHandle*>* deleted);
 
+  // The next entry of the LRU list to evict. Without tenants, the oldest.
+  // Otherwise, the first entry of a tenant over its ceiling among the oldest
+  // few entries, or else the oldest entry once the entries of tenants under
+  // their reservation have been moved out of the way.
+  // REQUIRES: mutex_ held, LRU list not empty
+  LRUHandle* NextVictim();
+
   void NotifyEvicted(const autovector<LRUHandle*>& evicted_handles);
 
+  // Whether `e` should be inserted, according to admission_sketch_.
+  // REQUIRES: mutex_ held
+  bool Admit(const LRUHandle& e);
+
   LRUHandle* CreateHandle(const Slice& key, uint32_t hash,
                           Cache::ObjectPtr value,
                           const Cache::CacheItemHelper* helper, size_t charge);
@@ -431,6 +450,9 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
   // Memory size for entries residing only in the LRU list.
   size_t lru_usage_;
 
+  // Part of usage_ by each tenant
+  CacheTenantUsage tenant_usage_;
+
   // mutex_ protects the following state.
   // We don't count mutex_ as the cache's internal state so semantically we
   // don't mind mutex_ invoking the non-const actions.
@@ -438,6 +460,10 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
 
   // A reference to Cache::eviction_callback_
   const Cache::EvictionCallback& eviction_callback_;
+
+  // Recent lookups, for frequency-based admission. nullptr if disabled.
+  std::unique_ptr<FrequencySketch> admission_sketch_;
+  Statistics* const admission_statistics_;
 };
 
 class LRUCache
@@ -53,7 +53,9 @@ class LRUCacheTest : public testing::Test {
                                high_pri_pool_ratio, low_pri_pool_ratio,
                                use_adaptive_mutex, kDontChargeCacheMetadata,
                                /*max_upper_hash_bits=*/24,
-                               /*allocator*/ nullptr, &eviction_callback_);
+                               /*allocator*/ nullptr, &eviction_callback_,
+                               /*frequency_admission=*/false,
+                               /*admission_statistics=*/nullptr);
   }
 
   void Insert(const std::string& key,
@@ -79,14 +79,17 @@ const char* kTieredCacheName = "TieredCache";
 CacheWithSecondaryAdapter::CacheWithSecondaryAdapter(
     std::shared_ptr<Cache> target,
     std::shared_ptr<SecondaryCache> secondary_cache,
-    TieredAdmissionPolicy adm_policy, bool distribute_cache_res)
+    TieredAdmissionPolicy adm_policy, bool distribute_cache_res,
+    std::unique_ptr<TieredCacheTuner> tuner)
     : CacheWrapper(std::move(target)),
       secondary_cache_(std::move(secondary_cache)),
       adm_policy_(adm_policy),
       distribute_cache_res_(distribute_cache_res),
       placeholder_usage_(0),
       reserved_usage_(0),
-      sec_reserved_(0) {
+      sec_reserved_(0),
+      tuner_(std::move(tuner)) {
+  assert(!tuner_ || distribute_cache_res_);
   target_->SetEvictionCallback(
       [this](const Slice& key, Handle* handle, bool was_hit) {
         return EvictionHandler(key, handle, was_hit);
@@ -139,9 +142,15 @@ CacheWithSecondaryAdapter::~CacheWithSecondaryAdapter() {
 bool CacheWithSecondaryAdapter::EvictionHandler(const Slice& key,
                                                 Handle* handle, bool was_hit) {
   auto helper = GetCacheItemHelper(handle);
+  auto obj = target_->Value(handle);
+  if (tuner_ && obj != kDummyObj && obj != nullptr) {
+    tuner_->OnPrimaryEviction(
+        key, target_->GetCharge(handle),
+        /*demoted=*/helper->IsSecondaryCacheCompatible() &&
+            adm_policy_ != TieredAdmissionPolicy::kAdmPolicyThreeQueue);
+  }
   if (helper->IsSecondaryCacheCompatible() &&
       adm_policy_ != TieredAdmissionPolicy::kAdmPolicyThreeQueue) {
-    auto obj = target_->Value(handle);
     // Ignore dummy entry
     if (obj != kDummyObj) {
       bool force = false;
@@ -278,6 +287,10 @@ Status CacheWithSecondaryAdapter::Insert(const Slice& key, ObjectPtr value,
       sec_reserved_ += sec_charge;
     }
   }
+  if (tuner_ && s.ok() && value != nullptr &&
+      helper->IsSecondaryCacheCompatible()) {
+    tuner_->OnInsert(key, charge, compressed_value.size());
+  }
   // Warm up the secondary cache with the compressed block. The secondary
   // cache may choose to ignore it based on the admission policy.
   if (value != nullptr && !compressed_value.empty() &&
@@ -302,6 +315,7 @@ Cache::Handle* CacheWithSecondaryAdapter::Lookup(const Slice& key,
   bool secondary_compatible = helper && helper->IsSecondaryCacheCompatible();
   bool found_dummy_entry =
       ProcessDummyResult(&result, /*erase=*/secondary_compatible);
+  const bool primary_hit = result != nullptr;
   if (!result && secondary_compatible) {
     // Try our secondary cache
     bool kept_in_sec_cache = false;
@@ -314,6 +328,14 @@ Cache::Handle* CacheWithSecondaryAdapter::Lookup(const Slice& key,
                        stats, found_dummy_entry, kept_in_sec_cache);
     }
   }
+  if (tuner_ && secondary_compatible) {
+    double new_ratio = 0.0;
+    if (tuner_->OnLookup(key, primary_hit,
+                         /*secondary_hit=*/!primary_hit && result != nullptr,
+                         &new_ratio)) {
+      UpdateCacheReservationRatio(new_ratio).PermitUncheckedError();
+    }
+  }
   return result;
 }
 
@@ -542,6 +564,9 @@ void CacheWithSecondaryAdapter::SetCapacity(size_t capacity) {
     // No cache reservation distribution. Just set the primary cache capacity.
     target_->SetCapacity(capacity);
   }
+  if (tuner_) {
+    tuner_->SetCapacity(capacity);
+  }
 }
 
 Status CacheWithSecondaryAdapter::GetSecondaryCacheCapacity(
@@ -642,6 +667,9 @@ Status CacheWithSecondaryAdapter::UpdateCacheReservationRatio(
       sec_reserved_ = new_sec_reserved;
     }
   }
+  if (tuner_) {
+    tuner_->SetRatio(compressed_secondary_ratio);
+  }
 
   return s;
 }
@@ -691,6 +719,14 @@ std::shared_ptr<Cache> NewTieredCache(const TieredCacheOptions& _opts) {
       return nullptr;
     }
   }
+  if (opts.adaptive_compressed_secondary_ratio &&
+      (opts.nvm_sec_cache || opts.min_compressed_secondary_ratio <= 0.0 ||
+       opts.max_compressed_secondary_ratio > 1.0 ||
+       opts.min_compressed_secondary_ratio >
+           opts.max_compressed_secondary_ratio ||
+       opts.adaptive_ratio_step <= 0.0)) {
+    return nullptr;
+  }
 
   std::shared_ptr<Cache> cache;
   if (opts.cache_type == PrimaryCacheType::kCacheTypeLRU) {
@@ -725,8 +761,13 @@ std::shared_ptr<Cache> NewTieredCache(const TieredCacheOptions& _opts) {
     }
   }
 
+  std::unique_ptr<TieredCacheTuner> tuner;
+  if (opts.adaptive_compressed_secondary_ratio) {
+    tuner = std::make_unique<TieredCacheTuner>(opts);
+  }
   return std::make_shared<CacheWithSecondaryAdapter>(
-      cache, sec_cache, opts.adm_policy, /*distribute_cache_res=*/true);
+      cache, sec_cache, opts.adm_policy, /*distribute_cache_res=*/true,
+      std::move(tuner));
 }
 
 Status UpdateTieredCache(const std::shared_ptr<Cache>& cache,
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "cache/cache_reservation_manager.h"
+#include "cache/tiered_cache_tuner.h"
 #include "rocksdb/secondary_cache.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -16,7 +17,8 @@ class CacheWithSecondaryAdapter : public CacheWrapper {
       std::shared_ptr<Cache> target,
       std::shared_ptr<SecondaryCache> secondary_cache,
       TieredAdmissionPolicy adm_policy = TieredAdmissionPolicy::kAdmPolicyAuto,
-      bool distribute_cache_res = false);
+      bool distribute_cache_res = false,
+      std::unique_ptr<TieredCacheTuner> tuner = nullptr);
 
   ~CacheWithSecondaryAdapter() override;
 
@@ -98,6 +100,8 @@ class CacheWithSecondaryAdapter : public CacheWrapper {
   // Amount of memory reserved in the secondary cache. This should be
   // reserved_usage_ * sec_cache_res_ratio_ in steady state.
   size_t sec_reserved_;
+  // Adjusts sec_cache_res_ratio_ automatically, if set
+  std::unique_ptr<TieredCacheTuner> tuner_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
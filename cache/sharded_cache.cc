@@ -62,6 +62,8 @@ ShardedCacheBase::ShardedCacheBase(const ShardedCacheOptions& opts)
       last_id_(1),
       shard_mask_((uint32_t{1} << opts.num_shard_bits) - 1),
       hash_seed_(DetermineSeed(opts.hash_seed)),
+      frequency_admission_(opts.frequency_admission),
+      admission_statistics_(opts.admission_statistics),
       strict_capacity_limit_(opts.strict_capacity_limit),
       capacity_(opts.capacity) {}
 
@@ -74,6 +76,28 @@ size_t ShardedCacheBase::GetPerShardCapacity() const {
   return ComputePerShardCapacity(GetCapacity());
 }
 
+Status ShardedCacheBase::ValidateNewTenant(
+    const CacheTenantOptions& opts) const {
+  config_mutex_.AssertHeld();
+  if (tenants_.size() + 1 >= kMaxCacheTenants) {
+    return Status::NotSupported("Too many cache tenants");
+  }
+  if (!(opts.reserved_ratio >= 0.0 && opts.reserved_ratio <= opts.max_ratio &&
+        opts.max_ratio <= 1.0)) {
+    return Status::InvalidArgument(
+        "Invalid reserved_ratio or max_ratio for cache tenant");
+  }
+  double total_reserved = opts.reserved_ratio;
+  for (const auto& tenant : tenants_) {
+    total_reserved += tenant.reserved_ratio;
+  }
+  if (total_reserved > 1.0) {
+    return Status::InvalidArgument(
+        "Cache tenant reservations exceed the capacity");
+  }
+  return Status::OK();
+}
+
 uint64_t ShardedCacheBase::NewId() {
   return last_id_.fetch_add(1, std::memory_order_relaxed);
 }
@@ -119,6 +143,9 @@ std::string ShardedCacheBase::GetPrintableOptions() const {
              strict_capacity_limit_);
     ret.append(buffer);
   }
+  snprintf(buffer, kBufferSize, "    frequency_admission : %d\n",
+           frequency_admission_);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "    memory_allocator : %s\n",
            memory_allocator() ? memory_allocator()->Name() : "None");
   ret.append(buffer);
@@ -12,7 +12,9 @@
 #include <atomic>
 #include <cstdint>
 #include <string>
+#include <vector>
 
+#include "cache/cache_tenant.h"
 #include "port/lang.h"
 #include "port/port.h"
 #include "rocksdb/advanced_cache.h"
@@ -70,6 +72,8 @@ class CacheShardBase {
   size_t GetPinnedUsage() const = 0;
   size_t GetOccupancyCount() const = 0;
   size_t GetTableAddressCount() const = 0;
+  // nullptr if tenants are not supported
+  CacheTenantUsage* GetTenantUsage() = 0;
   // Handles iterating over roughly `average_entries_per_lock` entries, using
   // `state` to somehow record where it last ended up. Caller initially uses
   // *state == 0 and implementation sets *state = SIZE_MAX to indicate
@@ -112,15 +116,23 @@ class ShardedCacheBase : public Cache {
   virtual void AppendPrintableOptions(std::string& str) const = 0;
   size_t GetPerShardCapacity() const;
   size_t ComputePerShardCapacity(size_t capacity) const;
+  // Checks that `opts` can be added to tenants_
+  // REQUIRES: config_mutex_ held
+  Status ValidateNewTenant(const CacheTenantOptions& opts) const;
 
  protected:                        // data
   std::atomic<uint64_t> last_id_;  // For NewId
   const uint32_t shard_mask_;
   const uint32_t hash_seed_;
+  // See ShardedCacheOptions::frequency_admission
+  const bool frequency_admission_;
+  const std::shared_ptr<Statistics> admission_statistics_;
 
   // Dynamic configuration parameters, guarded by config_mutex_
   bool strict_capacity_limit_;
   size_t capacity_;
+  // Options of tenant i + 1
+  std::vector<CacheTenantOptions> tenants_;
   mutable port::Mutex config_mutex_;
 };
 
@@ -162,6 +174,7 @@ class ShardedCache : public ShardedCacheBase {
     MutexLock l(&config_mutex_);
     capacity_ = capacity;
     auto per_shard = ComputePerShardCapacity(capacity);
+    SetTenantLimits(per_shard);
     ForEachShard([=](CacheShard* cs) { cs->SetCapacity(per_shard); });
   }
 
@@ -263,6 +276,29 @@ class ShardedCache : public ShardedCacheBase {
     ForEachShard([](CacheShard* cs) { cs->EraseUnRefEntries(); });
   }
 
+  Status AddTenant(const CacheTenantOptions& opts, uint8_t* id) override {
+    if (shards_[0].GetTenantUsage() == nullptr) {
+      return Status::NotSupported("Cache tenants not supported by " +
+                                  std::string(Name()));
+    }
+    MutexLock l(&config_mutex_);
+    Status s = ValidateNewTenant(opts);
+    if (!s.ok()) {
+      return s;
+    }
+    tenants_.push_back(opts);
+    *id = static_cast<uint8_t>(tenants_.size());
+    SetTenantLimits(ComputePerShardCapacity(capacity_));
+    return Status::OK();
+  }
+
+  size_t GetTenantUsage(uint8_t id) const override {
+    return SumOverShards([id](CacheShard& cs) {
+      CacheTenantUsage* usage = cs.GetTenantUsage();
+      return usage != nullptr ? usage->GetUsage(id) : size_t{0};
+    });
+  }
+
   void DisownData() override {
     // Leak data only if that won't generate an ASAN/valgrind warning.
     if (!kMustFreeHeapAllocations) {
@@ -310,6 +346,23 @@ class ShardedCache : public ShardedCacheBase {
     shards_[0].AppendPrintableOptions(str);
   }
 
+  // REQUIRES: config_mutex_ held
+  void SetTenantLimits(size_t per_shard_capacity) {
+    for (size_t i = 0; i < tenants_.size(); ++i) {
+      const CacheTenantOptions& opts = tenants_[i];
+      const size_t reserved =
+          static_cast<size_t>(per_shard_capacity * opts.reserved_ratio);
+      const size_t max =
+          opts.max_ratio >= 1.0
+              ? SIZE_MAX
+              : static_cast<size_t>(per_shard_capacity * opts.max_ratio);
+      const auto id = static_cast<uint8_t>(i + 1);
+      ForEachShard([&](CacheShard* cs) {
+        cs->GetTenantUsage()->SetLimits(id, reserved, max);
+      });
+    }
+  }
+
  private:
   CacheShard* const shards_;
   bool destroy_shards_in_dtor_;
@@ -0,0 +1,179 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/tiered_cache_tuner.h"
+
+#include <algorithm>
+
+#include "rocksdb/advanced_cache.h"
+#include "util/hash.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Marginal hits needed in an interval before moving any memory
+constexpr uint64_t kMinMarginalHits = 8;
+
+std::shared_ptr<Cache> NewSimCache() {
+  LRUCacheOptions opts;
+  opts.capacity = 0;
+  opts.high_pri_pool_ratio = 0.0;
+  opts.metadata_charge_policy = kDontChargeCacheMetadata;
+  return opts.MakeSharedCache();
+}
+
+void SimInsert(Cache* sim_cache, const Slice& key, size_t charge) {
+  sim_cache
+      ->Insert(key, /*obj=*/nullptr, &kNoopCacheItemHelper,
+               std::max(charge, size_t{1}))
+      .PermitUncheckedError();
+}
+}  // namespace
+
+TieredCacheTuner::TieredCacheTuner(const TieredCacheOptions& opts)
+    : min_ratio_(opts.min_compressed_secondary_ratio),
+      max_ratio_(opts.max_compressed_secondary_ratio),
+      step_(opts.adaptive_ratio_step),
+      interval_(std::max(opts.adaptive_tuning_interval >> kSampleBits,
+                         uint64_t{1})),
+      primary_ghost_(NewSimCache()),
+      secondary_shadow_(NewSimCache()),
+      secondary_ghost_(NewSimCache()),
+      total_capacity_(opts.total_capacity),
+      ratio_(opts.compressed_secondary_ratio) {
+  secondary_shadow_->SetEvictionCallback(
+      [this](const Slice& key, Cache::Handle* handle, bool /*was_hit*/) {
+        SimInsert(secondary_ghost_.get(), key,
+                  secondary_shadow_->GetCharge(handle));
+        return false;
+      });
+  MutexLock l(&mutex_);
+  ResizeSimCaches();
+}
+
+bool TieredCacheTuner::IsSampled(const Slice& key) {
+  return (GetSliceNPHash64(key) & ((uint64_t{1} << kSampleBits) - 1)) == 0;
+}
+
+bool TieredCacheTuner::Take(Cache* sim_cache, const Slice& key) {
+  Cache::Handle* handle = sim_cache->Lookup(key);
+  if (handle == nullptr) {
+    return false;
+  }
+  sim_cache->Release(handle, /*erase_if_last_ref=*/true);
+  return true;
+}
+
+void TieredCacheTuner::OnPrimaryEviction(const Slice& key, size_t charge,
+                                         bool demoted) {
+  if (!IsSampled(key)) {
+    return;
+  }
+  SimInsert(primary_ghost_.get(), key, charge);
+  if (demoted) {
+    secondary_ghost_->Erase(key);
+    SimInsert(secondary_shadow_.get(), key, charge);
+  }
+}
+
+void TieredCacheTuner::OnInsert(const Slice& key, size_t charge,
+                                size_t compressed_size) {
+  if (!IsSampled(key)) {
+    return;
+  }
+  inserted_bytes_.fetch_add(charge, std::memory_order_relaxed);
+  inserted_compressed_bytes_.fetch_add(
+      compressed_size > 0 ? std::min(compressed_size, charge) : charge,
+      std::memory_order_relaxed);
+}
+
+bool TieredCacheTuner::OnLookup(const Slice& key, bool primary_hit,
+                                bool secondary_hit, double* new_ratio) {
+  if (!IsSampled(key)) {
+    return false;
+  }
+  if (!primary_hit) {
+    if (Take(primary_ghost_.get(), key)) {
+      primary_ghost_hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (secondary_hit) {
+      // Promoted back into the primary cache
+      Take(secondary_shadow_.get(), key);
+    } else if (Take(secondary_ghost_.get(), key)) {
+      secondary_ghost_hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  if ((num_lookups_.fetch_add(1, std::memory_order_relaxed) + 1) % interval_ !=
+      0) {
+    return false;
+  }
+  return MaybeTune(new_ratio);
+}
+
+bool TieredCacheTuner::MaybeTune(double* new_ratio) {
+  MutexLock l(&mutex_);
+  const uint64_t primary_hits =
+      primary_ghost_hits_.exchange(0, std::memory_order_relaxed);
+  const uint64_t secondary_hits =
+      secondary_ghost_hits_.exchange(0, std::memory_order_relaxed);
+
+  // Follow changes in compressibility by halving the history every interval
+  const uint64_t inserted = inserted_bytes_.load(std::memory_order_relaxed);
+  const uint64_t compressed =
+      inserted_compressed_bytes_.load(std::memory_order_relaxed);
+  if (inserted > 0) {
+    compression_ratio_ =
+        std::max(static_cast<double>(compressed) / inserted, 1.0 / 64);
+    inserted_bytes_.fetch_sub(inserted / 2, std::memory_order_relaxed);
+    inserted_compressed_bytes_.fetch_sub(compressed / 2,
+                                         std::memory_order_relaxed);
+  }
+
+  double ratio = ratio_;
+  // Require a margin of 1/8 so that the split does not oscillate between
+  // two steps when both tiers are about as useful
+  if (secondary_hits >= kMinMarginalHits &&
+      secondary_hits > primary_hits + primary_hits / 8) {
+    ratio = std::min(ratio + step_, max_ratio_);
+  } else if (primary_hits >= kMinMarginalHits &&
+             primary_hits > secondary_hits + secondary_hits / 8) {
+    ratio = std::max(ratio - step_, min_ratio_);
+  }
+  ResizeSimCaches();
+  if (ratio == ratio_) {
+    return false;
+  }
+  *new_ratio = ratio;
+  return true;
+}
+
+void TieredCacheTuner::SetCapacity(size_t total_capacity) {
+  MutexLock l(&mutex_);
+  total_capacity_ = total_capacity;
+  ResizeSimCaches();
+}
+
+void TieredCacheTuner::SetRatio(double compressed_secondary_ratio) {
+  MutexLock l(&mutex_);
+  ratio_ = compressed_secondary_ratio;
+  ResizeSimCaches();
+}
+
+void TieredCacheTuner::ResizeSimCaches() {
+  mutex_.AssertHeld();
+  const double step_bytes = step_ * total_capacity_;
+  const double secondary_bytes = ratio_ * total_capacity_;
+  auto sampled = [](double bytes) {
+    return static_cast<size_t>(bytes) >> kSampleBits;
+  };
+  primary_ghost_->SetCapacity(sampled(step_bytes));
+  // In uncompressed bytes, as charged to the primary cache
+  secondary_shadow_->SetCapacity(
+      sampled(secondary_bytes / compression_ratio_));
+  secondary_ghost_->SetCapacity(sampled(step_bytes / compression_ratio_));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
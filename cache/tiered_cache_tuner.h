@@ -0,0 +1,98 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "port/port.h"
+#include "rocksdb/cache.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Picks the split of a TieredCache between the primary cache and the
+// compressed secondary cache (see
+// TieredCacheOptions::adaptive_compressed_secondary_ratio).
+//
+// Like GhostCache in utilities/simulator_cache, it keeps key-only LRU sim
+// caches, but charges them with the block sizes and feeds them from the live
+// operations of the tiered cache rather than from a trace. Only keys whose
+// hash falls into a 1 / 2^kSampleBits sample are tracked, against
+// capacities scaled down by the same factor:
+// * A primary ghost holding the entries most recently evicted from the
+//   primary cache, sized to the capacity step. A lookup that misses the
+//   primary cache but hits the ghost would have been a primary hit with
+//   `step` more memory.
+// * A shadow of the secondary cache, fed by demotions from the primary
+//   cache, and a secondary ghost of the same size as the primary ghost
+//   (in compressed bytes) holding the entries evicted from the shadow. A
+//   lookup that misses both tiers but hits the secondary ghost would have
+//   been a secondary hit with `step` more memory.
+// As blocks are stored compressed in the secondary cache, the sizes of the
+// shadow and of the secondary ghost are scaled by the compression ratio of
+// the blocks inserted into the cache, estimated from the size of their
+// compressed form on storage when it is available.
+//
+// Every interval, `step` is moved from the tier with the fewer marginal hits
+// to the other one, unless the difference is too small to matter.
+class TieredCacheTuner {
+ public:
+  static constexpr int kSampleBits = 4;
+
+  explicit TieredCacheTuner(const TieredCacheOptions& opts);
+
+  // An entry was evicted from the primary cache, and spilled into the
+  // secondary cache if `demoted`
+  void OnPrimaryEviction(const Slice& key, size_t charge, bool demoted);
+
+  // An entry eligible for the secondary cache was inserted into the primary
+  // cache. `compressed_size` is 0 if it is not known.
+  void OnInsert(const Slice& key, size_t charge, size_t compressed_size);
+
+  // A lookup completed. Returns true and sets `*new_ratio` if the
+  // compressed secondary ratio should be changed.
+  bool OnLookup(const Slice& key, bool primary_hit, bool secondary_hit,
+                double* new_ratio);
+
+  // Must be called when the tiered cache is resized or the ratio is changed
+  void SetCapacity(size_t total_capacity);
+  void SetRatio(double compressed_secondary_ratio);
+
+ private:
+  static bool IsSampled(const Slice& key);
+  // Erases `key` from `sim_cache` and returns whether it was there
+  static bool Take(Cache* sim_cache, const Slice& key);
+
+  bool MaybeTune(double* new_ratio);
+  // REQUIRES: mutex_ held
+  void ResizeSimCaches();
+
+  const double min_ratio_;
+  const double max_ratio_;
+  const double step_;
+  // In sampled lookups
+  const uint64_t interval_;
+
+  std::shared_ptr<Cache> primary_ghost_;
+  std::shared_ptr<Cache> secondary_shadow_;
+  std::shared_ptr<Cache> secondary_ghost_;
+
+  std::atomic<uint64_t> num_lookups_{0};
+  std::atomic<uint64_t> primary_ghost_hits_{0};
+  std::atomic<uint64_t> secondary_ghost_hits_{0};
+  // For the compression ratio estimate
+  std::atomic<uint64_t> inserted_bytes_{0};
+  std::atomic<uint64_t> inserted_compressed_bytes_{0};
+
+  port::Mutex mutex_;
+  size_t total_capacity_;
+  double ratio_;
+  // Compressed size / uncompressed size
+  double compression_ratio_ = 1.0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
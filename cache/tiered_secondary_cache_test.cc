@@ -4,6 +4,7 @@
 //  (found in the LICENSE.Apache file in the root directory).
 //
 #include "cache/compressed_secondary_cache.h"
+#include "cache/flash_secondary_cache.h"
 #include "cache/secondary_cache_adapter.h"
 #include "db/db_test_util.h"
 #include "rocksdb/cache.h"
@@ -1042,6 +1043,250 @@ TEST_F(DBTieredSecondaryCacheTest, FSBufferTest) {
   Destroy(options);
 }
 
+class FlashSecondaryCacheTest : public testing::Test {
+ public:
+  FlashSecondaryCacheTest() {
+    opts_.path = test::PerThreadDBPath("flash_secondary_cache");
+    opts_.region_size = 64 * 1024;
+    opts_.size_classes = {1024, 4096};
+    opts_.capacity = 8 * opts_.region_size;
+  }
+
+  static std::string Key(int i) { return "key" + std::to_string(i); }
+
+  static Status CreateCallback(const Slice& data, CompressionType /*type*/,
+                               CacheTier /*source*/,
+                               Cache::CreateContext* /*context*/,
+                               MemoryAllocator* /*allocator*/,
+                               Cache::ObjectPtr* out_obj, size_t* out_charge) {
+    *out_obj = new std::string(data.ToString());
+    *out_charge = data.size();
+    return Status::OK();
+  }
+
+  static void DeleteCallback(Cache::ObjectPtr obj,
+                             MemoryAllocator* /*allocator*/) {
+    delete static_cast<std::string*>(obj);
+  }
+
+  static size_t SizeCallback(Cache::ObjectPtr obj) {
+    return static_cast<std::string*>(obj)->size();
+  }
+
+  static Status SaveToCallback(Cache::ObjectPtr from_obj, size_t from_offset,
+                               size_t length, char* out_buf) {
+    memcpy(out_buf, static_cast<std::string*>(from_obj)->data() + from_offset,
+           length);
+    return Status::OK();
+  }
+
+  static const Cache::CacheItemHelper* GetHelper() {
+    static const Cache::CacheItemHelper basic_helper(CacheEntryRole::kMisc,
+                                                     &DeleteCallback);
+    static const Cache::CacheItemHelper helper(
+        CacheEntryRole::kMisc, &DeleteCallback, &SizeCallback,
+        &SaveToCallback, &CreateCallback, &basic_helper);
+    return &helper;
+  }
+
+  // Returns the value of `key`, or "NOT_FOUND"
+  std::string Lookup(SecondaryCache* sec_cache, const std::string& key) {
+    bool kept_in_sec_cache = false;
+    std::unique_ptr<SecondaryCacheResultHandle> handle =
+        sec_cache->Lookup(key, GetHelper(), /*create_context=*/nullptr,
+                          /*wait=*/true, /*advise_erase=*/false,
+                          /*stats=*/nullptr, kept_in_sec_cache);
+    if (!handle) {
+      return "NOT_FOUND";
+    }
+    EXPECT_TRUE(handle->IsReady());
+    EXPECT_TRUE(kept_in_sec_cache);
+    std::unique_ptr<std::string> value(
+        static_cast<std::string*>(handle->Value()));
+    EXPECT_EQ(handle->Size(), value->size());
+    return *value;
+  }
+
+ protected:
+  FlashSecondaryCacheOptions opts_;
+};
+
+TEST_F(FlashSecondaryCacheTest, InsertAndLookup) {
+  std::shared_ptr<SecondaryCache> sec_cache;
+  ASSERT_OK(NewFlashSecondaryCache(opts_, &sec_cache));
+  auto flash_cache = static_cast<FlashSecondaryCache*>(sec_cache.get());
+
+  // Entries of both size classes and larger ones, in 7 of the 8 regions.
+  // Some are still in the write buffers, the others are read from the file.
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int i = 0; i < 60; i++) {
+    const int size = i % 3 == 0 ? 500 : (i % 3 == 1 ? 3000 : 10000);
+    values.push_back(rnd.RandomString(size));
+    ASSERT_OK(sec_cache->InsertSaved(Key(i), values.back()));
+  }
+  for (int i = 0; i < 60; i++) {
+    ASSERT_EQ(Lookup(sec_cache.get(), Key(i)), values[i]);
+  }
+  ASSERT_EQ(Lookup(sec_cache.get(), Key(60)), "NOT_FOUND");
+
+  std::vector<std::unique_ptr<SecondaryCacheResultHandle>> handles;
+  std::vector<SecondaryCacheResultHandle*> pending;
+  for (int i = 0; i < 60; i++) {
+    bool kept_in_sec_cache = false;
+    handles.push_back(sec_cache->Lookup(
+        Key(i), GetHelper(), /*create_context=*/nullptr, /*wait=*/false,
+        /*advise_erase=*/false, /*stats=*/nullptr, kept_in_sec_cache));
+    ASSERT_NE(handles.back(), nullptr);
+    if (!handles.back()->IsReady()) {
+      pending.push_back(handles.back().get());
+    }
+  }
+  sec_cache->WaitAll(pending);
+  for (int i = 0; i < 60; i++) {
+    ASSERT_TRUE(handles[i]->IsReady());
+    std::unique_ptr<std::string> value(
+        static_cast<std::string*>(handles[i]->Value()));
+    ASSERT_NE(value, nullptr);
+    ASSERT_EQ(*value, values[i]);
+  }
+
+  // advise_erase drops the entry
+  bool kept_in_sec_cache = true;
+  std::unique_ptr<SecondaryCacheResultHandle> handle = sec_cache->Lookup(
+      Key(0), GetHelper(), /*create_context=*/nullptr, /*wait=*/true,
+      /*advise_erase=*/true, /*stats=*/nullptr, kept_in_sec_cache);
+  ASSERT_NE(handle, nullptr);
+  ASSERT_FALSE(kept_in_sec_cache);
+  delete static_cast<std::string*>(handle->Value());
+  ASSERT_EQ(Lookup(sec_cache.get(), Key(0)), "NOT_FOUND");
+  sec_cache->Erase(Key(1));
+  ASSERT_EQ(Lookup(sec_cache.get(), Key(1)), "NOT_FOUND");
+
+  // Objects can be inserted directly
+  std::string obj = rnd.RandomString(2000);
+  ASSERT_OK(sec_cache->Insert(Key(100), &obj, GetHelper(),
+                              /*force_insert=*/false));
+  ASSERT_EQ(Lookup(sec_cache.get(), Key(100)), obj);
+  ASSERT_EQ(flash_cache->TEST_NumEvictedRegions(), 0u);
+}
+
+TEST_F(FlashSecondaryCacheTest, RegionEviction) {
+  std::shared_ptr<SecondaryCache> sec_cache;
+  ASSERT_OK(NewFlashSecondaryCache(opts_, &sec_cache));
+  auto flash_cache = static_cast<FlashSecondaryCache*>(sec_cache.get());
+
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int i = 0; i < 200; i++) {
+    values.push_back(rnd.RandomString(3000));
+    ASSERT_OK(sec_cache->InsertSaved(Key(i), values.back()));
+  }
+  // 16 entries per region, and the file holds 8 regions
+  ASSERT_GT(flash_cache->TEST_NumEvictedRegions(), 0u);
+  ASSERT_EQ(Lookup(sec_cache.get(), Key(0)), "NOT_FOUND");
+  for (int i = 200 - 6 * 16; i < 200; i++) {
+    ASSERT_EQ(Lookup(sec_cache.get(), Key(i)), values[i]);
+  }
+
+  // Entries that do not fit in a region are not cached
+  ASSERT_OK(sec_cache->InsertSaved(Key(1000),
+                                   rnd.RandomString(opts_.region_size)));
+  ASSERT_EQ(Lookup(sec_cache.get(), Key(1000)), "NOT_FOUND");
+}
+
+TEST_F(FlashSecondaryCacheTest, InvalidOptions) {
+  std::shared_ptr<SecondaryCache> sec_cache;
+  FlashSecondaryCacheOptions opts = opts_;
+  opts.capacity = 4 * opts.region_size;
+  ASSERT_TRUE(NewFlashSecondaryCache(opts, &sec_cache).IsInvalidArgument());
+  opts = opts_;
+  opts.size_classes = {4096, 1024};
+  ASSERT_TRUE(NewFlashSecondaryCache(opts, &sec_cache).IsInvalidArgument());
+  opts = opts_;
+  opts.region_size = 100;
+  ASSERT_TRUE(NewFlashSecondaryCache(opts, &sec_cache).IsInvalidArgument());
+  opts = opts_;
+  opts.path.clear();
+  ASSERT_TRUE(NewFlashSecondaryCache(opts, &sec_cache).IsInvalidArgument());
+  ASSERT_EQ(sec_cache, nullptr);
+}
+
+// The nvm tier of a TieredCache backed by a FlashSecondaryCache
+TEST_F(DBTieredSecondaryCacheTest, FlashNvmCacheTest) {
+  if (!LZ4_Supported()) {
+    ROCKSDB_GTEST_SKIP("This test requires LZ4 support.");
+    return;
+  }
+
+  FlashSecondaryCacheOptions flash_opts;
+  flash_opts.path = test::PerThreadDBPath("flash_nvm_cache");
+  flash_opts.region_size = 64 * 1024;
+  flash_opts.capacity = 2 * 1024 * 1024;
+  std::shared_ptr<SecondaryCache> flash_cache;
+  ASSERT_OK(NewFlashSecondaryCache(flash_opts, &flash_cache));
+
+  LRUCacheOptions lru_opts;
+  lru_opts.num_shard_bits = 0;
+  lru_opts.high_pri_pool_ratio = 0;
+  TieredCacheOptions cache_opts;
+  cache_opts.cache_opts = &lru_opts;
+  cache_opts.cache_type = PrimaryCacheType::kCacheTypeLRU;
+  cache_opts.comp_cache_opts.num_shard_bits = 0;
+  cache_opts.total_capacity = 270 * 1024;
+  cache_opts.compressed_secondary_ratio = 10.0 / 270;
+  cache_opts.nvm_sec_cache = flash_cache;
+
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewTieredCache(cache_opts);
+  ASSERT_NE(table_options.block_cache, nullptr);
+  table_options.block_size = 4 * 1024;
+  table_options.cache_index_and_filter_blocks = false;
+  Options options = GetDefaultOptions();
+  options.create_if_missing = true;
+  options.compression = kLZ4Compression;
+  options.statistics = CreateDBStatistics();
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options.paranoid_file_checks = false;
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  const int N = 256;
+  std::vector<std::string> expected;
+  for (int i = 0; i < N; i++) {
+    std::string p_v;
+    test::CompressibleString(&rnd, 0.5, 1007, &p_v);
+    ASSERT_OK(Put(Key(i), p_v));
+    expected.push_back(p_v);
+  }
+  ASSERT_OK(Flush());
+
+  // The first pass warms up the nvm tier, the second one is served from it
+  for (int pass = 0; pass < 2; pass++) {
+    for (int i = 0; i < N; i += 4) {
+      ASSERT_EQ(Get(Key(i)), expected[i]);
+    }
+  }
+  const uint64_t hits =
+      options.statistics->getTickerCount(SECONDARY_CACHE_HITS);
+  ASSERT_GT(hits, 0u);
+
+  std::vector<std::string> keys;
+  for (int i = 0; i < N; i += 16) {
+    keys.push_back(Key(i));
+  }
+  std::vector<std::string> values =
+      MultiGet(keys, /*snapshot=*/nullptr, /*async=*/true);
+  ASSERT_EQ(values.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    ASSERT_EQ(values[i], expected[i * 16]);
+  }
+  ASSERT_GT(options.statistics->getTickerCount(SECONDARY_CACHE_HITS), hits);
+
+  Close();
+  Destroy(options);
+}
+
 INSTANTIATE_TEST_CASE_P(
     DBTieredAdmPolicyTest, DBTieredAdmPolicyTest,
     ::testing::Values(TieredAdmissionPolicy::kAdmPolicyAuto,
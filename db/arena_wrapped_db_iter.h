@@ -78,6 +78,18 @@ class ArenaWrappedDBIter : public Iterator {
     db_iter_->Next();
     MaybeAutoRefresh(false /* is_seek */, DBIter::kForward);
   }
+  size_t NextBatch(size_t max_entries, size_t max_bytes, Slice* keys,
+                   Slice* values, std::string* buf) override {
+    if (read_options_.snapshot != nullptr &&
+        read_options_.auto_refresh_iterator_with_snapshot) {
+      // A refresh releases the data pinned by the batch, so copy everything
+      return Iterator::NextBatch(max_entries, max_bytes, keys, values, buf);
+    }
+    const size_t num_entries =
+        db_iter_->NextBatch(max_entries, max_bytes, keys, values, buf);
+    MaybeAutoRefresh(false /* is_seek */, DBIter::kForward);
+    return num_entries;
+  }
 
   void Prev() override {
     db_iter_->Prev();
@@ -628,9 +628,9 @@ ColumnFamilyData::ColumnFamilyData(
   if (_dummy_versions != nullptr) {
     internal_stats_.reset(
         new InternalStats(ioptions_.num_levels, ioptions_.clock, this));
-    table_cache_.reset(new TableCache(ioptions_, file_options, _table_cache,
-                                      block_cache_tracer, io_tracer,
-                                      db_session_id));
+    table_cache_.reset(new TableCache(
+        ioptions_, file_options, _table_cache, block_cache_tracer, io_tracer,
+        db_session_id, internal_stats_->GetBlockCacheHeatmap()));
     blob_file_cache_.reset(
         new BlobFileCache(_table_cache, &ioptions(), soptions(), id_,
                           internal_stats_->GetBlobFileReadHist(), io_tracer));
@@ -1588,6 +1588,11 @@ Status ColumnFamilyData::ValidateOptions(
           " runs but is smaller than the compaction trigger "
           "level0_file_num_compaction_trigger.");
     }
+    if (cf_options.compaction_options_universal.lazy_leveling_fanout == 1) {
+      return Status::NotSupported(
+          "CompactionOptionsUniversal::lazy_leveling_fanout should be 0 or at "
+          "least 2.");
+    }
   }
   return s;
 }
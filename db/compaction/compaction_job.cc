@@ -52,6 +52,7 @@
 #include "rocksdb/table.h"
 #include "rocksdb/utilities/options_type.h"
 #include "table/merging_iterator.h"
+#include "table/reusable_data_block.h"
 #include "table/table_builder.h"
 #include "table/unique_id_impl.h"
 #include "test_util/sync_point.h"
@@ -631,6 +632,16 @@ void CompactionJob::GenSubcompactionBoundaries() {
     return;
   }
 
+  // With more ranges than threads, threads take the next range when done
+  // with one (see Run())
+  const uint64_t num_planned_threads = num_planned_subcompactions;
+  if (!(c->immutable_options().compaction_pri == kRoundRobin &&
+        c->immutable_options().compaction_style == kCompactionStyleLevel) &&
+      mutable_db_options_copy_.subcompaction_ranges_per_thread > 1) {
+    num_planned_subcompactions *=
+        mutable_db_options_copy_.subcompaction_ranges_per_thread;
+  }
+
   // Group the ranges into subcompactions
   uint64_t target_range_size = std::max(
       total_size / num_planned_subcompactions,
@@ -659,12 +670,52 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
   TEST_SYNC_POINT_CALLBACK("CompactionJob::GenSubcompactionBoundaries:1",
                            &num_actual_subcompactions);
+  const uint64_t num_actual_threads =
+      std::min(num_actual_subcompactions, num_planned_threads);
+  if (num_actual_threads < num_actual_subcompactions) {
+    num_subcompaction_threads_ = static_cast<size_t>(num_actual_threads);
+  }
   // Shrink extra subcompactions resources when extra resrouces are acquired
   ShrinkSubcompactionResources(
-      std::min((int)(num_planned_subcompactions - num_actual_subcompactions),
+      std::min((int)(num_planned_threads - num_actual_threads),
                extra_num_subcompaction_threads_reserved_));
 }
 
+void CompactionJob::CollectHotKeyRanges() {
+  const Compaction* c = compact_->compaction;
+  const auto* table_options =
+      c->mutable_cf_options()
+          .table_factory->GetOptions<BlockBasedTableOptions>();
+  if (table_options == nullptr || table_options->block_cache == nullptr ||
+      table_options->prepopulate_block_cache !=
+          BlockBasedTableOptions::PrepopulateBlockCache::kFlushAndCompaction ||
+      table_options->prepopulate_block_cache_compaction_budget == 0) {
+    return;
+  }
+
+  ColumnFamilyData* cfd = c->column_family_data();
+  ReadOptions read_options(Env::IOActivity::kCompaction);
+  read_options.fill_cache = false;
+  read_options.rate_limiter_priority = GetRateLimiterPriority();
+  std::vector<std::pair<std::string, std::string>> ranges;
+  for (size_t lvl_idx = 0; lvl_idx < c->num_input_levels(); lvl_idx++) {
+    const LevelFilesBrief* flevel = c->input_levels(lvl_idx);
+    for (size_t i = 0; i < flevel->num_files; i++) {
+      const FileMetaData* f = flevel->files[i].file_metadata;
+      // Best effort, a file that fails just contributes no ranges
+      cfd->table_cache()
+          ->GetCachedKeyRanges(read_options, cfd->internal_comparator(), *f,
+                               c->mutable_cf_options(), ranges)
+          .PermitUncheckedError();
+    }
+  }
+  if (!ranges.empty()) {
+    hot_key_ranges_.reset(new HotKeyRanges(
+        cfd->user_comparator(), std::move(ranges),
+        table_options->prepopulate_block_cache_compaction_budget));
+  }
+}
+
 Status CompactionJob::Run() {
   // 第一阶段：初始化 - 设置线程状态、记录开始时间、获取输入文件属性
   AutoThreadOperationStageUpdater stage_updater(
@@ -673,25 +724,39 @@ Status CompactionJob::Run() {
   log_buffer_->FlushBufferToLog();  // 刷新日志缓冲区到实际日志
   LogCompaction();  // 记录压缩任务的详细信息
 
-  const size_t num_threads = compact_->sub_compact_states.size();
-  assert(num_threads > 0);
+  const size_t num_subcompactions = compact_->sub_compact_states.size();
+  assert(num_subcompactions > 0);
+  const size_t num_threads =
+      num_subcompaction_threads_ > 0
+          ? std::min(num_subcompaction_threads_, num_subcompactions)
+          : num_subcompactions;
   const uint64_t start_micros = db_options_.clock->NowMicros();  // 记录压缩开始时间
   compact_->compaction->GetOrInitInputTableProperties();  // 获取输入文件元数据属性
+  CollectHotKeyRanges();
   
   // 第二阶段：启动并行子压缩 - 创建工作线程，主线程也参与执行
-  // Launch a thread for each of subcompactions 1...num_threads-1
+  // Launch a thread for each of subcompactions 1...num_threads-1. With
+  // fewer threads than subcompactions, each thread then takes the next
+  // subcompaction not yet started when done with its own, so that threads
+  // done early take over the remaining work of the others.
+  std::atomic<size_t> next_subcompaction(num_threads);
+  auto process_subcompactions = [&](size_t first) {
+    for (size_t i = first; i < num_subcompactions;
+         i = next_subcompaction.fetch_add(1)) {
+      ProcessKeyValueCompaction(&compact_->sub_compact_states[i]);
+    }
+  };
   std::vector<port::Thread> thread_pool;
   thread_pool.reserve(num_threads - 1);  // 预分配内存避免动态扩容
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
+  for (size_t i = 1; i < num_threads; i++) {
     // 为子压缩1到n-1创建工作线程，使用port::Thread跨平台线程抽象
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this,
-                             &compact_->sub_compact_states[i]);
+    thread_pool.emplace_back(process_subcompactions, i);
   }
 
   // Always schedule the first subcompaction (whether or not there are also
   // others) in the current thread to be efficient with resources
   // 主线程执行第一个子压缩（索引0），避免资源浪费
-  ProcessKeyValueCompaction(compact_->sub_compact_states.data());
+  process_subcompactions(0);
   
   // 第三阶段：等待完成并统计 - 同步所有线程，收集统计信息
   // Wait for all other threads (if there are any) to finish execution
@@ -836,7 +901,7 @@ Status CompactionJob::Run() {
         }
       } // while
     };
-    for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
+    for (size_t i = 1; i < num_threads; i++) {
       // 为验证任务创建工作线程，并行验证多个文件
       thread_pool.emplace_back(
           verify_table, std::ref(compact_->sub_compact_states[i].status));
@@ -1429,6 +1494,22 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
             sub_compact->end.has_value() ? &end_user_key : nullptr);
       };
 
+  // Input data blocks starting with the key being output are offered to the
+  // table builder, which writes them as stored unless an entry up to their
+  // separator comes out changed or is dropped (see ReusableDataBlock)
+  const auto* table_options =
+      mutable_cf_options.table_factory->GetOptions<BlockBasedTableOptions>();
+  const bool reuse_data_blocks =
+      table_options != nullptr &&
+      table_options->reuse_data_blocks_in_compaction && ts_sz == 0 &&
+      !sub_compact->compaction->SupportsPerKeyPlacement();
+  ReusableDataBlock reusable_block;
+  // Whether the entries output are checked against the separator of the last
+  // reusable data block offered
+  bool in_reusable_block = false;
+  std::string reusable_block_separator;
+  uint64_t last_num_input_entries = 0;
+
   Status status;
   TEST_SYNC_POINT_CALLBACK(
       "CompactionJob::ProcessKeyValueCompaction()::Processing",
@@ -1486,8 +1567,38 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     // and `close_file_func`.
     // TODO: it would be better to have the compaction file open/close moved
     // into `CompactionOutputs` which has the output file information.
-    status = sub_compact->AddToOutput(*c_iter, use_proximal_output,
-                                      open_file_func, close_file_func);
+    bool has_reusable_block = false;
+    if (reuse_data_blocks && !c_iter->IsDeleteRangeSentinelKey()) {
+      // An entry is unchanged when it is output as the input iterator has it
+      // and right after the previous input entry
+      const uint64_t num_input_entries = c_iter->NumInputEntryScanned();
+      const bool unchanged =
+          c_iter->HasNumInputEntryScanned() && raw_input->Valid() &&
+          raw_input->key() == c_iter->key() &&
+          raw_input->value().data() == c_iter->value().data();
+      if (in_reusable_block) {
+        const bool in_block = cfd->internal_comparator().Compare(
+                                  c_iter->key(), reusable_block_separator) <= 0;
+        if (num_input_entries != last_num_input_entries + 1 ||
+            (in_block && !unchanged)) {
+          sub_compact->Current().AbandonReusableDataBlock();
+          in_reusable_block = false;
+        } else if (!in_block) {
+          in_reusable_block = false;
+        }
+      }
+      if (!in_reusable_block && unchanged &&
+          raw_input->GetReusableDataBlock(end.has_value() ? &*end : nullptr,
+                                          &reusable_block)) {
+        reusable_block_separator = reusable_block.separator;
+        in_reusable_block = true;
+        has_reusable_block = true;
+      }
+      last_num_input_entries = num_input_entries;
+    }
+    status = sub_compact->AddToOutput(
+        *c_iter, use_proximal_output, open_file_func, close_file_func,
+        has_reusable_block ? &reusable_block : nullptr);
     if (!status.ok()) {
       break;
     }
@@ -2131,6 +2242,7 @@ Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
       0 /* oldest_key_time */, current_time, db_id_, db_session_id_,
       sub_compact->compaction->max_output_file_size(), file_number,
       proximal_after_seqno_ /*last_level_inclusive_max_seqno_threshold*/);
+  tboptions.hot_key_ranges = hot_key_ranges_.get();
 
   outputs.NewBuilder(tboptions);
 
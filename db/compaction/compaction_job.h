@@ -43,6 +43,7 @@
 #include "rocksdb/transaction_log.h"
 #include "util/autovector.h"
 #include "util/stop_watch.h"
+#include "table/hot_key_ranges.h"
 #include "util/thread_local.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -258,6 +259,12 @@ class CompactionJob {
   // consecutive groups such that each group has a similar size.
   void GenSubcompactionBoundaries();
 
+  // With PrepopulateBlockCache::kFlushAndCompaction, collects the key ranges
+  // of the input data blocks that are in the block cache, so that the output
+  // data blocks covering them are inserted into the block cache as they are
+  // written.
+  void CollectHotKeyRanges();
+
   // Get the number of planned subcompactions based on max_subcompactions and
   // extra reserved resources
   uint64_t GetSubcompactionsLimit();
@@ -333,6 +340,8 @@ class CompactionJob {
   bool measure_io_stats_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<std::string> boundaries_;
+  // See CollectHotKeyRanges(). Null if there are none.
+  std::unique_ptr<HotKeyRanges> hot_key_ranges_;
   Env::Priority thread_pri_;
   std::string full_history_ts_low_;
   std::string trim_ts_;
@@ -342,6 +351,10 @@ class CompactionJob {
   // Stores the number of reserved threads in shared env_ for the number of
   // extra subcompaction in kRoundRobin compaction priority
   int extra_num_subcompaction_threads_reserved_;
+  // The number of threads running the subcompactions, if fewer than the
+  // subcompactions (see DBOptions::subcompaction_ranges_per_thread). 0 for
+  // one thread per subcompaction.
+  size_t num_subcompaction_threads_ = 0;
 
   // Stores the pointer to bg_compaction_scheduled_,
   // bg_bottom_compaction_scheduled_ in DBImpl. Mutex is required when accessing
@@ -358,7 +358,8 @@ bool CompactionOutputs::ShouldStopBefore(const CompactionIterator& c_iter) {
 Status CompactionOutputs::AddToOutput(
     const CompactionIterator& c_iter,
     const CompactionFileOpenFunc& open_file_func,
-    const CompactionFileCloseFunc& close_file_func) {
+    const CompactionFileCloseFunc& close_file_func,
+    ReusableDataBlock* reusable_block) {
   Status s;
   bool is_range_del = c_iter.IsDeleteRangeSentinelKey();
   if (is_range_del && compaction_->bottommost_level()) {
@@ -411,6 +412,9 @@ Status CompactionOutputs::AddToOutput(
   if (!s.ok()) {
     return s;
   }
+  if (reusable_block != nullptr) {
+    builder_->SetReusableDataBlock(std::move(*reusable_block));
+  }
   builder_->Add(key, value);
 
   stats_.num_output_records++;
@@ -19,6 +19,7 @@
 namespace ROCKSDB_NAMESPACE {
 
 class CompactionOutputs;
+struct ReusableDataBlock;
 using CompactionFileOpenFunc = std::function<Status(CompactionOutputs&)>;
 using CompactionFileCloseFunc =
     std::function<Status(CompactionOutputs&, const Status&, const Slice&)>;
@@ -162,6 +163,14 @@ class CompactionOutputs {
 
   bool HasBuilder() const { return builder_ != nullptr; }
 
+  // The entries added since the last reusable data block are not the entries
+  // of that block left unchanged (see ReusableDataBlock)
+  void AbandonReusableDataBlock() {
+    if (builder_ != nullptr) {
+      builder_->AbandonReusableDataBlock();
+    }
+  }
+
   FileMetaData* GetMetaData() { return &current_output().meta; }
 
   bool HasOutput() const { return !outputs_.empty(); }
@@ -248,9 +257,12 @@ class CompactionOutputs {
 
   // Add current key from compaction_iterator to the output file. If needed
   // close and open new compaction output with the functions provided.
+  // `reusable_block`, if not null, is an input data block starting with the
+  // current key, handed to the table builder (see ReusableDataBlock).
   Status AddToOutput(const CompactionIterator& c_iter,
                      const CompactionFileOpenFunc& open_file_func,
-                     const CompactionFileCloseFunc& close_file_func);
+                     const CompactionFileCloseFunc& close_file_func,
+                     ReusableDataBlock* reusable_block = nullptr);
 
   // Close the current output. `open_file_func` is needed for creating new file
   // for range-dels only output file.
@@ -1495,6 +1495,44 @@ TEST_F(CompactionPickerTest, CompactionPriMinOverlapping1) {
   ASSERT_GE(uint64_t{55000000}, compaction->OutputFilePreallocationSize());
 }
 
+TEST_F(CompactionPickerTest, CompactionPriByReadHeat) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  ioptions_.compaction_pri = kByReadHeat;
+  mutable_cf_options_.target_file_size_base = 100000000000;
+  mutable_cf_options_.target_file_size_multiplier = 10;
+  mutable_cf_options_.max_bytes_for_level_base = 10 * 1024 * 1024;
+  mutable_cf_options_.RefreshDerivedOptions(ioptions_);
+
+  Add(2, 6U, "150", "179", 50000000U);
+  Add(2, 7U, "180", "220", 50000000U);
+  Add(2, 8U, "321", "400", 50000000U);  // File not overlapping
+  Add(2, 9U, "721", "800", 50000000U);
+
+  Add(3, 26U, "150", "170", 260000000U);
+  Add(3, 27U, "171", "179", 260000000U);
+  Add(3, 28U, "191", "220", 260000000U);
+  Add(3, 29U, "221", "300", 260000000U);
+  Add(3, 30U, "750", "900", 260000000U);
+  // File 7 is read, with a sorted run below it that its lookups also check.
+  // File 8 is read more, but no other sorted run overlaps it.
+  for (FileMetaData* f : vstorage_->LevelFiles(2)) {
+    if (f->fd.GetNumber() == 7U) {
+      f->stats.num_reads_sampled = 100;
+    } else if (f->fd.GetNumber() == 8U) {
+      f->stats.num_reads_sampled = 1000;
+    }
+  }
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_,
+      /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+      vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(7U, compaction->input(0, 0)->fd.GetNumber());
+}
+
 TEST_F(CompactionPickerTest, CompactionPriMinOverlapping2) {
   NewVersionStorage(6, kCompactionStyleLevel);
   ioptions_.compaction_pri = kMinOverlappingRatio;
@@ -3801,6 +3839,81 @@ TEST_F(CompactionPickerTest, UniversalSizeAmpTierCompactionLastLevel) {
   ASSERT_EQ(compaction->input_levels(6)->num_files, 0);
 }
 
+TEST_F(CompactionPickerTest, UniversalLazyLevelingTiering) {
+  const uint64_t kFileSize = 1000;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  mutable_cf_options_.compaction_options_universal.lazy_leveling_fanout = 4;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(5, kCompactionStyleUniversal);
+  // Four runs of a tier, followed by a larger run of the next one
+  Add(0, 1U, "150", "200", kFileSize, 0, 900, 950);
+  Add(0, 2U, "150", "200", kFileSize, 0, 800, 850);
+  Add(0, 3U, "150", "200", kFileSize, 0, 700, 750);
+  Add(0, 4U, "150", "200", kFileSize, 0, 600, 650);
+  Add(0, 5U, "150", "200", 20 * kFileSize, 0, 500, 550);
+  Add(4, 10U, "101", "199", 1000 * kFileSize, 0, 100, 150);
+  Add(4, 11U, "201", "299", 1000 * kFileSize, 0, 100, 150);
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_,
+          /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+          vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction);
+  ASSERT_EQ(CompactionReason::kUniversalSizeRatio,
+            compaction->compaction_reason());
+  ASSERT_EQ(0, compaction->output_level());
+  ASSERT_EQ(4U, compaction->num_input_files(0));
+  ASSERT_EQ(1U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(4U, compaction->input(0, 3)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, UniversalLazyLevelingMergeIntoLastLevel) {
+  const uint64_t kFileSize = 100000;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  mutable_cf_options_.compaction_options_universal.lazy_leveling_fanout = 3;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(5, kCompactionStyleUniversal);
+  Add(0, 1U, "150", "200", kFileSize, 0, 900, 950);
+  Add(0, 2U, "210", "280", kFileSize, 0, 800, 850);
+  Add(4, 10U, "001", "099", kFileSize, 0, 100, 150);
+  Add(4, 11U, "101", "199", kFileSize, 0, 100, 150);
+  Add(4, 12U, "201", "299", kFileSize, 0, 100, 150);
+  Add(4, 13U, "301", "399", kFileSize, 0, 100, 150);
+  Add(4, 14U, "401", "499", kFileSize, 0, 100, 150);
+  Add(4, 15U, "501", "599", kFileSize, 0, 100, 150);
+  Add(4, 16U, "601", "699", kFileSize, 0, 100, 150);
+  Add(4, 17U, "701", "799", kFileSize, 0, 100, 150);
+  UpdateVersionStorageInfo();
+
+  // The newer runs do not add up to 1/3 of the last one
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_,
+          /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+          vstorage_.get(), &log_buffer_));
+  ASSERT_FALSE(compaction);
+
+  // They add up to 1/4 of it, which only has two files overlapping them
+  mutable_cf_options_.compaction_options_universal.lazy_leveling_fanout = 4;
+  compaction.reset(universal_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_,
+      /*existing_snapshots=*/{}, /* snapshot_checker */ nullptr,
+      vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction);
+  ASSERT_EQ(CompactionReason::kUniversalSizeAmplification,
+            compaction->compaction_reason());
+  ASSERT_EQ(4, compaction->output_level());
+  ASSERT_EQ(0, compaction->start_level());
+  ASSERT_EQ(2U, compaction->input_levels(0)->num_files);
+  ASSERT_EQ(2U, compaction->input_levels(4)->num_files);
+  ASSERT_EQ(11U, compaction->input(4, 0)->fd.GetNumber());
+  ASSERT_EQ(12U, compaction->input(4, 1)->fd.GetNumber());
+}
+
 TEST_F(CompactionPickerU64TsTest, Overlap) {
   int num_levels = ioptions_.num_levels;
   NewVersionStorage(num_levels, kCompactionStyleLevel);
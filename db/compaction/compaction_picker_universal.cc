@@ -140,6 +140,19 @@ class UniversalCompactionBuilder {
   // because some files are being compacted.
   Compaction* PickPeriodicCompaction();
 
+  // Used instead of the size amp, size ratio and read amp compactions with
+  // compaction_options_universal.lazy_leveling_fanout. Sorted runs other
+  // than the last one are tiered: consecutive runs of similar size are
+  // merged once there are `lazy_leveling_fanout` of them. The last sorted
+  // run is leveled: the other runs are merged into it once they add up to
+  // 1 / `lazy_leveling_fanout` of its size.
+  Compaction* PickLazyLevelingCompaction();
+
+  // Merges the sorted runs from start_index to the second to last one into
+  // the last one. When the last sorted run is the last level, only the files
+  // of the last level that the other runs overlap are compacted.
+  Compaction* PickLazyLevelingMergeIntoLastRun(size_t start_index);
+
   bool ShouldSkipLastSortedRunForSizeAmpCompaction() const {
     assert(!sorted_runs_.empty());
     return mutable_cf_options_.preclude_last_level_data_seconds > 0 &&
@@ -589,8 +602,14 @@ Compaction* UniversalCompactionBuilder::PickCompaction() {
 
   if (c == nullptr &&
       sorted_runs_.size() >= static_cast<size_t>(file_num_compaction_trigger)) {
-    // Check for size amplification.
-    if ((c = PickCompactionToReduceSizeAmp()) != nullptr) {
+    if (mutable_cf_options_.compaction_options_universal.lazy_leveling_fanout >
+        0) {
+      if ((c = PickLazyLevelingCompaction()) != nullptr) {
+        ROCKS_LOG_BUFFER(log_buffer_,
+                         "[%s] Universal: compacting for lazy leveling\n",
+                         cf_name_.c_str());
+      }
+    } else if ((c = PickCompactionToReduceSizeAmp()) != nullptr) {
       TEST_SYNC_POINT("PickCompactionToReduceSizeAmpReturnNonnullptr");
       ROCKS_LOG_BUFFER(log_buffer_, "[%s] Universal: compacting for size amp\n",
                        cf_name_.c_str());
@@ -1551,6 +1570,8 @@ Compaction* UniversalCompactionBuilder::PickCompactionWithSortedRunRange(
     } else if (compaction_reason ==
                CompactionReason::kUniversalSizeAmplification) {
       comp_reason_print_string = "size amp";
+    } else if (compaction_reason == CompactionReason::kUniversalSizeRatio) {
+      comp_reason_print_string = "size ratio";
     } else {
       assert(false);
       comp_reason_print_string = "unknown: ";
@@ -1568,6 +1589,8 @@ Compaction* UniversalCompactionBuilder::PickCompactionWithSortedRunRange(
   int output_level;
   if (end_index == sorted_runs_.size() - 1) {
     output_level = max_output_level;
+  } else if (sorted_runs_[end_index + 1].level == 0) {
+    output_level = 0;
   } else {
     // if it's not including all sorted_runs, it can only output to the level
     // above the `end_index + 1` sorted_run.
@@ -1672,6 +1695,151 @@ Compaction* UniversalCompactionBuilder::PickPeriodicCompaction() {
   return c;
 }
 
+Compaction* UniversalCompactionBuilder::PickLazyLevelingCompaction() {
+  const unsigned int fanout =
+      mutable_cf_options_.compaction_options_universal.lazy_leveling_fanout;
+  assert(fanout >= 2);
+  if (sorted_runs_.size() < 2) {
+    return nullptr;
+  }
+  auto is_available = [](const SortedRun& sr) {
+    return !sr.being_compacted && !sr.level_has_marked_standalone_rangedel;
+  };
+  const size_t last_index = sorted_runs_.size() - 1;
+
+  // Leveling: merge the longest span of available sorted runs ending right
+  // before the last one into it, once they are large enough
+  if (is_available(sorted_runs_[last_index])) {
+    size_t start_index = last_index;
+    uint64_t newer_runs_size = 0;
+    while (start_index > 0 && is_available(sorted_runs_[start_index - 1])) {
+      newer_runs_size += sorted_runs_[start_index - 1].compensated_file_size;
+      --start_index;
+    }
+    const uint64_t last_run_size =
+        sorted_runs_[last_index].compensated_file_size;
+    if (start_index < last_index && newer_runs_size * fanout >= last_run_size) {
+      ROCKS_LOG_BUFFER(log_buffer_,
+                       "[%s] Universal: lazy leveling merges %" ROCKSDB_PRIszt
+                       " sorted runs of size %" PRIu64
+                       " into the last one of size %" PRIu64,
+                       cf_name_.c_str(), last_index - start_index,
+                       newer_runs_size, last_run_size);
+      Compaction* c = PickLazyLevelingMergeIntoLastRun(start_index);
+      if (c != nullptr) {
+        return c;
+      }
+    }
+  }
+
+  // Tiering: merge `fanout` consecutive sorted runs, none of which is
+  // `fanout` times larger than the newest one, into one of the next tier
+  const size_t max_merge_width =
+      mutable_cf_options_.compaction_options_universal.max_merge_width;
+  const size_t min_merge_width = std::max<size_t>(
+      fanout,
+      mutable_cf_options_.compaction_options_universal.min_merge_width);
+  for (size_t start_index = 0; start_index < last_index; ++start_index) {
+    const SortedRun& first = sorted_runs_[start_index];
+    if (!is_available(first)) {
+      continue;
+    }
+    const uint64_t tier_limit = first.compensated_file_size * fanout;
+    size_t end_index = start_index;
+    while (end_index + 1 < last_index &&
+           end_index - start_index + 1 < max_merge_width &&
+           is_available(sorted_runs_[end_index + 1]) &&
+           sorted_runs_[end_index + 1].compensated_file_size < tier_limit) {
+      ++end_index;
+    }
+    if (end_index - start_index + 1 >= min_merge_width) {
+      return PickCompactionWithSortedRunRange(
+          start_index, end_index, CompactionReason::kUniversalSizeRatio);
+    }
+  }
+  return nullptr;
+}
+
+Compaction* UniversalCompactionBuilder::PickLazyLevelingMergeIntoLastRun(
+    size_t start_index) {
+  assert(start_index + 1 < sorted_runs_.size());
+  const int output_level =
+      vstorage_->MaxOutputLevel(ioptions_.allow_ingest_behind);
+  const int start_level = sorted_runs_[start_index].level;
+  if (sorted_runs_.back().level != output_level) {
+    // Nothing to gain over a full merge when the last sorted run is an L0
+    // file or a level that is not the last one
+    return PickCompactionToOldest(
+        start_index, CompactionReason::kUniversalSizeAmplification);
+  }
+
+  std::vector<CompactionInputFiles> inputs(output_level - start_level + 1);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    inputs[i].level = start_level + static_cast<int>(i);
+  }
+  uint64_t estimated_total_size = 0;
+  for (size_t i = start_index; i + 1 < sorted_runs_.size(); ++i) {
+    const SortedRun& picking_sr = sorted_runs_[i];
+    if (picking_sr.level == 0) {
+      inputs[0].files.push_back(picking_sr.file);
+    } else {
+      auto& files = inputs[picking_sr.level - start_level].files;
+      for (auto* f : vstorage_->LevelFiles(picking_sr.level)) {
+        files.push_back(f);
+      }
+    }
+    estimated_total_size += picking_sr.size;
+    char file_num_buf[256];
+    picking_sr.DumpSizeInfo(file_num_buf, sizeof(file_num_buf), i);
+    ROCKS_LOG_BUFFER(log_buffer_, "[%s] Universal: lazy leveling picking %s",
+                     cf_name_.c_str(), file_num_buf);
+  }
+
+  // Only the files of the last level within the key range of the newer runs
+  InternalKey smallest, largest;
+  picker_->GetRange(inputs, &smallest, &largest, output_level);
+  CompactionInputFiles& last_level_inputs = inputs.back();
+  vstorage_->GetOverlappingInputs(output_level, &smallest, &largest,
+                                  &last_level_inputs.files);
+  if (!last_level_inputs.empty() &&
+      !picker_->ExpandInputsToCleanCut(cf_name_, vstorage_,
+                                       &last_level_inputs)) {
+    return nullptr;
+  }
+  for (auto* f : last_level_inputs.files) {
+    estimated_total_size += f->fd.GetFileSize();
+  }
+
+  if (picker_->FilesRangeOverlapWithCompaction(
+          inputs, output_level,
+          Compaction::EvaluateProximalLevel(vstorage_, mutable_cf_options_,
+                                            ioptions_, start_level,
+                                            output_level))) {
+    return nullptr;
+  }
+
+  uint32_t path_id =
+      GetPathId(ioptions_, mutable_cf_options_, estimated_total_size);
+  return new Compaction(
+      vstorage_, ioptions_, mutable_cf_options_, mutable_db_options_,
+      std::move(inputs), output_level,
+      MaxFileSizeForLevel(mutable_cf_options_, output_level,
+                          kCompactionStyleUniversal),
+      GetMaxOverlappingBytes(), path_id,
+      GetCompressionType(vstorage_, mutable_cf_options_, output_level, 1,
+                         true /* enable_compression */),
+      GetCompressionOptions(mutable_cf_options_, vstorage_, output_level,
+                            true /* enable_compression */),
+      mutable_cf_options_.default_write_temperature,
+      /* max_subcompactions */ 0, /* grandparents */ {},
+      /* earliest_snapshot */ std::nullopt,
+      /* snapshot_checker */ nullptr,
+      /* is manual */ false,
+      /* trim_ts */ "", score_, false /* deletion_compaction */,
+      /* l0_files_might_overlap */ true,
+      CompactionReason::kUniversalSizeAmplification);
+}
+
 uint64_t UniversalCompactionBuilder::GetMaxOverlappingBytes() const {
   if (!mutable_cf_options_.compaction_options_universal.incremental) {
     return std::numeric_limits<uint64_t>::max();
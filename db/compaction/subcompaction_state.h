@@ -199,7 +199,8 @@ class SubcompactionState {
   // Add compaction_iterator key/value to the `Current` output group.
   Status AddToOutput(const CompactionIterator& iter, bool use_proximal_output,
                      const CompactionFileOpenFunc& open_file_func,
-                     const CompactionFileCloseFunc& close_file_func);
+                     const CompactionFileCloseFunc& close_file_func,
+                     ReusableDataBlock* reusable_block = nullptr);
 
   // Close all compaction output files, both output_to_proximal_level outputs
   // and normal outputs.
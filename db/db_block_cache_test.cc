@@ -19,6 +19,7 @@
 #include "db/db_impl/db_impl.h"
 #include "db/db_test_util.h"
 #include "env/unique_id_gen.h"
+#include "monitoring/block_cache_heatmap.h"
 #include "port/stack_trace.h"
 #include "rocksdb/persistent_cache.h"
 #include "rocksdb/statistics.h"
@@ -466,6 +467,67 @@ TEST_F(DBBlockCacheTest, WarmCacheWithDataBlocksDuringFlush) {
             options.statistics->getTickerCount(BLOCK_CACHE_DATA_ADD));
 }
 
+TEST_F(DBBlockCacheTest, WarmCacheWithHotDataBlocksDuringCompaction) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1 << 25, 0, false);
+  table_options.cache_index_and_filter_blocks = false;
+  // One key per data block
+  table_options.block_size = 1;
+  table_options.prepopulate_block_cache =
+      BlockBasedTableOptions::PrepopulateBlockCache::kFlushAndCompaction;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  auto key = [](size_t i) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "key%02d", static_cast<int>(i));
+    return std::string(buf);
+  };
+  std::string value(kValueSize, 'a');
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    ASSERT_OK(Put(key(i), value));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ(kNumBlocks,
+            options.statistics->getTickerCount(BLOCK_CACHE_DATA_ADD));
+
+  // Only the second half of the keys is hot. The block before the hot ones
+  // must stay cold.
+  table_options.block_cache->EraseUnRefEntries();
+  for (size_t i = kNumBlocks / 2; i < kNumBlocks; i++) {
+    ASSERT_EQ(value, Get(key(i)));
+  }
+  ASSERT_OK(options.statistics->Reset());
+
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  ASSERT_EQ(kNumBlocks - kNumBlocks / 2,
+            options.statistics->getTickerCount(BLOCK_CACHE_DATA_ADD));
+  // Leave out the lookups of the compaction into the input blocks
+  ASSERT_OK(options.statistics->Reset());
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    ASSERT_EQ(value, Get(key(i)));
+  }
+  ASSERT_EQ(kNumBlocks - kNumBlocks / 2,
+            options.statistics->getTickerCount(BLOCK_CACHE_DATA_HIT));
+  ASSERT_EQ(kNumBlocks / 2,
+            options.statistics->getTickerCount(BLOCK_CACHE_DATA_MISS));
+
+  // Within the budget of the compaction
+  table_options.prepopulate_block_cache_compaction_budget = kValueSize * 3;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_OK(options.statistics->Reset());
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  ASSERT_EQ(2, options.statistics->getTickerCount(BLOCK_CACHE_DATA_ADD));
+}
+
 // This test cache data, index and filter blocks during flush.
 class DBBlockCacheTest1 : public DBTestBase,
                           public ::testing::WithParamInterface<uint32_t> {
@@ -1273,6 +1335,124 @@ TEST_F(DBBlockCacheTest, HyperClockCacheReportProblems) {
   EXPECT_EQ(logger->PopCounts(), (std::array<int, 3>{{0, 1, 0}}));
 }
 
+TEST_F(DBBlockCacheTest, CacheTenantStats) {
+  std::shared_ptr<Cache> cache = NewLRUCache(1 << 20, /*num_shard_bits=*/0);
+  auto table_options = GetTableOptions();
+  auto options = GetOptions(table_options);
+  table_options.block_cache = cache;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  std::map<std::string, std::string> values;
+  std::string str;
+  // Not a cache tenant
+  ASSERT_FALSE(
+      db_->GetMapProperty(DB::Properties::kBlockCacheTenantStats, &values));
+  ASSERT_FALSE(db_->GetProperty(DB::Properties::kBlockCacheTenantStats, &str));
+
+  CacheTenantOptions tenant_opts;
+  tenant_opts.name = "serving";
+  tenant_opts.reserved_ratio = 0.25;
+  table_options.block_cache = NewCacheTenant(cache, tenant_opts);
+  ASSERT_NE(table_options.block_cache, nullptr);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  InitTable(options);
+  ASSERT_OK(Flush());
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    ASSERT_EQ(Get(std::to_string(i)), std::string(kValueSize, 'a'));
+    ASSERT_EQ(Get(std::to_string(i)), std::string(kValueSize, 'a'));
+  }
+
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kBlockCacheTenantStats, &values));
+  ASSERT_EQ(values["name"], "serving");
+  ASSERT_GT(ParseUint64(values["usage"]), 0U);
+  ASSERT_GE(ParseUint64(values["hits"]), kNumBlocks);
+  ASSERT_GE(ParseUint64(values["misses"]), kNumBlocks);
+  ASSERT_EQ(values.count("hit-ratio"), 1U);
+  ASSERT_TRUE(db_->GetProperty(DB::Properties::kBlockCacheTenantStats, &str));
+  ASSERT_NE(str.find("name: serving"), std::string::npos);
+}
+
+TEST_F(DBBlockCacheTest, BlockCacheHeatmap) {
+  auto table_options = GetTableOptions();
+  table_options.block_cache = NewLRUCache(1 << 20, /*num_shard_bits=*/0);
+  auto options = GetOptions(table_options);
+  Reopen(options);
+  InitTable(options);
+  ASSERT_OK(Flush());
+
+  auto read_all = [&](size_t num_lookups) {
+    for (size_t i = 0; i < num_lookups; i++) {
+      ASSERT_EQ(Get(std::to_string(i % kNumBlocks)),
+                std::string(kValueSize, 'a'));
+    }
+  };
+  auto get_file = [&](int* level) {
+    std::vector<LiveFileMetaData> files;
+    db_->GetLiveFilesMetaData(&files);
+    EXPECT_EQ(files.size(), 1U);
+    *level = files[0].level;
+    return "file." + std::to_string(files[0].file_number) + ".";
+  };
+
+  // Each lookup reads one data block from the cache
+  constexpr uint64_t kInterval = BlockCacheHeatmap::kSampleInterval;
+  const size_t kNumLookups = kInterval * kNumBlocks;
+  read_all(kNumLookups);
+  std::map<std::string, std::string> values;
+  ASSERT_TRUE(db_->GetMapProperty(DB::Properties::kBlockCacheHeatmap, &values));
+  ASSERT_EQ(values["sample-interval"], std::to_string(kInterval));
+  // Estimates, as the first lookups of the thread might not be recorded
+  uint64_t lookups =
+      ParseUint64(values["l0.hits"]) + ParseUint64(values["l0.misses"]);
+  ASSERT_GE(lookups + kInterval, kNumLookups);
+  ASSERT_LE(lookups, kNumLookups + kInterval);
+  ASSERT_GT(ParseUint64(values["l0.data.hits"]), 0U);
+  ASSERT_EQ(values["l1.hits"], "0");
+  int level = -1;
+  std::string file_prefix = get_file(&level);
+  ASSERT_EQ(level, 0);
+  ASSERT_EQ(values[file_prefix + "level"], "0");
+  ASSERT_GT(ParseUint64(values[file_prefix + "hits"]), 0U);
+
+  // A trivial move keeps the file and its counts, and its lookups are
+  // counted at its new level
+  const std::string l0_hits = values["l0.hits"];
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  int output_level = -1;
+  ASSERT_EQ(get_file(&output_level), file_prefix);
+  ASSERT_GT(output_level, 0);
+  read_all(kNumLookups);
+  values.clear();
+  ASSERT_TRUE(db_->GetMapProperty(DB::Properties::kBlockCacheHeatmap, &values));
+  ASSERT_EQ(values[file_prefix + "level"], std::to_string(output_level));
+  ASSERT_EQ(values["l0.hits"], l0_hits);
+  const std::string level_prefix = "l" + std::to_string(output_level) + ".";
+  ASSERT_GT(ParseUint64(values[level_prefix + "data.hits"]), 0U);
+
+  // A rewritten file is forgotten, and its output is tracked at its level
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  values.clear();
+  ASSERT_TRUE(db_->GetMapProperty(DB::Properties::kBlockCacheHeatmap, &values));
+  ASSERT_EQ(values.count(file_prefix + "level"), 0U);
+  read_all(kNumLookups);
+  const std::string old_file_prefix = file_prefix;
+  file_prefix = get_file(&output_level);
+  ASSERT_NE(file_prefix, old_file_prefix);
+  values.clear();
+  ASSERT_TRUE(db_->GetMapProperty(DB::Properties::kBlockCacheHeatmap, &values));
+  ASSERT_EQ(values[file_prefix + "level"], std::to_string(output_level));
+
+  std::string str;
+  ASSERT_TRUE(db_->GetProperty(DB::Properties::kBlockCacheHeatmap, &str));
+  ASSERT_NE(str.find(file_prefix + "level: " + std::to_string(output_level)),
+            std::string::npos);
+}
+
 class DBBlockCacheTypeTest
     : public DBBlockCacheTest,
       public secondary_cache_test_util::WithCacheTypeParam {};
@@ -4385,6 +4385,107 @@ TEST_F(DBBloomFilterTest, FixedWidthSegments) {
   EXPECT_EQ(0, TestGetAndResetTickerCount(options, NON_LAST_LEVEL_SEEK_DATA));
 }
 
+TEST_F(DBBloomFilterTest, RangeFilter) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.range_filter = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  auto seek = [&](const std::string& target, const std::string& upper) {
+    ReadOptions ro;
+    Slice upper_bound(upper);
+    ro.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ro));
+    iter->Seek(target);
+    EXPECT_OK(iter->status());
+    return iter->Valid() ? iter->key().ToString() : "(invalid)";
+  };
+  auto pop_filtered = [&]() {
+    return PopTicker(options, NON_LAST_LEVEL_SEEK_FILTERED) +
+           PopTicker(options, LAST_LEVEL_SEEK_FILTERED);
+  };
+  auto pop_data = [&]() {
+    return PopTicker(options, NON_LAST_LEVEL_SEEK_DATA) +
+           PopTicker(options, LAST_LEVEL_SEEK_DATA);
+  };
+
+  // Two files on L1
+  ASSERT_OK(Put("a1", "v"));
+  ASSERT_OK(Put("a5", "v"));
+  ASSERT_OK(Put("c1", "v"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+  ASSERT_OK(Put("d1", "v"));
+  ASSERT_OK(Put("d5", "v"));
+  ASSERT_OK(Put("f1", "v"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+  ASSERT_EQ("0,2", FilesPerLevel());
+  pop_filtered();
+  pop_data();
+
+  // Between keys of the first file
+  ASSERT_EQ(seek("b", "c0"), "(invalid)");
+  EXPECT_EQ(1, pop_filtered());
+  EXPECT_EQ(0, pop_data());
+  ASSERT_EQ(seek("a2", "a5"), "(invalid)");
+  EXPECT_EQ(1, pop_filtered());
+  EXPECT_EQ(0, pop_data());
+  // Between the files
+  ASSERT_EQ(seek("c5", "d0"), "(invalid)");
+  EXPECT_EQ(1, pop_filtered());
+  EXPECT_EQ(0, pop_data());
+
+  ASSERT_EQ(seek("b", "c2"), "c1");
+  ASSERT_EQ(seek("a2", "a6"), "a5");
+  ASSERT_EQ(seek("c2", "d2"), "d1");
+  ASSERT_EQ(seek("c1", "c1"), "(invalid)");
+  ASSERT_EQ(seek("d1", "d10"), "d1");
+  // Without an upper bound, the range filter is not used
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    iter->Seek("b");
+    ASSERT_OK(iter->status());
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), "c1");
+  }
+  EXPECT_EQ(0, pop_filtered());
+
+  // The largest key of a file can be the end of a range tombstone. The range
+  // filter must not end the scan of the level there.
+  DestroyAndReopen(options);
+  // Keeps the range tombstone from being dropped on the last level
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ASSERT_OK(Put("a1", "v"));
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "b",
+                             "d0"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+  ASSERT_OK(Put("d1", "v"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+  ASSERT_EQ("0,2", FilesPerLevel());
+  pop_filtered();
+
+  ASSERT_EQ(seek("b5", "d3"), "d1");
+  EXPECT_EQ(1, pop_filtered());
+  db_->ReleaseSnapshot(snapshot);
+
+  // Read through the block cache like other filters
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.block_cache = NewLRUCache(1 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  pop_filtered();
+  ASSERT_EQ(seek("a2", "a5"), "(invalid)");
+  EXPECT_EQ(1, pop_filtered());
+  ASSERT_EQ(seek("b5", "d3"), "d1");
+  EXPECT_EQ(1, pop_filtered());
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
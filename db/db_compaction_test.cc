@@ -10560,6 +10560,67 @@ TEST_F(DBCompactionTest, NumberOfSubcompactions) {
   }
 }
 
+TEST_F(DBCompactionTest, SubcompactionRangesPerThread) {
+  // Tests that with subcompaction_ranges_per_thread, the compaction is split
+  // into more subcompactions than threads running them.
+  class SubCompactionEventListener : public EventListener {
+   public:
+    void OnSubcompactionCompleted(const SubcompactionJobInfo&) override {
+      sub_compaction_finished_++;
+    }
+    std::atomic<int> sub_compaction_finished_{0};
+  };
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleLevel;
+  options.compression = kNoCompression;
+  options.target_file_size_base = 100 << 10;  // 100KB
+  options.level0_file_num_compaction_trigger = 2;
+  options.max_subcompactions = 2;
+  options.subcompaction_ranges_per_thread = 4;
+  SubCompactionEventListener* listener = new SubCompactionEventListener();
+  options.listeners.emplace_back(listener);
+  DestroyAndReopen(options);
+
+  port::Mutex mutex;
+  std::set<std::thread::id> thread_ids;
+  SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::ProcessKeyValueCompaction()::Processing",
+      [&](void* /*arg*/) {
+        MutexLock l(&mutex);
+        thread_ids.insert(std::this_thread::get_id());
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  // Same data as in NumberOfSubcompactions, which is enough for 8
+  // subcompactions
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int file = 0; file < 2; ++file) {
+    for (int key = file; key < 2000; key += 2) {
+      values.push_back(rnd.RandomString(500));
+      ASSERT_OK(Put(Key(key), values.back()));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  EXPECT_EQ(listener->sub_compaction_finished_, 8);
+  EXPECT_LE(thread_ids.size(), 2U);
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+  for (int file = 0, i = 0; file < 2; ++file) {
+    for (int key = file; key < 2000; key += 2) {
+      ASSERT_EQ(Get(Key(key)), values[i++]);
+    }
+  }
+
+  // Back to one thread per subcompaction
+  ASSERT_OK(
+      dbfull()->SetDBOptions({{"subcompaction_ranges_per_thread", "1"}}));
+  ASSERT_EQ(dbfull()->GetDBOptions().subcompaction_ranges_per_thread, 1U);
+}
+
 TEST_F(DBCompactionTest, VerifyInputRecordCount) {
   Options options = CurrentOptions();
   options.compaction_style = kCompactionStyleLevel;
@@ -10695,6 +10756,115 @@ TEST_F(DBCompactionTest, VerifyOutputRecordCountPlainTable) {
   ASSERT_TRUE(std::strstr(s.getState(), expect));
 }
 
+TEST_F(DBCompactionTest, ReuseDataBlocks) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  if (Snappy_Supported()) {
+    options.compression = kSnappyCompression;
+  } else if (LZ4_Supported()) {
+    options.compression = kLZ4Compression;
+  } else {
+    options.compression = kNoCompression;
+  }
+  BlockBasedTableOptions table_options;
+  table_options.reuse_data_blocks_in_compaction = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  auto put = [&](int i) {
+    std::string value = rnd.RandomString(10) + std::string(90, 'v');
+    ASSERT_OK(Put(Key(i), value));
+    expected[Key(i)] = value;
+  };
+  auto verify = [&]() {
+    for (const auto& kv : expected) {
+      ASSERT_EQ(kv.second, Get(kv.first));
+    }
+    ASSERT_OK(db_->VerifyChecksum());
+  };
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  // Not compacting again the files just compacted into the last level
+  CompactRangeOptions merge_cro;
+  merge_cro.bottommost_level_compaction =
+      BottommostLevelCompaction::kForceOptimized;
+
+  // Two overlapping files merged into the last level, where sequence numbers
+  // are zeroed, so the output blocks differ from the input ones
+  for (int i = 0; i < 2000; i += 2) {
+    put(i);
+  }
+  ASSERT_OK(Flush());
+  for (int i = 1; i < 2000; i += 2) {
+    put(i);
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(merge_cro, nullptr, nullptr));
+  ASSERT_EQ(0, TestGetTickerCount(options, COMPACTION_REUSED_DATA_BLOCKS));
+  verify();
+
+  // Rewriting the last level as is reuses all of its data blocks
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  const uint64_t all_reused =
+      TestGetTickerCount(options, COMPACTION_REUSED_DATA_BLOCKS);
+  ASSERT_GT(all_reused, 1);
+  ASSERT_GT(TestGetTickerCount(options, COMPACTION_REUSED_DATA_BYTES),
+            all_reused * 100);
+  verify();
+
+  // Only the blocks around the updated keys are rebuilt
+  ASSERT_OK(options.statistics->Reset());
+  for (int i = 1000; i < 1010; ++i) {
+    put(i);
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(merge_cro, nullptr, nullptr));
+  const uint64_t reused =
+      TestGetTickerCount(options, COMPACTION_REUSED_DATA_BLOCKS);
+  ASSERT_GT(reused, 0);
+  ASSERT_LT(reused, all_reused);
+  verify();
+
+  // The blocks with entries dropped by a compaction filter are rebuilt
+  class DropFilter : public CompactionFilter {
+   public:
+    const char* Name() const override { return "DropFilter"; }
+    bool Filter(int /*level*/, const Slice& key, const Slice& /*value*/,
+                std::string* /*new_value*/,
+                bool* /*value_changed*/) const override {
+      return key.ends_with("50");
+    }
+  };
+  DropFilter drop_filter;
+  options.compaction_filter = &drop_filter;
+  Reopen(options);
+  ASSERT_OK(options.statistics->Reset());
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  const uint64_t filtered_reused =
+      TestGetTickerCount(options, COMPACTION_REUSED_DATA_BLOCKS);
+  ASSERT_GT(filtered_reused, 0);
+  ASSERT_LT(filtered_reused, all_reused);
+  for (int i = 50; i < 2000; i += 100) {
+    ASSERT_EQ("NOT_FOUND", Get(Key(i)));
+    expected.erase(Key(i));
+  }
+  verify();
+  options.compaction_filter = nullptr;
+
+  // Not reused once disabled
+  table_options.reuse_data_blocks_in_compaction = false;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_OK(options.statistics->Reset());
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+  ASSERT_EQ(0, TestGetTickerCount(options, COMPACTION_REUSED_DATA_BLOCKS));
+  verify();
+}
+
+
 TEST_F(DBCompactionTest, ErrorWhenReadFileHead) {
   // This is to test a bug that is fixed in
   // https://github.com/facebook/rocksdb/pull/11782.
@@ -54,6 +54,7 @@
 #include "db/table_properties_collector.h"
 #include "db/transaction_log_impl.h"
 #include "db/version_set.h"
+#include "db/wide/wide_columns_helper.h"
 #include "db/write_batch_internal.h"
 #include "db/write_callback.h"
 #include "env/unique_id_gen.h"
@@ -261,6 +262,10 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       &error_handler_, read_only));
   column_family_memtables_.reset(
       new ColumnFamilyMemTablesImpl(versions_->GetColumnFamilySet()));
+  if (immutable_db_options_.point_lookup_cache) {
+    point_lookup_cache_.reset(
+        new PointLookupCache(immutable_db_options_.point_lookup_cache));
+  }
 
   DumpRocksDBBuildVersion(immutable_db_options_.info_log.get());
   DumpDBFileSummary(immutable_db_options_, dbname_, db_session_id_);
@@ -918,6 +923,29 @@ void DBImpl::PersistStats() {
   if (!statistics->getTickerMap(&stats_map)) {
     return;
   }
+  {
+    // Only the levels that have seen lookups, to keep the slices small
+    InstrumentedMutexLock l(&mutex_);
+    for (auto cfd : *versions_->GetColumnFamilySet()) {
+      if (cfd->IsDropped() || (persist_stats_cf_handle_ != nullptr &&
+                               cfd == persist_stats_cf_handle_->cfd())) {
+        continue;
+      }
+      BlockCacheHeatmap* heatmap =
+          cfd->internal_stats()->GetBlockCacheHeatmap();
+      for (int level = 0; level < heatmap->num_levels(); ++level) {
+        BlockCacheHeatmap::Counts counts = heatmap->GetLevelCounts(level);
+        if (counts.hits + counts.misses == 0) {
+          continue;
+        }
+        const std::string prefix = "rocksdb.block.cache.heatmap." +
+                                   cfd->GetName() + ".l" +
+                                   std::to_string(level) + ".";
+        stats_map[prefix + "hits"] = counts.hits;
+        stats_map[prefix + "misses"] = counts.misses;
+      }
+    }
+  }
   ROCKS_LOG_INFO(immutable_db_options_.info_log,
                  "------- PERSISTING STATS -------");
 
@@ -2366,6 +2394,28 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
     }
   }
 
+  // Only reads of the latest value whose result depends on nothing but the
+  // user key go through the point lookup cache.
+  const bool use_point_lookup_cache =
+      point_lookup_cache_ != nullptr && get_impl_options.get_value &&
+      get_impl_options.value != nullptr &&
+      get_impl_options.columns == nullptr &&
+      get_impl_options.timestamp == nullptr &&
+      get_impl_options.value_found == nullptr &&
+      get_impl_options.callback == nullptr &&
+      get_impl_options.is_blob_index == nullptr &&
+      read_options.snapshot == nullptr && read_options.timestamp == nullptr &&
+      read_options.read_tier == kReadAllTier &&
+      !read_options.ignore_range_deletions &&
+      !read_options.merge_operand_count_threshold.has_value() &&
+      cfd->ioptions().compaction_filter == nullptr &&
+      cfd->ioptions().compaction_filter_factory == nullptr &&
+      cfd->ioptions().compaction_style != kCompactionStyleFIFO &&
+      cfd->user_comparator()->timestamp_size() == 0;
+  // Captured before reading anything, see PointLookupCache
+  const uint64_t point_lookup_generation =
+      use_point_lookup_cache ? point_lookup_cache_->GetGeneration() : 0;
+
   // Acquire SuperVersion
   SuperVersion* sv = GetAndRefSuperVersion(cfd);
   if (read_options.timestamp && read_options.timestamp->size() > 0) {
@@ -2431,6 +2481,24 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
   TEST_SYNC_POINT("DBImpl::GetImpl:3");
   TEST_SYNC_POINT("DBImpl::GetImpl:4");
 
+  if (use_point_lookup_cache) {
+    bool found = false;
+    if (point_lookup_cache_->Lookup(cfd->GetID(), key, snapshot,
+                                    get_impl_options.value, &found, stats_)) {
+      PERF_TIMER_STOP(get_snapshot_time);
+      ReturnAndCleanupSuperVersion(cfd, sv);
+      RecordTick(stats_, NUMBER_KEYS_READ);
+      if (!found) {
+        return Status::NotFound();
+      }
+      const size_t size = get_impl_options.value->size();
+      RecordTick(stats_, BYTES_READ, size);
+      PERF_COUNTER_ADD(get_read_bytes, size);
+      RecordInHistogram(stats_, BYTES_PER_READ, size);
+      return Status::OK();
+    }
+  }
+
   // Prepare to store a list of merge operations if merge occurs.
   MergeContext merge_context;
   merge_context.get_merge_operands_options =
@@ -2541,6 +2609,15 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
         if (get_impl_options.value) {
           size = get_impl_options.value->size();
         } else if (get_impl_options.columns) {
+          if (read_options.column_projection) {
+            // Covers the results of lookups that are not projected at the
+            // source, e.g. merges in the memtable
+            Status project_s = WideColumnsHelper::ProjectColumns(
+                *read_options.column_projection, *get_impl_options.columns);
+            if (!project_s.ok()) {
+              s = project_s;
+            }
+          }
           size = get_impl_options.columns->serialized_size();
         }
       } else {
@@ -2614,6 +2691,11 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
       PERF_COUNTER_ADD(get_read_bytes, size);
     }
 
+    if (use_point_lookup_cache && (s.ok() || s.IsNotFound())) {
+      point_lookup_cache_->Insert(cfd->GetID(), key, point_lookup_generation,
+                                  snapshot, s.ok(), *get_impl_options.value);
+    }
+
     ReturnAndCleanupSuperVersion(cfd, sv);
 
     RecordInHistogram(stats_, BYTES_PER_READ, size);
@@ -3271,6 +3353,14 @@ Status DBImpl::MultiGetImpl(
         bytes_read += key->value->size();
       } else {
         assert(key->columns);
+        if (read_options.column_projection) {
+          // See GetImpl()
+          Status project_s = WideColumnsHelper::ProjectColumns(
+              *read_options.column_projection, *key->columns);
+          if (!project_s.ok()) {
+            *(key->s) = project_s;
+          }
+        }
         bytes_read += key->columns->serialized_size();
       }
 
@@ -4838,6 +4928,91 @@ Status DBImpl::GetApproximateSizes(const SizeApproximationOptions& options,
   return Status::OK();
 }
 
+Status DBImpl::GetScanPartitionBoundaries(
+    const ReadOptions& read_options, ColumnFamilyHandle* column_family,
+    const OptSlice& begin, const OptSlice& end, size_t num_partitions,
+    std::vector<std::string>* boundaries) {
+  if (boundaries == nullptr || num_partitions == 0) {
+    return Status::InvalidArgument("Invalid number of partitions");
+  }
+  boundaries->clear();
+  auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(column_family);
+  ColumnFamilyData* cfd = cfh->cfd();
+  const Comparator* const ucmp = cfd->user_comparator();
+  if (ucmp->timestamp_size() > 0) {
+    return Status::NotSupported(
+        "Scan partitions are not supported with user-defined timestamps");
+  }
+  if (num_partitions == 1) {
+    return Status::OK();
+  }
+  auto in_range = [&](const Slice& user_key) {
+    return (!begin || ucmp->Compare(user_key, *begin) > 0) &&
+           (!end || ucmp->Compare(user_key, *end) < 0);
+  };
+
+  // Same approach as the subcompaction boundaries (see
+  // CompactionJob::GenSubcompactionBoundaries()): each file is split into
+  // ranges of known size at key anchors read from its index, and the anchors
+  // of all files are merged in key order.
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  VersionStorageInfo* vstorage = sv->current->storage_info();
+  Status s;
+  std::vector<TableReader::Anchor> anchors;
+  uint64_t total_size = 0;
+  for (int level = 0; level < vstorage->num_levels() && s.ok(); ++level) {
+    for (FileMetaData* f : vstorage->LevelFiles(level)) {
+      if ((end && ucmp->Compare(f->smallest.user_key(), *end) >= 0) ||
+          (begin && ucmp->Compare(f->largest.user_key(), *begin) < 0)) {
+        continue;
+      }
+      std::vector<TableReader::Anchor> file_anchors;
+      s = cfd->table_cache()->ApproximateKeyAnchors(
+          read_options, cfd->internal_comparator(), *f,
+          sv->mutable_cf_options, file_anchors);
+      if (s.IsNotSupported() || (s.ok() && file_anchors.empty())) {
+        s = Status::OK();
+        file_anchors.emplace_back(f->largest.user_key(), f->fd.GetFileSize());
+      }
+      if (!s.ok()) {
+        break;
+      }
+      for (auto& anchor : file_anchors) {
+        // Anchors outside of the range cannot be boundaries, and the size of
+        // the data they close is mostly outside of it too.
+        if (in_range(anchor.user_key)) {
+          total_size += anchor.range_size;
+          anchors.push_back(std::move(anchor));
+        }
+      }
+    }
+  }
+  ReturnAndCleanupSuperVersion(cfd, sv);
+  if (!s.ok()) {
+    return s;
+  }
+
+  std::sort(anchors.begin(), anchors.end(),
+            [ucmp](const TableReader::Anchor& a, const TableReader::Anchor& b) {
+              return ucmp->Compare(a.user_key, b.user_key) < 0;
+            });
+  // Each partition ends after about its share of the total size. The last
+  // anchor is not used, as it would leave the last partition (nearly) empty.
+  const uint64_t target_size = total_size / num_partitions;
+  uint64_t accumulated_size = 0;
+  for (size_t i = 0; i + 1 < anchors.size() &&
+                     boundaries->size() + 1 < num_partitions;
+       ++i) {
+    accumulated_size += anchors[i].range_size;
+    if (accumulated_size >= target_size * (boundaries->size() + 1) &&
+        (boundaries->empty() ||
+         ucmp->Compare(anchors[i].user_key, boundaries->back()) > 0)) {
+      boundaries->push_back(anchors[i].user_key);
+    }
+  }
+  return Status::OK();
+}
+
 std::list<uint64_t>::iterator
 DBImpl::CaptureCurrentFileNumberInPendingOutputs() {
   // We need to remember the iterator of our insert, because after the
@@ -4896,6 +5071,8 @@ Status DBImpl::DeleteFilesInRanges(ColumnFamilyHandle* column_family,
   // TODO: plumb Env::IOActivity, Env::IOPriority
   const ReadOptions read_options;
   const WriteOptions write_options;
+  PointLookupCache::ScopedInvalidation point_lookup_invalidation(
+      point_lookup_cache_.get());
 
   Status status = Status::OK();
   auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(column_family);
@@ -5805,6 +5982,8 @@ Status DBImpl::IngestExternalFiles(
   if (args.empty()) {
     return Status::InvalidArgument("ingestion arg list is empty");
   }
+  PointLookupCache::ScopedInvalidation point_lookup_invalidation(
+      point_lookup_cache_.get());
   {
     std::unordered_set<ColumnFamilyHandle*> unique_cfhs;
     for (const auto& arg : args) {
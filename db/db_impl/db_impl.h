@@ -35,6 +35,7 @@
 #include "db/logs_with_prep_tracker.h"
 #include "db/memtable_list.h"
 #include "db/periodic_task_scheduler.h"
+#include "db/point_lookup_cache.h"
 #include "db/post_memtable_callback.h"
 #include "db/pre_release_callback.h"
 #include "db/range_del_aggregator.h"
@@ -424,6 +425,11 @@ class DBImpl : public DB {
   using DB::GetAggregatedIntProperty;
   bool GetAggregatedIntProperty(const Slice& property,
                                 uint64_t* aggregated_value) override;
+  Status GetScanPartitionBoundaries(
+      const ReadOptions& read_options, ColumnFamilyHandle* column_family,
+      const OptSlice& begin, const OptSlice& end, size_t num_partitions,
+      std::vector<std::string>* boundaries) override;
+
   using DB::GetApproximateSizes;
   Status GetApproximateSizes(const SizeApproximationOptions& options,
                              ColumnFamilyHandle* column_family,
@@ -1097,6 +1103,11 @@ class DBImpl : public DB {
 
   InstrumentedMutex* mutex() const { return &mutex_; }
 
+  // Null unless DBOptions::point_lookup_cache is set
+  PointLookupCache* point_lookup_cache() const {
+    return point_lookup_cache_.get();
+  }
+
   // Initialize a brand new DB. The DB directory is expected to be empty before
   // calling it. Push new manifest file name into `new_filenames`.
   Status NewDB(std::vector<std::string>* new_filenames);
@@ -1413,6 +1424,9 @@ class DBImpl : public DB {
 
   std::unique_ptr<ColumnFamilyMemTablesImpl> column_family_memtables_;
 
+  // See DBOptions::point_lookup_cache. Kept coherent by the write path.
+  std::unique_ptr<PointLookupCache> point_lookup_cache_;
+
   // Increase the sequence number after writing each batch, whether memtable is
   // disabled for that or not. Otherwise the sequence number is increased after
   // writing each key into memtable. This implies that when disable_memtable is
@@ -2335,18 +2349,24 @@ class DBImpl : public DB {
                          WalContext* log_context, WriteContext* write_context);
 
   // Merge write batches in the write group into merged_batch.
+  // If no batch in the group is to be truncated at its WAL termination point,
+  // merged_batch is only the header of the merged batch, and the batches
+  // whose contents follow it are added to gathered_batches instead of being
+  // copied.
   // Returns OK if merge is successful.
   // Returns Corruption if corruption in write batch is detected.
   Status MergeBatch(const WriteThread::WriteGroup& write_group,
                     WriteBatch* tmp_batch, WriteBatch** merged_batch,
-                    size_t* write_with_wal, WriteBatch** to_be_cached_state);
-
-  IOStatus WriteToWAL(const WriteBatch& merged_batch,
-                      const WriteOptions& write_options,
-                      log::Writer* log_writer, uint64_t* wal_used,
-                      uint64_t* log_size,
-                      WalFileNumberSize& wal_file_number_size,
-                      SequenceNumber sequence);
+                    size_t* write_with_wal, WriteBatch** to_be_cached_state,
+                    autovector<const WriteBatch*>* gathered_batches);
+
+  // Writes merged_batch followed by the contents (without header) of
+  // gathered_batches, if any, to the WAL as one record.
+  IOStatus WriteToWAL(
+      const WriteBatch& merged_batch, const WriteOptions& write_options,
+      log::Writer* log_writer, uint64_t* wal_used, uint64_t* log_size,
+      WalFileNumberSize& wal_file_number_size, SequenceNumber sequence,
+      const autovector<const WriteBatch*>* gathered_batches = nullptr);
 
   IOStatus WriteGroupToWAL(const WriteThread::WriteGroup& write_group,
                            log::Writer* log_writer, uint64_t* wal_used,
@@ -273,6 +273,13 @@ Status DBImpl::ValidateOptions(const DBOptions& db_options) {
         "unordered_write is incompatible with enable_pipelined_write");
   }
 
+  if (db_options.point_lookup_cache &&
+      (db_options.unordered_write || db_options.two_write_queues)) {
+    return Status::InvalidArgument(
+        "point_lookup_cache is incompatible with unordered_write and "
+        "two_write_queues");
+  }
+
   if (db_options.atomic_flush && db_options.enable_pipelined_write) {
     return Status::InvalidArgument(
         "atomic_flush is incompatible with enable_pipelined_write");
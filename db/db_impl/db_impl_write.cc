@@ -226,6 +226,10 @@ Status DBImpl::IngestWBWIAsMemtable(
   assert(assigned_seqno.upper_bound <= last_seqno_after_ingest);
   // Keys in the current memtable have seqno <= LastSequence() < keys in wbwi.
   assert(assigned_seqno.lower_bound > versions_->LastSequence());
+  if (point_lookup_cache_) {
+    // The keys are not visible until the caller publishes the sequence numbers
+    point_lookup_cache_->InvalidateAll(assigned_seqno.upper_bound);
+  }
   autovector<ReadOnlyMemTable*> memtables;
   autovector<ColumnFamilyData*> cfds;
   InstrumentedMutexLock lock(&mutex_);
@@ -1607,10 +1611,12 @@ Status DBImpl::PreprocessWrite(const WriteOptions& write_options,
 Status DBImpl::MergeBatch(const WriteThread::WriteGroup& write_group,
                           WriteBatch* tmp_batch, WriteBatch** merged_batch,
                           size_t* write_with_wal,
-                          WriteBatch** to_be_cached_state) {
+                          WriteBatch** to_be_cached_state,
+                          autovector<const WriteBatch*>* gathered_batches) {
   assert(write_with_wal != nullptr);
   assert(tmp_batch != nullptr);
   assert(*to_be_cached_state == nullptr);
+  assert(gathered_batches != nullptr && gathered_batches->empty());
   *write_with_wal = 0;
   auto* leader = write_group.leader;
   assert(!leader->disable_wal);  // Same holds for all in the batch group
@@ -1625,10 +1631,35 @@ Status DBImpl::MergeBatch(const WriteThread::WriteGroup& write_group,
     }
     *write_with_wal = 1;
   } else {
-    // WAL needs all of the batches flattened into a single batch.
-    // We could avoid copying here with an iov-like AddRecord
-    // interface
+    // WAL needs all of the batches flattened into a single batch. Unless a
+    // batch has to be truncated at its WAL termination point, we only build
+    // the merged header here and let WriteToWAL() gather the batch contents
+    // into the WAL record without copying them.
     *merged_batch = tmp_batch;
+    bool can_gather = true;
+    for (auto writer : write_group) {
+      if (!writer->CallbackFailed() &&
+          !writer->batch->GetWalTerminationPoint().is_cleared()) {
+        can_gather = false;
+        break;
+      }
+    }
+    if (can_gather) {
+      for (auto writer : write_group) {
+        if (!writer->CallbackFailed()) {
+          WriteBatchInternal::SetCount(
+              tmp_batch, WriteBatchInternal::Count(tmp_batch) +
+                             WriteBatchInternal::Count(writer->batch));
+          gathered_batches->push_back(writer->batch);
+          if (WriteBatchInternal::IsLatestPersistentState(writer->batch)) {
+            // We only need to cache the last of such write batch
+            *to_be_cached_state = writer->batch;
+          }
+          (*write_with_wal)++;
+        }
+      }
+      return Status::OK();
+    }
     for (auto writer : write_group) {
       if (!writer->CallbackFailed()) {
         Status s = WriteBatchInternal::Append(*merged_batch, writer->batch,
@@ -1656,7 +1687,9 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
                             log::Writer* log_writer, uint64_t* wal_used,
                             uint64_t* log_size,
                             WalFileNumberSize& wal_file_number_size,
-                            SequenceNumber sequence) {
+                            SequenceNumber sequence,
+                            const autovector<const WriteBatch*>*
+                                gathered_batches) {
   assert(log_size != nullptr);
 
   Slice log_entry = WriteBatchInternal::Contents(&merged_batch);
@@ -1666,6 +1699,35 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
     return status_to_io_status(std::move(s));
   }
   *log_size = log_entry.size();
+  // Values added with PutReferenced() and the contents of gathered batches
+  // are written straight from their buffers.
+  std::vector<Slice> log_entry_parts;
+  const bool gathered =
+      gathered_batches != nullptr && !gathered_batches->empty();
+  if (UNLIKELY(gathered ||
+               WriteBatchInternal::HasReferencedValues(&merged_batch))) {
+    size_t resolved_size = 0;
+    s = WriteBatchInternal::AppendResolvedContents(
+        &merged_batch, false /* skip_header */, &log_entry_parts,
+        &resolved_size);
+    if (s.ok() && gathered) {
+      for (const WriteBatch* batch : *gathered_batches) {
+        s = batch->VerifyChecksum();
+        if (!s.ok()) {
+          break;
+        }
+        s = WriteBatchInternal::AppendResolvedContents(
+            batch, true /* skip_header */, &log_entry_parts, &resolved_size);
+        if (!s.ok()) {
+          break;
+        }
+      }
+    }
+    if (!s.ok()) {
+      return status_to_io_status(std::move(s));
+    }
+    *log_size = resolved_size;
+  }
   // When two_write_queues_ WriteToWAL has to be protected from concurretn calls
   // from the two queues anyway and wal_write_mutex_ is already held. Otherwise
   // if manual_wal_flush_ is enabled we need to protect log_writer->AddRecord
@@ -1682,7 +1744,15 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
   if (!io_s.ok()) {
     return io_s;
   }
-  io_s = log_writer->AddRecord(write_options, log_entry, sequence);
+  if (log_entry_parts.empty()) {
+    io_s = log_writer->AddRecord(write_options, log_entry, sequence);
+  } else {
+    io_s = log_writer->AddRecord(
+        write_options,
+        SliceParts(log_entry_parts.data(),
+                   static_cast<int>(log_entry_parts.size())),
+        sequence);
+  }
 
   if (UNLIKELY(needs_locking)) {
     wal_write_mutex_.Unlock();
@@ -1691,7 +1761,7 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
     *wal_used = cur_wal_number_;
     assert(*wal_used == wal_file_number_size.number);
   }
-  wals_total_size_.FetchAddRelaxed(log_entry.size());
+  wals_total_size_.FetchAddRelaxed(*log_size);
   wal_file_number_size.AddSize(*log_size);
   wal_empty_ = false;
 
@@ -1710,8 +1780,10 @@ IOStatus DBImpl::WriteGroupToWAL(const WriteThread::WriteGroup& write_group,
   size_t write_with_wal = 0;
   WriteBatch* to_be_cached_state = nullptr;
   WriteBatch* merged_batch;
+  autovector<const WriteBatch*> gathered_batches;
   io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch_, &merged_batch,
-                                        &write_with_wal, &to_be_cached_state));
+                                        &write_with_wal, &to_be_cached_state,
+                                        &gathered_batches));
   if (UNLIKELY(!io_s.ok())) {
     return io_s;
   }
@@ -1733,7 +1805,8 @@ IOStatus DBImpl::WriteGroupToWAL(const WriteThread::WriteGroup& write_group,
   write_options.rate_limiter_priority =
       write_group.leader->rate_limiter_priority;
   io_s = WriteToWAL(*merged_batch, write_options, log_writer, wal_used,
-                    &log_size, wal_file_number_size, sequence);
+                    &log_size, wal_file_number_size, sequence,
+                    &gathered_batches);
   if (to_be_cached_state) {
     cached_recoverable_state_ = *to_be_cached_state;
     cached_recoverable_state_empty_ = false;
@@ -1827,8 +1900,10 @@ IOStatus DBImpl::ConcurrentWriteGroupToWAL(
   size_t write_with_wal = 0;
   WriteBatch* to_be_cached_state = nullptr;
   WriteBatch* merged_batch;
+  autovector<const WriteBatch*> gathered_batches;
   io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch, &merged_batch,
-                                        &write_with_wal, &to_be_cached_state));
+                                        &write_with_wal, &to_be_cached_state,
+                                        &gathered_batches));
   if (UNLIKELY(!io_s.ok())) {
     return io_s;
   }
@@ -1859,7 +1934,8 @@ IOStatus DBImpl::ConcurrentWriteGroupToWAL(
   write_options.rate_limiter_priority =
       write_group.leader->rate_limiter_priority;
   io_s = WriteToWAL(*merged_batch, write_options, log_writer, wal_used,
-                    &log_size, wal_file_number_size, sequence);
+                    &log_size, wal_file_number_size, sequence,
+                    &gathered_batches);
   if (to_be_cached_state) {
     cached_recoverable_state_ = *to_be_cached_state;
     cached_recoverable_state_empty_ = false;
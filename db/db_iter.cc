@@ -65,6 +65,8 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
       timestamp_ub_(read_options.timestamp),
       timestamp_lb_(read_options.iter_start_ts),
       timestamp_size_(timestamp_ub_ ? timestamp_ub_->size() : 0),
+      column_projection_(read_options.column_projection),
+      scan_predicate_(read_options.scan_predicate),
       active_mem_(active_mem),
       memtable_seqno_lb_(kMaxSequenceNumber),
       memtable_op_scan_flush_trigger_(0),
@@ -74,6 +76,7 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
       direction_(kForward),
       valid_(false),
       current_entry_is_merged_(false),
+      matches_scan_predicate_(true),
       is_key_seqnum_zero_(false),
       prefix_same_as_start_(
           prefix_extractor_ ? read_options.prefix_same_as_start : false),
@@ -82,7 +85,9 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
                                      read_options.total_order_seek ||
                                      read_options.auto_prefix_mode),
       expose_blob_index_(expose_blob_index),
-      allow_unprepared_value_(read_options.allow_unprepared_value),
+      // scan_predicate_ needs the values to be loaded
+      allow_unprepared_value_(read_options.allow_unprepared_value &&
+                              read_options.scan_predicate == nullptr),
       is_blob_(false),
       arena_mode_(arena_mode) {
   RecordTick(statistics_, NO_ITERATOR_CREATED);
@@ -166,11 +171,59 @@ bool DBIter::ParseKey(ParsedInternalKey* ikey) {
 }
 
 void DBIter::Next() {
+  PERF_CPU_TIMER_GUARD(iter_next_cpu_nanos, clock_);
+  NextImpl();
+}
+
+size_t DBIter::NextBatch(size_t max_entries, size_t max_bytes, Slice* keys,
+                         Slice* values, std::string* buf) {
+  assert(buf);
+  buf->clear();
+  PERF_CPU_TIMER_GUARD(iter_next_cpu_nanos, clock_);
+  size_t num_entries = 0;
+  size_t num_bytes = 0;
+  // Entries whose data does not outlive the next step are copied into `buf`,
+  // and marked with a null data pointer until `buf` stops moving.
+  while (num_entries < max_entries &&
+         (num_entries == 0 || num_bytes < max_bytes) && valid_ &&
+         PrepareValue()) {
+    const Slice key_slice = key();
+    if (pin_thru_lifetime_ && saved_key_.IsKeyPinned()) {
+      keys[num_entries] = key_slice;
+    } else {
+      buf->append(key_slice.data(), key_slice.size());
+      keys[num_entries] = Slice(nullptr, key_slice.size());
+    }
+    if (pin_thru_lifetime_ && iter_.Valid() && iter_.iter()->IsValuePinned() &&
+        iter_.value().data() == value_.data()) {
+      values[num_entries] = value_;
+    } else {
+      buf->append(value_.data(), value_.size());
+      values[num_entries] = Slice(nullptr, value_.size());
+    }
+    num_bytes += key_slice.size() + value_.size();
+    ++num_entries;
+    NextImpl();
+  }
+  const char* pos = buf->data();
+  for (size_t i = 0; i < num_entries; ++i) {
+    if (keys[i].data() == nullptr) {
+      keys[i] = Slice(pos, keys[i].size());
+      pos += keys[i].size();
+    }
+    if (values[i].data() == nullptr) {
+      values[i] = Slice(pos, values[i].size());
+      pos += values[i].size();
+    }
+  }
+  return num_entries;
+}
+
+void DBIter::NextImpl() {
   assert(valid_);
   assert(status_.ok());
 
   PERF_COUNTER_ADD(iter_next_count, 1);
-  PERF_CPU_TIMER_GUARD(iter_next_cpu_nanos, clock_);
   // Release temporarily pinned blocks from last operation
   ReleaseTempPinnedData();
   ResetBlobData();
@@ -268,6 +321,8 @@ bool DBIter::SetValueAndColumnsFromBlob(const Slice& user_key,
 
   if (expose_blob_index_) {
     SetValueAndColumnsFromPlain(blob_index);
+    // The value itself is not known here
+    matches_scan_predicate_ = true;
     return true;
   }
 
@@ -288,7 +343,25 @@ bool DBIter::SetValueAndColumnsFromEntity(Slice slice) {
   assert(value_.empty());
   assert(wide_columns_.empty());
 
-  const Status s = WideColumnSerialization::Deserialize(slice, wide_columns_);
+  const Slice entity = slice;
+  Status s = column_projection_
+                 ? WideColumnSerialization::Deserialize(
+                       slice, *column_projection_, wide_columns_)
+                 : WideColumnSerialization::Deserialize(slice, wide_columns_);
+
+  if (s.ok() && column_projection_ &&
+      !WideColumnsHelper::IsProjected(*column_projection_,
+                                      kDefaultWideColumnName)) {
+    // value() is not subject to the projection
+    static const std::vector<Slice> kDefaultColumnOnly{kDefaultWideColumnName};
+    Slice input = entity;
+    WideColumns default_column;
+    s = WideColumnSerialization::Deserialize(input, kDefaultColumnOnly,
+                                             default_column);
+    if (s.ok() && !default_column.empty()) {
+      value_ = default_column.front().value();
+    }
+  }
 
   if (!s.ok()) {
     status_ = s;
@@ -301,6 +374,14 @@ bool DBIter::SetValueAndColumnsFromEntity(Slice slice) {
     value_ = WideColumnsHelper::GetDefaultColumn(wide_columns_);
   }
 
+  if (scan_predicate_) {
+    s = WideColumnsHelper::EntityMatches(*scan_predicate_, entity,
+                                         &matches_scan_predicate_);
+    // The entity was just deserialized successfully
+    assert(s.ok());
+    s.PermitUncheckedError();
+  }
+
   return true;
 }
 
@@ -362,7 +443,28 @@ bool DBIter::PrepareValue() {
 // more entry for the prefix can be found.
 bool DBIter::FindNextUserEntry(bool skipping_saved_key, const Slice* prefix) {
   PERF_TIMER_GUARD(find_next_user_entry_time);
-  return FindNextUserEntryInternal(skipping_saved_key, prefix);
+  bool ok = FindNextUserEntryInternal(skipping_saved_key, prefix);
+  // Keys whose value does not satisfy ReadOptions::scan_predicate are skipped
+  // like deleted ones.
+  while (ok && valid_ && !matches_scan_predicate_) {
+    ReleaseTempPinnedData();
+    ResetBlobData();
+    ResetValueAndColumns();
+    if (!current_entry_is_merged_) {
+      // iter_ is still on the current key
+      iter_.Next();
+      PERF_COUNTER_ADD(internal_key_skipped_count, 1);
+    }
+    if (!iter_.Valid()) {
+      is_key_seqnum_zero_ = false;
+      valid_ = false;
+      return iter_.status().ok();
+    }
+    ClearSavedValue();
+    ok = FindNextUserEntryInternal(true /* skipping the current user key */,
+                                   prefix);
+  }
+  return ok;
 }
 
 // Actual implementation of DBIter::FindNextUserEntry()
@@ -903,8 +1005,15 @@ void DBIter::PrevInternal(const Slice* prefix) {
     }
 
     if (valid_) {
-      // Found the value.
-      return;
+      if (matches_scan_predicate_) {
+        // Found the value.
+        return;
+      }
+      // Skip it like a deleted key, see ReadOptions::scan_predicate
+      valid_ = false;
+      ReleaseTempPinnedData();
+      ResetBlobData();
+      ResetValueAndColumns();
     }
 
     if (TooManyInternalKeysSkipped(false)) {
@@ -12,6 +12,7 @@
 #include <string>
 
 #include "db/db_impl/db_impl.h"
+#include "db/wide/wide_columns_helper.h"
 #include "memory/arena.h"
 #include "options/cf_options.h"
 #include "rocksdb/db.h"
@@ -221,6 +222,8 @@ class DBIter final : public Iterator {
   Status GetProperty(std::string prop_name, std::string* prop) override;
 
   void Next() final override;
+  size_t NextBatch(size_t max_entries, size_t max_bytes, Slice* keys,
+                   Slice* values, std::string* buf) final override;
   void Prev() final override;
   // 'target' does not contain timestamp, even if user timestamp feature is
   // enabled.
@@ -291,6 +294,8 @@ class DBIter final : public Iterator {
   // in this case callers would usually stop what they were doing and return.
   bool ReverseToForward();
   bool ReverseToBackward();
+  // Next() without the CPU timer, so that NextBatch() times a batch once.
+  void NextImpl();
   // Set saved_key_ to the seek key to target, with proper sequence number set.
   // It might get adjusted if the seek key is smaller than iterator lower bound.
   // target does not have timestamp.
@@ -370,7 +375,14 @@ class DBIter final : public Iterator {
     assert(wide_columns_.empty());
 
     value_ = slice;
-    wide_columns_.emplace_back(kDefaultWideColumnName, slice);
+    matches_scan_predicate_ =
+        !scan_predicate_ ||
+        WideColumnsHelper::PlainValueMatches(*scan_predicate_, slice);
+    if (!column_projection_ ||
+        WideColumnsHelper::IsProjected(*column_projection_,
+                                       kDefaultWideColumnName)) {
+      wide_columns_.emplace_back(kDefaultWideColumnName, slice);
+    }
   }
 
   bool SetValueAndColumnsFromBlobImpl(const Slice& user_key,
@@ -386,6 +398,7 @@ class DBIter final : public Iterator {
   void ResetValueAndColumns() {
     value_.clear();
     wide_columns_.clear();
+    matches_scan_predicate_ = true;
   }
 
   void ResetBlobData() {
@@ -504,6 +517,10 @@ class DBIter final : public Iterator {
   const Slice* const timestamp_ub_;
   const Slice* const timestamp_lb_;
   const size_t timestamp_size_;
+  // See ReadOptions::column_projection
+  const std::vector<Slice>* const column_projection_;
+  // See ReadOptions::scan_predicate
+  const ScanPredicate* const scan_predicate_;
   std::string saved_timestamp_;
   std::optional<std::vector<ScanOptions>> scan_opts_;
   ReadOnlyMemTable* const active_mem_;
@@ -515,6 +532,8 @@ class DBIter final : public Iterator {
   Direction direction_;
   bool valid_;
   bool current_entry_is_merged_;
+  // Whether the current value satisfies scan_predicate_, if any
+  bool matches_scan_predicate_;
   // True if we know that the current entry's seqnum is 0.
   // This information is used as that the next entry will be for another
   // user key.
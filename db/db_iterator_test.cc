@@ -15,6 +15,7 @@
 #include "port/port.h"
 #include "port/stack_trace.h"
 #include "rocksdb/iostats_context.h"
+#include "rocksdb/partitioned_scan.h"
 #include "rocksdb/perf_context.h"
 #include "table/block_based/flush_block_policy_impl.h"
 #include "util/random.h"
@@ -3338,6 +3339,325 @@ TEST_P(DBIteratorTest, Blob) {
   ASSERT_EQ(IterStatus(iter), "b->vb3");
 }
 
+TEST_P(DBIteratorTest, ScanPredicate) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.no_block_cache = true;
+  table_options.flush_block_policy_factory =
+      std::make_shared<FlushBlockEveryKeyPolicyFactory>();
+  table_options.data_block_column_stats = {"attr"};
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  auto key = [](int i) {
+    char buf[8];
+    snprintf(buf, sizeof(buf), "k%02d", i);
+    return std::string(buf);
+  };
+  auto attr = [](int i) {
+    char buf[8];
+    snprintf(buf, sizeof(buf), "a%02d", i);
+    return std::string(buf);
+  };
+  auto put_entity = [&](int i, const std::string& value) {
+    ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                             key(i), {{"attr", value}, {"other", "x"}}));
+  };
+
+  for (int i = 0; i < 20; ++i) {
+    if (i == 5) {
+      // Plain values have no "attr" column and never match
+      ASSERT_OK(Put(key(i), attr(i)));
+    } else {
+      put_entity(i, attr(i));
+    }
+  }
+  ASSERT_OK(Flush());
+  // Moves everything to the last level, zeroing the sequence numbers
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+
+  // Newer versions in the memtable take precedence over the table contents
+  put_entity(2, attr(11));
+  put_entity(13, attr(50));
+  ASSERT_OK(Delete(key(12)));
+
+  const std::string lower = attr(10);
+  const std::string upper = attr(15);
+  ScanPredicate predicate("attr", lower, upper);
+  ReadOptions ro;
+  ro.scan_predicate = &predicate;
+
+  SetPerfLevel(kEnableCount);
+  get_perf_context()->Reset();
+  {
+    std::unique_ptr<Iterator> iter(NewIterator(ro));
+    std::vector<std::string> keys;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      keys.push_back(iter->key().ToString());
+      ASSERT_EQ(iter->columns().size(), 2);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(keys, (std::vector<std::string>{"k02", "k10", "k11", "k14"}));
+    // Blocks whose "attr" is out of range are not read
+    ASSERT_LT(get_perf_context()->block_read_count, 10);
+
+    keys.clear();
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      keys.push_back(iter->key().ToString());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(keys, (std::vector<std::string>{"k14", "k11", "k10", "k02"}));
+
+    iter->Seek(key(3));
+    ASSERT_EQ(IterStatus(iter.get()), "k10->");
+    iter->Seek(key(12));
+    ASSERT_EQ(IterStatus(iter.get()), "k14->");
+    iter->SeekForPrev(key(13));
+    ASSERT_EQ(IterStatus(iter.get()), "k11->");
+    iter->Prev();
+    ASSERT_EQ(IterStatus(iter.get()), "k10->");
+    iter->Next();
+    ASSERT_EQ(IterStatus(iter.get()), "k11->");
+  }
+
+  {
+    const std::string upper_key = key(11);
+    Slice upper_bound(upper_key);
+    ro.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<Iterator> iter(NewIterator(ro));
+    iter->Seek(key(3));
+    ASSERT_EQ(IterStatus(iter.get()), "k10->");
+    iter->Next();
+    ASSERT_EQ(IterStatus(iter.get()), "(invalid)");
+    ASSERT_OK(iter->status());
+    ro.iterate_upper_bound = nullptr;
+  }
+
+  {
+    // No table entry satisfies the predicate, so the data blocks of the file
+    // are never read.
+    ScanPredicate no_match("attr", "z", OptSlice());
+    ro.scan_predicate = &no_match;
+    get_perf_context()->Reset();
+    std::unique_ptr<Iterator> iter(NewIterator(ro));
+    iter->SeekToFirst();
+    ASSERT_EQ(IterStatus(iter.get()), "(invalid)");
+    ASSERT_OK(iter->status());
+    iter->SeekToLast();
+    ASSERT_EQ(IterStatus(iter.get()), "(invalid)");
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(get_perf_context()->block_read_count, 0);
+  }
+
+  {
+    // Matches the plain value through the default column
+    const std::string default_lower = attr(5);
+    const std::string default_upper = attr(6);
+    ScanPredicate default_column(kDefaultWideColumnName, default_lower,
+                                 default_upper);
+    ro.scan_predicate = &default_column;
+    std::unique_ptr<Iterator> iter(NewIterator(ro));
+    iter->SeekToFirst();
+    ASSERT_EQ(IterStatus(iter.get()), "k05->a05");
+    iter->Next();
+    ASSERT_EQ(IterStatus(iter.get()), "(invalid)");
+    ASSERT_OK(iter->status());
+  }
+  SetPerfLevel(kDisable);
+}
+
+TEST_P(DBIteratorTest, NextBatch) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  auto key = [](int i) {
+    char buf[8];
+    snprintf(buf, sizeof(buf), "k%02d", i);
+    return std::string(buf);
+  };
+  std::vector<std::pair<std::string, std::string>> expected;
+  for (int i = 0; i < 30; ++i) {
+    ASSERT_OK(Put(key(i), std::string(i % 7, 'v') + std::to_string(i)));
+    if (i == 15) {
+      ASSERT_OK(Flush());
+    }
+  }
+  // Newer versions and deletions in the memtable
+  ASSERT_OK(Put(key(3), "new"));
+  ASSERT_OK(Delete(key(4)));
+  ASSERT_OK(Delete(key(20)));
+  {
+    std::unique_ptr<Iterator> iter(NewIterator(ReadOptions()));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      expected.emplace_back(iter->key().ToString(), iter->value().ToString());
+    }
+    ASSERT_OK(iter->status());
+  }
+  ASSERT_EQ(expected.size(), 28);
+
+  for (bool pin_data : {false, true}) {
+    ReadOptions ro;
+    ro.pin_data = pin_data;
+    std::unique_ptr<Iterator> iter(NewIterator(ro));
+    constexpr size_t kMaxEntries = 4;
+    Slice keys[kMaxEntries];
+    Slice values[kMaxEntries];
+    std::string buf;
+
+    // Slices stay valid until the next modification of the iterator
+    std::vector<std::pair<std::string, std::string>> result;
+    iter->SeekToFirst();
+    while (iter->Valid()) {
+      const size_t n = iter->NextBatch(kMaxEntries, SIZE_MAX, keys, values,
+                                       &buf);
+      ASSERT_GT(n, 0);
+      ASSERT_LE(n, kMaxEntries);
+      for (size_t i = 0; i < n; ++i) {
+        result.emplace_back(keys[i].ToString(), values[i].ToString());
+      }
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(result, expected);
+    ASSERT_EQ(iter->NextBatch(kMaxEntries, SIZE_MAX, keys, values, &buf), 0);
+
+    // The batch ends once the byte limit is reached, but always returns an
+    // entry
+    iter->Seek(key(6));
+    ASSERT_EQ(iter->NextBatch(kMaxEntries, 0, keys, values, &buf), 1);
+    ASSERT_EQ(keys[0], key(6));
+    ASSERT_EQ(values[0], std::string(6, 'v') + "6");
+    ASSERT_EQ(IterStatus(iter.get()), key(7) + "->7");
+    ASSERT_EQ(iter->NextBatch(kMaxEntries, 7, keys, values, &buf), 2);
+    ASSERT_EQ(keys[0], key(7));
+    ASSERT_EQ(keys[1], key(8));
+    ASSERT_EQ(values[1], "v8");
+
+    // Mixes with the other operations, including after a direction change
+    iter->Seek(key(10));
+    iter->Prev();
+    ASSERT_EQ(iter->NextBatch(kMaxEntries, SIZE_MAX, keys, values, &buf),
+              kMaxEntries);
+    ASSERT_EQ(keys[0], key(9));
+    ASSERT_EQ(keys[3], key(12));
+    ASSERT_EQ(values[3], "vvvvv12");
+    ASSERT_EQ(IterStatus(iter.get()), key(13) + "->vvvvvv13");
+    iter->Prev();
+    ASSERT_EQ(IterStatus(iter.get()), key(12) + "->vvvvv12");
+  }
+}
+
+TEST_F(DBIteratorBaseTest, PartitionedScan) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  constexpr int kNumKeys = 2000;
+  Random rnd(301);
+  std::vector<std::string> keys;
+  for (int i = 0; i < kNumKeys; ++i) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "k%05d", i);
+    keys.emplace_back(buf);
+    ASSERT_OK(Put(keys.back(), rnd.RandomString(100)));
+    if (i % 500 == 499) {
+      ASSERT_OK(Flush());
+    }
+  }
+  MoveFilesToLevel(1);
+
+  std::vector<std::string> boundaries;
+  ASSERT_TRUE(db_->GetScanPartitionBoundaries(ReadOptions(),
+                                              db_->DefaultColumnFamily(),
+                                              OptSlice(), OptSlice(), 0,
+                                              &boundaries)
+                  .IsInvalidArgument());
+  ASSERT_OK(db_->GetScanPartitionBoundaries(ReadOptions(),
+                                            db_->DefaultColumnFamily(),
+                                            OptSlice(), OptSlice(), 1,
+                                            &boundaries));
+  ASSERT_TRUE(boundaries.empty());
+  ASSERT_OK(db_->GetScanPartitionBoundaries(ReadOptions(),
+                                            db_->DefaultColumnFamily(),
+                                            OptSlice(), OptSlice(), 4,
+                                            &boundaries));
+  ASSERT_EQ(boundaries.size(), 3);
+  ASSERT_TRUE(std::is_sorted(boundaries.begin(), boundaries.end()));
+  // Roughly even split
+  ASSERT_GT(boundaries[0], keys[kNumKeys / 8]);
+  ASSERT_LT(boundaries[2], keys[kNumKeys * 7 / 8]);
+
+  ASSERT_OK(db_->GetScanPartitionBoundaries(
+      ReadOptions(), db_->DefaultColumnFamily(), keys[500], keys[1000], 5,
+      &boundaries));
+  ASSERT_EQ(boundaries.size(), 4);
+  for (const auto& boundary : boundaries) {
+    ASSERT_GT(boundary, keys[500]);
+    ASSERT_LT(boundary, keys[1000]);
+  }
+
+  std::unique_ptr<PartitionedScan> scan;
+  ASSERT_OK(PartitionedScan::Create(db_, ReadOptions(),
+                                    db_->DefaultColumnFamily(), OptSlice(),
+                                    OptSlice(), 8, &scan));
+  ASSERT_EQ(scan->NumPartitions(), 8);
+  ASSERT_FALSE(scan->LowerBound(0).has_value());
+  ASSERT_FALSE(scan->UpperBound(7).has_value());
+
+  // Not visible to the scan
+  ASSERT_OK(Put("k", "v"));
+  ASSERT_OK(Delete(keys[1500]));
+
+  std::vector<std::vector<std::string>> scanned(scan->NumPartitions());
+  ASSERT_OK(scan->ForEach(3, [&](size_t i, Iterator* iter) {
+    if (i > 0) {
+      EXPECT_EQ(*scan->LowerBound(i), *scan->UpperBound(i - 1));
+    }
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      scanned[i].push_back(iter->key().ToString());
+    }
+    return iter->status();
+  }));
+  std::vector<std::string> all_scanned;
+  for (const auto& partition : scanned) {
+    ASSERT_FALSE(partition.empty());
+    all_scanned.insert(all_scanned.end(), partition.begin(), partition.end());
+  }
+  ASSERT_EQ(all_scanned, keys);
+
+  // The first error stops the scan
+  std::atomic<int> calls{0};
+  Status s = scan->ForEach(1, [&](size_t, Iterator*) {
+    ++calls;
+    return Status::Aborted("stop");
+  });
+  ASSERT_TRUE(s.IsAborted());
+  ASSERT_EQ(calls.load(), 1);
+  scan.reset();
+
+  // Bounded scan, reading a new snapshot
+  ASSERT_OK(PartitionedScan::Create(db_, ReadOptions(),
+                                    db_->DefaultColumnFamily(), keys[1000],
+                                    keys[1600], 3, &scan));
+  ASSERT_EQ(*scan->LowerBound(0), keys[1000]);
+  ASSERT_EQ(*scan->UpperBound(scan->NumPartitions() - 1), keys[1600]);
+  std::atomic<size_t> count{0};
+  ASSERT_OK(scan->ForEach(2, [&](size_t, Iterator* iter) {
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++count;
+    }
+    return iter->status();
+  }));
+  // Without the deleted key
+  ASSERT_EQ(count.load(), 599);
+}
+
 INSTANTIATE_TEST_CASE_P(DBIteratorTestInstance, DBIteratorTest,
                         testing::Values(true, false));
 
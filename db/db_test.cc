@@ -7521,6 +7521,131 @@ TEST_F(DBTest, ReusePinnableSlice) {
             1);
 }
 
+TEST_F(DBTest, PointLookupCache) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.point_lookup_cache = NewLRUCache(1 << 20);
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  DestroyAndReopen(options);
+
+  auto hits = [&]() {
+    return TestGetTickerCount(options, POINT_LOOKUP_CACHE_HIT);
+  };
+  auto misses = [&]() {
+    return TestGetTickerCount(options, POINT_LOOKUP_CACHE_MISS);
+  };
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(Get("foo"), "v1");
+  ASSERT_EQ(hits(), 0);
+  ASSERT_EQ(misses(), 1);
+  ASSERT_EQ(Get("foo"), "v1");
+  ASSERT_EQ(hits(), 1);
+  ASSERT_EQ(misses(), 1);
+
+  // Keys that do not exist are cached too
+  ASSERT_EQ(Get("bar"), "NOT_FOUND");
+  ASSERT_EQ(Get("bar"), "NOT_FOUND");
+  ASSERT_EQ(hits(), 2);
+  ASSERT_EQ(misses(), 2);
+
+  // Writes invalidate the key
+  ASSERT_OK(Put("foo", "v2"));
+  ASSERT_EQ(Get("foo"), "v2");
+  ASSERT_EQ(Get("foo"), "v2");
+  ASSERT_OK(Merge("foo", "v3"));
+  ASSERT_EQ(Get("foo"), "v2,v3");
+  ASSERT_EQ(Get("foo"), "v2,v3");
+  ASSERT_OK(Put("bar", "v1"));
+  ASSERT_EQ(Get("bar"), "v1");
+  ASSERT_OK(Delete("bar"));
+  ASSERT_EQ(Get("bar"), "NOT_FOUND");
+  ASSERT_EQ(Get("bar"), "NOT_FOUND");
+  ASSERT_OK(Delete("foo"));
+  ASSERT_EQ(Get("foo"), "NOT_FOUND");
+  ASSERT_EQ(hits(), 5);
+  ASSERT_EQ(misses(), 7);
+
+  // Range deletions invalidate everything
+  ASSERT_OK(Put("baz", "v1"));
+  ASSERT_EQ(Get("baz"), "v1");
+  ASSERT_EQ(Get("baz"), "v1");
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "a",
+                             "z"));
+  ASSERT_EQ(Get("baz"), "NOT_FOUND");
+  ASSERT_EQ(hits(), 6);
+  ASSERT_EQ(misses(), 9);
+
+  // Flushes and compactions do not change the results
+  ASSERT_OK(Put("baz", "v2"));
+  ASSERT_EQ(Get("baz"), "v2");
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(Get("baz"), "v2");
+  ASSERT_EQ(hits(), 7);
+  ASSERT_EQ(misses(), 10);
+
+  // Reads at a snapshot bypass the cache
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ASSERT_OK(Put("baz", "v3"));
+  ASSERT_EQ(Get("baz", snapshot), "v2");
+  ASSERT_EQ(Get("baz"), "v3");
+  ASSERT_EQ(hits(), 7);
+  ASSERT_EQ(misses(), 11);
+  db_->ReleaseSnapshot(snapshot);
+
+  // As does the rest of the ineligible reads
+  std::string value;
+  ASSERT_TRUE(db_->KeyMayExist(ReadOptions(), "baz", &value));
+  ReadOptions ropts;
+  ropts.read_tier = kBlockCacheTier;
+  ASSERT_OK(db_->Get(ropts, "baz", &value));
+  ASSERT_EQ(value, "v3");
+  ASSERT_EQ(hits(), 7);
+  ASSERT_EQ(misses(), 11);
+}
+
+TEST_F(DBTest, PointLookupCacheIngestion) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.point_lookup_cache = NewLRUCache(1 << 20);
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_EQ(Get("foo"), "v1");
+  ASSERT_EQ(Get("foo"), "v1");
+  ASSERT_EQ(TestGetTickerCount(options, POINT_LOOKUP_CACHE_HIT), 1);
+
+  std::string file = dbname_ + "/point_lookup_cache_ingest.sst";
+  SstFileWriter writer(EnvOptions(), options);
+  ASSERT_OK(writer.Open(file));
+  ASSERT_OK(writer.Put("foo", "v2"));
+  ASSERT_OK(writer.Finish());
+  ASSERT_OK(db_->IngestExternalFile({file}, IngestExternalFileOptions()));
+  ASSERT_EQ(Get("foo"), "v2");
+  ASSERT_EQ(Get("foo"), "v2");
+  ASSERT_EQ(TestGetTickerCount(options, POINT_LOOKUP_CACHE_HIT), 2);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(Get("foo"), "v2");
+  Slice begin = "a";
+  Slice end = "z";
+  ASSERT_OK(DeleteFilesInRange(db_, db_->DefaultColumnFamily(), &begin, &end));
+  ASSERT_EQ(Get("foo"), "NOT_FOUND");
+  ASSERT_EQ(TestGetTickerCount(options, POINT_LOOKUP_CACHE_HIT), 3);
+}
+
+TEST_F(DBTest, PointLookupCacheIncompatibleOptions) {
+  Options options = CurrentOptions();
+  options.point_lookup_cache = NewLRUCache(1 << 20);
+  options.unordered_write = true;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+  options.unordered_write = false;
+  options.two_write_queues = true;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+}
+
 TEST_F(DBTest, DeletingOldWalAfterDrop) {
   ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->LoadDependency(
       {{"Test:AllowFlushes", "DBImpl::BGWorkFlush"},
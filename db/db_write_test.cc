@@ -509,6 +509,85 @@ TEST_P(DBWriteTest, ManualWalFlushInEffect) {
   ASSERT_TRUE(dbfull()->WALBufferIsEmpty());
 }
 
+TEST_P(DBWriteTest, PutReferenced) {
+  Options options = GetOptions();
+  Reopen(options);
+  // Spans several WAL blocks
+  std::string large_value(100000, 'a');
+  std::string small_value = "small";
+  WriteBatch batch;
+  ASSERT_OK(batch.PutReferenced("large", large_value));
+  ASSERT_OK(batch.Put("copied", "value"));
+  ASSERT_OK(batch.PutReferenced("small", small_value));
+  ASSERT_OK(dbfull()->Write(WriteOptions(), &batch));
+  // The referenced buffers may be reused once the write returned
+  large_value.assign(large_value.size(), 'b');
+  small_value = "reused";
+
+  ASSERT_EQ(std::string(100000, 'a'), Get("large"));
+  ASSERT_EQ("value", Get("copied"));
+  ASSERT_EQ("small", Get("small"));
+
+  // Recovered from the WAL
+  Reopen(options);
+  ASSERT_EQ(std::string(100000, 'a'), Get("large"));
+  ASSERT_EQ("value", Get("copied"));
+  ASSERT_EQ("small", Get("small"));
+}
+
+TEST_P(DBWriteTest, GatheredWriteGroupRecovery) {
+  constexpr int kNumThreads = 4;
+  Options options = GetOptions();
+  Reopen(options);
+  std::atomic<int> ready_count{0};
+  std::atomic<int> leader_count{0};
+  std::vector<port::Thread> threads;
+
+  // Wait until all threads linked to write threads, to make sure
+  // all threads join the same batch group.
+  SyncPoint::GetInstance()->SetCallBack(
+      "WriteThread::JoinBatchGroup:Wait", [&](void* arg) {
+        ready_count++;
+        auto* w = static_cast<WriteThread::Writer*>(arg);
+        if (w->state == WriteThread::STATE_GROUP_LEADER) {
+          leader_count++;
+          while (ready_count < kNumThreads) {
+            // busy waiting
+          }
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+  for (int i = 0; i < kNumThreads; i++) {
+    threads.emplace_back(
+        [&](int index) {
+          WriteBatch batch;
+          // Large values make the group span several WAL blocks
+          ASSERT_OK(
+              batch.Put("key" + std::to_string(index),
+                        std::string(20000, static_cast<char>('a' + index))));
+          ASSERT_OK(batch.Delete("missing" + std::to_string(index)));
+          ASSERT_OK(dbfull()->Write(WriteOptions(), &batch));
+        },
+        i);
+  }
+  for (int i = 0; i < kNumThreads; i++) {
+    threads[i].join();
+  }
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  ASSERT_EQ(1, leader_count);
+  if (options.manual_wal_flush) {
+    ASSERT_OK(dbfull()->FlushWAL(false));
+  }
+
+  // Recovered from the WAL
+  Reopen(options);
+  for (int i = 0; i < kNumThreads; i++) {
+    ASSERT_EQ(std::string(20000, static_cast<char>('a' + i)),
+              Get("key" + std::to_string(i)));
+  }
+}
+
 TEST_P(DBWriteTest, UnflushedPutRaceWithTrackedWalSync) {
   // Repro race condition bug where unflushed WAL data extended the synced size
   // recorded to MANIFEST despite being unrecoverable.
@@ -74,6 +74,11 @@ enum ValueType : unsigned char {
   kTypeColumnFamilyValuePreferredSeqno = 0x19,  // WAL only
   kTypeMaxValid,    // Should be after the last valid type, only used for
                     // validation
+  // In-memory WriteBatch only. A Put whose value is referenced from a
+  // caller-owned buffer instead of being copied into the batch. Written to
+  // the WAL as kTypeValue / kTypeColumnFamilyValue.
+  kTypeValueReference = 0x7D,
+  kTypeColumnFamilyValueReference = 0x7E,
   kMaxValue = 0x7F  // Not used for storing records.
 };
 
@@ -1005,10 +1010,15 @@ bool ReadKeyFromWriteBatchEntry(Slice* input, Slice* key, bool cf_record);
 // input will be advanced to after the record.
 // If user-defined timestamp is enabled for a column family, then the `key`
 // resulting from this call will include timestamp.
+// Values referenced by WriteBatch::PutReferenced() are only resolved if
+// `allow_value_references`, i.e. when reading the in-process batch they were
+// added to. Anywhere else (e.g. WAL recovery or a batch rebuilt from its
+// contents) their records are reported as corruption.
 Status ReadRecordFromWriteBatch(Slice* input, char* tag,
                                 uint32_t* column_family, Slice* key,
                                 Slice* value, Slice* blob, Slice* xid,
-                                uint64_t* write_unix_time);
+                                uint64_t* write_unix_time,
+                                bool allow_value_references = false);
 
 // When user call DeleteRange() to delete a range of keys,
 // we will store a serialized RangeTombstone in MemTable and SST.
@@ -260,6 +260,9 @@ static const std::string dbstats = "dbstats";
 static const std::string db_write_stall_stats = "db-write-stall-stats";
 static const std::string levelstats = "levelstats";
 static const std::string block_cache_entry_stats = "block-cache-entry-stats";
+static const std::string block_cache_tenant_stats =
+    "block-cache-tenant-stats";
+static const std::string block_cache_heatmap = "block-cache-heatmap";
 static const std::string fast_block_cache_entry_stats =
     "fast-block-cache-entry-stats";
 static const std::string num_immutable_mem_table = "num-immutable-mem-table";
@@ -350,6 +353,10 @@ const std::string DB::Properties::kBlockCacheEntryStats =
     rocksdb_prefix + block_cache_entry_stats;
 const std::string DB::Properties::kFastBlockCacheEntryStats =
     rocksdb_prefix + fast_block_cache_entry_stats;
+const std::string DB::Properties::kBlockCacheTenantStats =
+    rocksdb_prefix + block_cache_tenant_stats;
+const std::string DB::Properties::kBlockCacheHeatmap =
+    rocksdb_prefix + block_cache_heatmap;
 const std::string DB::Properties::kNumImmutableMemTable =
     rocksdb_prefix + num_immutable_mem_table;
 const std::string DB::Properties::kNumImmutableMemTableFlushed =
@@ -490,6 +497,12 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kFastBlockCacheEntryStats,
          {true, &InternalStats::HandleFastBlockCacheEntryStats, nullptr,
           &InternalStats::HandleFastBlockCacheEntryStatsMap, nullptr}},
+        {DB::Properties::kBlockCacheTenantStats,
+         {false, &InternalStats::HandleBlockCacheTenantStats, nullptr,
+          &InternalStats::HandleBlockCacheTenantStatsMap, nullptr}},
+        {DB::Properties::kBlockCacheHeatmap,
+         {false, &InternalStats::HandleBlockCacheHeatmap, nullptr,
+          &InternalStats::HandleBlockCacheHeatmapMap, nullptr}},
         {DB::Properties::kSSTables,
          {false, &InternalStats::HandleSsTables, nullptr, nullptr, nullptr}},
         {DB::Properties::kAggregatedTableProperties,
@@ -648,6 +661,7 @@ InternalStats::InternalStats(int num_levels, SystemClock* clock,
       comp_stats_(num_levels),
       comp_stats_by_pri_(Env::Priority::TOTAL),
       file_read_latency_(num_levels),
+      block_cache_heatmap_(num_levels),
       has_cf_change_since_dump_(true),
       bg_error_count_(0),
       num_running_compaction_sorted_runs_(0),
@@ -831,6 +845,117 @@ bool InternalStats::HandleFastBlockCacheEntryStatsMap(
   return HandleBlockCacheEntryStatsMapInternal(values, true /* fast */);
 }
 
+bool InternalStats::HandleBlockCacheTenantStats(std::string* value,
+                                                Slice suffix) {
+  std::map<std::string, std::string> values;
+  if (!HandleBlockCacheTenantStatsMap(&values, suffix)) {
+    return false;
+  }
+  value->clear();
+  for (const auto& kv : values) {
+    value->append(kv.first).append(": ").append(kv.second).append("\n");
+  }
+  return true;
+}
+
+bool InternalStats::HandleBlockCacheTenantStatsMap(
+    std::map<std::string, std::string>* values, Slice /*suffix*/) {
+  Cache* block_cache = GetBlockCacheForStats();
+  CacheTenantStats stats;
+  if (block_cache == nullptr ||
+      !GetCacheTenantStats(*block_cache, &stats).ok()) {
+    return false;
+  }
+  const uint64_t lookups = stats.hits + stats.misses;
+  (*values)["name"] = stats.name;
+  (*values)["usage"] = std::to_string(stats.usage);
+  (*values)["reserved-ratio"] = std::to_string(stats.reserved_ratio);
+  (*values)["max-ratio"] = std::to_string(stats.max_ratio);
+  (*values)["hits"] = std::to_string(stats.hits);
+  (*values)["misses"] = std::to_string(stats.misses);
+  (*values)["hit-ratio"] = std::to_string(
+      lookups > 0 ? static_cast<double>(stats.hits) / lookups : 0.0);
+  return true;
+}
+
+bool InternalStats::HandleBlockCacheHeatmap(std::string* value,
+                                            Slice suffix) {
+  std::map<std::string, std::string> values;
+  if (!HandleBlockCacheHeatmapMap(&values, suffix)) {
+    return false;
+  }
+  value->clear();
+  for (const auto& kv : values) {
+    value->append(kv.first).append(": ").append(kv.second).append("\n");
+  }
+  return true;
+}
+
+bool InternalStats::HandleBlockCacheHeatmapMap(
+    std::map<std::string, std::string>* values, Slice /*suffix*/) {
+  // Bound on the number of files reported, the ones with the most misses
+  constexpr size_t kMaxReportedFiles = 32;
+
+  (*values)["sample-interval"] =
+      std::to_string(BlockCacheHeatmap::kSampleInterval);
+  for (int level = -1; level < block_cache_heatmap_.num_levels(); ++level) {
+    const std::string prefix =
+        level < 0 ? "unknown." : "l" + std::to_string(level) + ".";
+    BlockCacheHeatmap::Counts total =
+        block_cache_heatmap_.GetLevelCounts(level);
+    if (level >= 0) {
+      (*values)[prefix + "hits"] = std::to_string(total.hits);
+      (*values)[prefix + "misses"] = std::to_string(total.misses);
+    }
+    if (total.hits + total.misses == 0) {
+      continue;
+    }
+    for (uint8_t i = 0; i < static_cast<uint8_t>(BlockType::kInvalid); ++i) {
+      const auto block_type = static_cast<BlockType>(i);
+      BlockCacheHeatmap::Counts counts =
+          block_cache_heatmap_.GetLevelCounts(level, block_type);
+      if (counts.hits + counts.misses == 0) {
+        continue;
+      }
+      const std::string type_prefix =
+          prefix + BlockCacheHeatmap::BlockTypeName(block_type) + ".";
+      (*values)[type_prefix + "hits"] = std::to_string(counts.hits);
+      (*values)[type_prefix + "misses"] = std::to_string(counts.misses);
+    }
+  }
+
+  UnorderedMap<uint64_t, int> file_levels;
+  const auto* vstorage = cfd_->current()->storage_info();
+  for (int level = 0; level < vstorage->num_levels(); ++level) {
+    for (const auto* file_meta : vstorage->LevelFiles(level)) {
+      file_levels[file_meta->fd.GetNumber()] = level;
+    }
+  }
+  // Files no longer in the current version are forgotten, even if older
+  // versions still read them
+  std::map<uint64_t, BlockCacheHeatmap::Counts> file_counts;
+  block_cache_heatmap_.GetFileCounts(
+      [&](uint64_t file_number) {
+        return file_levels.find(file_number) != file_levels.end();
+      },
+      &file_counts);
+  std::vector<std::pair<uint64_t, BlockCacheHeatmap::Counts>> hottest(
+      file_counts.begin(), file_counts.end());
+  std::sort(hottest.begin(), hottest.end(), [](const auto& a, const auto& b) {
+    return a.second.misses != b.second.misses
+               ? a.second.misses > b.second.misses
+               : a.second.hits > b.second.hits;
+  });
+  hottest.resize(std::min(hottest.size(), kMaxReportedFiles));
+  for (const auto& fc : hottest) {
+    const std::string prefix = "file." + std::to_string(fc.first) + ".";
+    (*values)[prefix + "level"] = std::to_string(file_levels[fc.first]);
+    (*values)[prefix + "hits"] = std::to_string(fc.second.hits);
+    (*values)[prefix + "misses"] = std::to_string(fc.second.misses);
+  }
+  return true;
+}
+
 bool InternalStats::HandleLiveSstFilesSizeAtTemperature(std::string* value,
                                                         Slice suffix) {
   uint64_t temperature;
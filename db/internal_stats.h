@@ -17,6 +17,7 @@
 
 #include "cache/cache_entry_roles.h"
 #include "db/version_set.h"
+#include "monitoring/block_cache_heatmap.h"
 #include "rocksdb/system_clock.h"
 #include "util/hash_containers.h"
 
@@ -625,6 +626,8 @@ class InternalStats {
 
   HistogramImpl* GetBlobFileReadHist() { return &blob_file_read_latency_; }
 
+  BlockCacheHeatmap* GetBlockCacheHeatmap() { return &block_cache_heatmap_; }
+
   uint64_t GetBackgroundErrorCount() const { return bg_error_count_; }
 
   uint64_t BumpAndGetBackgroundErrorCount() { return ++bg_error_count_; }
@@ -717,6 +720,7 @@ class InternalStats {
   CompactionStats per_key_placement_comp_stats_;
   std::vector<HistogramImpl> file_read_latency_;
   HistogramImpl blob_file_read_latency_;
+  BlockCacheHeatmap block_cache_heatmap_;
   bool has_cf_change_since_dump_;
   // How many periods of no change since the last time stats are dumped for
   // a periodic dump.
@@ -907,6 +911,12 @@ class InternalStats {
   bool HandleFastBlockCacheEntryStats(std::string* value, Slice suffix);
   bool HandleFastBlockCacheEntryStatsMap(
       std::map<std::string, std::string>* values, Slice suffix);
+  bool HandleBlockCacheTenantStats(std::string* value, Slice suffix);
+  bool HandleBlockCacheTenantStatsMap(
+      std::map<std::string, std::string>* values, Slice suffix);
+  bool HandleBlockCacheHeatmap(std::string* value, Slice suffix);
+  bool HandleBlockCacheHeatmapMap(std::map<std::string, std::string>* values,
+                                  Slice suffix);
   bool HandleLiveSstFilesSizeAtTemperature(std::string* value, Slice suffix);
   bool HandleNumBlobFiles(uint64_t* value, DBImpl* db, Version* version);
   bool HandleBlobStats(std::string* value, Slice suffix);
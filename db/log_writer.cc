@@ -9,6 +9,7 @@
 
 #include "db/log_writer.h"
 
+#include <array>
 #include <cstdint>
 
 #include "file/writable_file_writer.h"
@@ -190,6 +191,109 @@ IOStatus Writer::AddRecord(const WriteOptions& write_options,
   return s;
 }
 
+IOStatus Writer::AddRecord(const WriteOptions& write_options,
+                           const SliceParts& parts,
+                           const SequenceNumber& seqno) {
+  if (parts.num_parts == 1) {
+    return AddRecord(write_options, parts.parts[0], seqno);
+  }
+  if (compress_) {
+    // Streaming compression works on one contiguous input
+    std::string flattened;
+    return AddRecord(write_options, Slice(parts, &flattened), seqno);
+  }
+
+  IOStatus s = MaybeHandleSeenFileWriterError();
+  if (!s.ok()) {
+    return s;
+  }
+  size_t left = 0;
+  for (int i = 0; i < parts.num_parts; ++i) {
+    left += parts.parts[i].size();
+  }
+  // The parts of the current fragment. The first and last may be partial.
+  std::vector<Slice> fragment_parts;
+  int part_index = 0;
+  size_t part_offset = 0;
+
+  IOOptions opts;
+  s = WritableFileWriter::PrepareIOOptions(write_options, opts);
+  // Fragment the record if necessary and emit it, as in the single-slice
+  // AddRecord(). An empty record is emitted as a single zero-length record.
+  bool begin = true;
+  if (s.ok()) {
+    do {
+      const int64_t leftover = kBlockSize - block_offset_;
+      assert(leftover >= 0);
+      if (leftover < header_size_) {
+        // Switch to a new block
+        if (leftover > 0) {
+          // Fill the trailer (literal below relies on kHeaderSize and
+          // kRecyclableHeaderSize being <= 11)
+          assert(header_size_ <= 11);
+          s = dest_->Append(opts,
+                            Slice("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+                                  static_cast<size_t>(leftover)),
+                            0 /* crc32c_checksum */);
+          if (!s.ok()) {
+            break;
+          }
+        }
+        block_offset_ = 0;
+      }
+
+      // Invariant: we never leave < header_size bytes in a block.
+      assert(static_cast<int64_t>(kBlockSize - block_offset_) >= header_size_);
+
+      const size_t avail = kBlockSize - block_offset_ - header_size_;
+      const size_t fragment_length = (left < avail) ? left : avail;
+
+      fragment_parts.clear();
+      size_t needed = fragment_length;
+      while (needed > 0) {
+        assert(part_index < parts.num_parts);
+        const Slice& part = parts.parts[part_index];
+        const size_t n = std::min(needed, part.size() - part_offset);
+        fragment_parts.emplace_back(part.data() + part_offset, n);
+        needed -= n;
+        part_offset += n;
+        if (part_offset == part.size()) {
+          ++part_index;
+          part_offset = 0;
+        }
+      }
+
+      RecordType type;
+      const bool end = (left == fragment_length);
+      if (begin && end) {
+        type = recycle_log_files_ ? kRecyclableFullType : kFullType;
+      } else if (begin) {
+        type = recycle_log_files_ ? kRecyclableFirstType : kFirstType;
+      } else if (end) {
+        type = recycle_log_files_ ? kRecyclableLastType : kLastType;
+      } else {
+        type = recycle_log_files_ ? kRecyclableMiddleType : kMiddleType;
+      }
+
+      s = EmitPhysicalRecord(write_options, type, fragment_parts.data(),
+                             fragment_parts.size(), fragment_length);
+      left -= fragment_length;
+      begin = false;
+    } while (s.ok() && left > 0);
+  }
+  if (s.ok()) {
+    if (!manual_flush_) {
+      s = dest_->Flush(opts);
+    }
+  }
+
+  if (s.ok()) {
+    last_seqno_recorded_ = std::max(last_seqno_recorded_, seqno);
+  }
+
+  return s;
+}
+
 IOStatus Writer::AddCompressionTypeRecord(const WriteOptions& write_options) {
   // Should be the first record
   assert(block_offset_ == 0);
@@ -310,6 +414,13 @@ bool Writer::BufferIsEmpty() { return dest_->BufferIsEmpty(); }
 
 IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
                                     RecordType t, const char* ptr, size_t n) {
+  Slice payload(ptr, n);
+  return EmitPhysicalRecord(write_options, t, &payload, 1, n);
+}
+
+IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
+                                    RecordType t, const Slice* parts,
+                                    size_t num_parts, size_t n) {
   assert(n <= 0xffff);  // Must fit in two bytes
 
   size_t header_size;
@@ -340,9 +451,29 @@ IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
     crc = crc32c::Extend(crc, buf + 7, 4);
   }
 
-  // Compute the crc of the record type and the payload.
-  uint32_t payload_crc = crc32c::Value(ptr, n);
-  crc = crc32c::Crc32cCombine(crc, payload_crc, n);
+  // Compute the crc of the record type and the payload. The header and the
+  // payload parts are appended together, the header's checksum being left
+  // for the file writer to compute.
+  constexpr size_t kInlineSlices = 8;
+  std::array<Slice, kInlineSlices> inline_slices;
+  std::array<uint32_t, kInlineSlices> inline_slice_crcs;
+  std::vector<Slice> heap_slices;
+  std::vector<uint32_t> heap_slice_crcs;
+  Slice* slices = inline_slices.data();
+  uint32_t* slice_crcs = inline_slice_crcs.data();
+  if (num_parts + 1 > kInlineSlices) {
+    heap_slices.resize(num_parts + 1);
+    heap_slice_crcs.resize(num_parts + 1);
+    slices = heap_slices.data();
+    slice_crcs = heap_slice_crcs.data();
+  }
+  slices[0] = Slice(buf, header_size);
+  slice_crcs[0] = 0 /* crc32c_checksum */;
+  for (size_t i = 0; i < num_parts; ++i) {
+    slices[i + 1] = parts[i];
+    slice_crcs[i + 1] = crc32c::Value(parts[i].data(), parts[i].size());
+    crc = crc32c::Crc32cCombine(crc, slice_crcs[i + 1], parts[i].size());
+  }
   crc = crc32c::Mask(crc);  // Adjust for storage
   TEST_SYNC_POINT_CALLBACK("LogWriter::EmitPhysicalRecord:BeforeEncodeChecksum",
                            &crc);
@@ -352,10 +483,7 @@ IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
   IOOptions opts;
   IOStatus s = WritableFileWriter::PrepareIOOptions(write_options, opts);
   if (s.ok()) {
-    s = dest_->Append(opts, Slice(buf, header_size), 0 /* crc32c_checksum */);
-  }
-  if (s.ok()) {
-    s = dest_->Append(opts, Slice(ptr, n), payload_crc);
+    s = dest_->Append(opts, slices, num_parts + 1, slice_crcs);
   }
   block_offset_ += header_size + n;
   return s;
@@ -92,6 +92,10 @@ class Writer {
 
   IOStatus AddRecord(const WriteOptions& write_options, const Slice& slice,
                      const SequenceNumber& seqno = 0);
+  // Adds a record whose contents are the concatenation of `parts`, without
+  // first copying them into one buffer (unless the WAL is compressed).
+  IOStatus AddRecord(const WriteOptions& write_options, const SliceParts& parts,
+                     const SequenceNumber& seqno = 0);
   IOStatus AddCompressionTypeRecord(const WriteOptions& write_options);
   IOStatus MaybeAddPredecessorWALInfo(const WriteOptions& write_options,
                                       const PredecessorWALInfo& info);
@@ -139,6 +143,11 @@ class Writer {
 
   IOStatus EmitPhysicalRecord(const WriteOptions& write_options,
                               RecordType type, const char* ptr, size_t length);
+  // Emits a physical record whose payload is the concatenation of
+  // `num_parts` slices totalling `length` bytes.
+  IOStatus EmitPhysicalRecord(const WriteOptions& write_options,
+                              RecordType type, const Slice* parts,
+                              size_t num_parts, size_t length);
 
   IOStatus MaybeHandleSeenFileWriterError();
 
@@ -23,6 +23,7 @@
 #include "db/range_tombstone_fragmenter.h"
 #include "db/read_callback.h"
 #include "db/wide/wide_column_serialization.h"
+#include "db/wide/wide_columns_helper.h"
 #include "logging/logging.h"
 #include "memory/arena.h"
 #include "memory/memory_usage.h"
@@ -1095,6 +1096,7 @@ struct Saver {
   bool* merge_in_progress;
   std::string* value;
   PinnableWideColumns* columns;
+  const std::vector<Slice>* column_projection;
   SequenceNumber seq;
   std::string* timestamp;
   const MergeOperator* merge_operator;
@@ -1306,7 +1308,11 @@ static bool SaveValue(void* arg, const char* entry) {
             s->value->assign(value_of_default.data(), value_of_default.size());
           }
         } else if (s->columns) {
-          *(s->status) = s->columns->SetWideColumnValue(v);
+          *(s->status) =
+              s->column_projection
+                  ? WideColumnsHelper::SetProjectedWideColumnValue(
+                        v, *s->column_projection, *s->columns)
+                  : s->columns->SetWideColumnValue(v);
         }
 
         *(s->found_final_value) = true;
@@ -1420,8 +1426,9 @@ bool MemTable::Get(const LookupKey& key, std::string* value,
       PERF_COUNTER_ADD(bloom_memtable_hit_count, 1);
     }
     GetFromTable(key, *max_covering_tombstone_seq, do_merge, callback,
-                 is_blob_index, value, columns, timestamp, s, merge_context,
-                 seq, &found_final_value, &merge_in_progress);
+                 is_blob_index, value, columns, read_opts.column_projection,
+                 timestamp, s, merge_context, seq, &found_final_value,
+                 &merge_in_progress);
   }
 
   // No change to value, since we have not yet found a Put/Delete
@@ -1442,6 +1449,7 @@ void MemTable::GetFromTable(const LookupKey& key,
                             bool do_merge, ReadCallback* callback,
                             bool* is_blob_index, std::string* value,
                             PinnableWideColumns* columns,
+                            const std::vector<Slice>* column_projection,
                             std::string* timestamp, Status* s,
                             MergeContext* merge_context, SequenceNumber* seq,
                             bool* found_final_value, bool* merge_in_progress) {
@@ -1452,6 +1460,7 @@ void MemTable::GetFromTable(const LookupKey& key,
   saver.key = &key;
   saver.value = value;
   saver.columns = columns;
+  saver.column_projection = column_projection;
   saver.timestamp = timestamp;
   saver.seq = kMaxSequenceNumber;
   saver.mem = this;
@@ -1549,8 +1558,9 @@ void MemTable::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
     GetFromTable(*(iter->lkey), iter->max_covering_tombstone_seq, true,
                  callback, &iter->is_blob_index,
                  iter->value ? iter->value->GetSelf() : nullptr, iter->columns,
-                 iter->timestamp, iter->s, &(iter->merge_context), &dummy_seq,
-                 &found_final_value, &merge_in_progress);
+                 read_options.column_projection, iter->timestamp, iter->s,
+                 &(iter->merge_context), &dummy_seq, &found_final_value,
+                 &merge_in_progress);
 
     if (!found_final_value && merge_in_progress) {
       if (iter->s->ok()) {
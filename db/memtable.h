@@ -917,6 +917,7 @@ class MemTable final : public ReadOnlyMemTable {
                     SequenceNumber max_covering_tombstone_seq, bool do_merge,
                     ReadCallback* callback, bool* is_blob_index,
                     std::string* value, PinnableWideColumns* columns,
+                    const std::vector<Slice>* column_projection,
                     std::string* timestamp, Status* s,
                     MergeContext* merge_context, SequenceNumber* seq,
                     bool* found_final_value, bool* merge_in_progress);
@@ -0,0 +1,151 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/partitioned_scan.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "port/port.h"
+#include "rocksdb/db.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct PartitionedScan::Partition {
+  std::string lower_bound;
+  std::string upper_bound;
+  Slice lower_bound_slice;
+  Slice upper_bound_slice;
+  bool has_lower_bound = false;
+  bool has_upper_bound = false;
+  std::unique_ptr<Iterator> iter;
+};
+
+Status PartitionedScan::Create(DB* db, const ReadOptions& read_options,
+                               ColumnFamilyHandle* column_family,
+                               const OptSlice& begin, const OptSlice& end,
+                               size_t num_partitions,
+                               std::unique_ptr<PartitionedScan>* scan) {
+  assert(db);
+  assert(scan);
+  if (column_family == nullptr) {
+    column_family = db->DefaultColumnFamily();
+  }
+  std::vector<std::string> boundaries;
+  Status s = db->GetScanPartitionBoundaries(read_options, column_family, begin,
+                                            end, num_partitions, &boundaries);
+  if (!s.ok()) {
+    return s;
+  }
+
+  std::unique_ptr<PartitionedScan> result(new PartitionedScan(db));
+  ReadOptions ro = read_options;
+  if (ro.snapshot == nullptr) {
+    result->snapshot_ = db->GetSnapshot();
+    if (result->snapshot_ == nullptr) {
+      return Status::NotSupported("Partitioned scans require snapshots");
+    }
+    ro.snapshot = result->snapshot_;
+  }
+  for (size_t i = 0; i <= boundaries.size(); ++i) {
+    std::unique_ptr<Partition> partition(new Partition());
+    if (i > 0) {
+      partition->lower_bound = std::move(boundaries[i - 1]);
+      partition->has_lower_bound = true;
+    } else if (begin) {
+      partition->lower_bound = begin->ToString();
+      partition->has_lower_bound = true;
+    }
+    if (i < boundaries.size()) {
+      // Also the lower bound of the next partition
+      partition->upper_bound = boundaries[i];
+      partition->has_upper_bound = true;
+    } else if (end) {
+      partition->upper_bound = end->ToString();
+      partition->has_upper_bound = true;
+    }
+    partition->lower_bound_slice = partition->lower_bound;
+    partition->upper_bound_slice = partition->upper_bound;
+    ro.iterate_lower_bound =
+        partition->has_lower_bound ? &partition->lower_bound_slice : nullptr;
+    ro.iterate_upper_bound =
+        partition->has_upper_bound ? &partition->upper_bound_slice : nullptr;
+    partition->iter.reset(db->NewIterator(ro, column_family));
+    result->partitions_.push_back(std::move(partition));
+  }
+  *scan = std::move(result);
+  return Status::OK();
+}
+
+PartitionedScan::PartitionedScan(DB* db) : db_(db) {}
+
+PartitionedScan::~PartitionedScan() {
+  // The iterators must go before the snapshot they read
+  partitions_.clear();
+  if (snapshot_ != nullptr) {
+    db_->ReleaseSnapshot(snapshot_);
+  }
+}
+
+OptSlice PartitionedScan::LowerBound(size_t i) const {
+  assert(i < partitions_.size());
+  const Partition& partition = *partitions_[i];
+  return partition.has_lower_bound ? OptSlice(partition.lower_bound_slice)
+                                   : OptSlice();
+}
+
+OptSlice PartitionedScan::UpperBound(size_t i) const {
+  assert(i < partitions_.size());
+  const Partition& partition = *partitions_[i];
+  return partition.has_upper_bound ? OptSlice(partition.upper_bound_slice)
+                                   : OptSlice();
+}
+
+Iterator* PartitionedScan::GetIterator(size_t i) const {
+  assert(i < partitions_.size());
+  return partitions_[i]->iter.get();
+}
+
+Status PartitionedScan::ForEach(
+    size_t num_threads,
+    const std::function<Status(size_t partition, Iterator* iter)>& fn) {
+  // Partitions are handed out dynamically, as their scan times can vary
+  // widely even if they hold the same amount of data.
+  std::atomic<size_t> next_partition{0};
+  std::atomic<bool> failed{false};
+  port::Mutex mutex;
+  Status result;
+  auto worker = [&]() {
+    while (!failed.load(std::memory_order_relaxed)) {
+      const size_t i = next_partition.fetch_add(1, std::memory_order_relaxed);
+      if (i >= partitions_.size()) {
+        break;
+      }
+      Status s = fn(i, partitions_[i]->iter.get());
+      if (!s.ok()) {
+        MutexLock lock(&mutex);
+        if (result.ok()) {
+          result = s;
+        }
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  num_threads = std::min(std::max(num_threads, size_t{1}), partitions_.size());
+  std::vector<port::Thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return result;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,138 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/point_lookup_cache.h"
+
+#include "cache/typed_cache.h"
+#include "monitoring/statistics_impl.h"
+#include "rocksdb/slice.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+using PointLookupCacheInterface =
+    BasicTypedCacheInterface<std::string, CacheEntryRole::kMisc>;
+
+// Entry: snapshot sequence number (fixed64), found (1 byte), value
+constexpr size_t kEntryHeaderSize = sizeof(uint64_t) + 1;
+
+constexpr size_t kNumStripes = 256;
+}  // namespace
+
+PointLookupCache::PointLookupCache(std::shared_ptr<Cache> cache)
+    : cache_(std::move(cache)), stripes_(kNumStripes) {
+  PutVarint64(&id_, cache_->NewId());
+}
+
+void PointLookupCache::AppendKey(uint64_t generation, uint32_t cf_id,
+                                 const Slice& user_key,
+                                 std::string* key) const {
+  key->append(id_);
+  PutVarint64(key, generation);
+  PutVarint32(key, cf_id);
+  key->append(user_key.data(), user_key.size());
+}
+
+bool PointLookupCache::Lookup(uint32_t cf_id, const Slice& user_key,
+                              SequenceNumber snapshot, PinnableSlice* value,
+                              bool* found, Statistics* stats) {
+  assert(value);
+  assert(found);
+  std::string key;
+  AppendKey(GetGeneration(), cf_id, user_key, &key);
+  PointLookupCacheInterface cache{cache_.get()};
+  auto handle = cache.Lookup(key);
+  if (handle != nullptr) {
+    const std::string& entry = *cache.Value(handle);
+    assert(entry.size() >= kEntryHeaderSize);
+    // An entry read after the snapshot may hold a newer version
+    if (DecodeFixed64(entry.data()) <= snapshot) {
+      *found = entry[sizeof(uint64_t)] != 0;
+      if (*found) {
+        Cleanable pinner;
+        cache.RegisterReleaseAsCleanup(handle, pinner);
+        value->PinSlice(Slice(entry.data() + kEntryHeaderSize,
+                              entry.size() - kEntryHeaderSize),
+                        &pinner);
+      } else {
+        cache.Release(handle);
+      }
+      RecordTick(stats, POINT_LOOKUP_CACHE_HIT);
+      return true;
+    }
+    cache.Release(handle);
+  }
+  RecordTick(stats, POINT_LOOKUP_CACHE_MISS);
+  return false;
+}
+
+void PointLookupCache::Insert(uint32_t cf_id, const Slice& user_key,
+                              uint64_t generation, SequenceNumber snapshot,
+                              bool found, const Slice& value) {
+  std::string key;
+  AppendKey(generation, cf_id, user_key, &key);
+  auto entry = std::make_unique<std::string>();
+  entry->reserve(kEntryHeaderSize + (found ? value.size() : 0));
+  PutFixed64(entry.get(), snapshot);
+  entry->push_back(found ? 1 : 0);
+  if (found) {
+    entry->append(value.data(), value.size());
+  }
+  const size_t charge = entry->capacity() + sizeof(std::string);
+
+  Stripe& stripe = stripes_.Get(user_key);
+  MutexLock l(&stripe.mutex);
+  if (stripe.last_write_seq > snapshot ||
+      num_active_invalidations_.load(std::memory_order_acquire) > 0 ||
+      generation_.load(std::memory_order_acquire) != generation ||
+      min_insert_seq_.load(std::memory_order_acquire) > snapshot) {
+    // The result might already be stale
+    return;
+  }
+  PointLookupCacheInterface cache{cache_.get()};
+  cache.Insert(key, entry.release(), charge).PermitUncheckedError();
+}
+
+void PointLookupCache::InvalidateKey(uint32_t cf_id, const Slice& user_key,
+                                     SequenceNumber seq) {
+  std::string key;
+  Stripe& stripe = stripes_.Get(user_key);
+  MutexLock l(&stripe.mutex);
+  if (seq > stripe.last_write_seq) {
+    stripe.last_write_seq = seq;
+  }
+  // Entries of earlier generations are unreachable anyway
+  AppendKey(GetGeneration(), cf_id, user_key, &key);
+  cache_->Erase(key);
+}
+
+void PointLookupCache::InvalidateAll(SequenceNumber seq) {
+  SequenceNumber min_seq = min_insert_seq_.load(std::memory_order_relaxed);
+  while (seq > min_seq && !min_insert_seq_.compare_exchange_weak(
+                              min_seq, seq, std::memory_order_acq_rel)) {
+  }
+  generation_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+PointLookupCache::ScopedInvalidation::ScopedInvalidation(
+    PointLookupCache* cache)
+    : cache_(cache) {
+  if (cache_ != nullptr) {
+    cache_->num_active_invalidations_.fetch_add(1, std::memory_order_acq_rel);
+    cache_->generation_.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
+PointLookupCache::ScopedInvalidation::~ScopedInvalidation() {
+  if (cache_ != nullptr) {
+    // Readers that started while the change was in progress must not insert
+    // once it is over
+    cache_->generation_.fetch_add(1, std::memory_order_acq_rel);
+    cache_->num_active_invalidations_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
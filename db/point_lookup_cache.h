@@ -0,0 +1,103 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "port/port.h"
+#include "rocksdb/cache.h"
+#include "rocksdb/types.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class PinnableSlice;
+class Statistics;
+
+// Results of DB::Get() for the latest data, including "not found", cached by
+// column family and user key (see DBOptions::point_lookup_cache), so that a
+// hit skips the memtables and SST files altogether.
+//
+// An entry records the snapshot sequence number S it was read at and stays
+// valid for reads at any sequence number >= S until the key is written
+// again. Writes keep the cache coherent from inside the write group, before
+// their sequence number is published:
+// * Each written key is erased, and the sequence number of the write is
+//   recorded in the key's lock stripe. A read at S only inserts its result
+//   if no write to its stripe with a sequence number > S has started, which
+//   is checked and acted on under the stripe lock.
+// * Writes that affect keys that are not known individually (range
+//   deletions, ingested WriteBatchWithIndex memtables) bump a generation
+//   that is part of every cache key, making all earlier entries unreachable,
+//   and raise the minimum snapshot that results may be inserted for.
+// * Changes that do not go through the write path (ingested or deleted
+//   files) are bracketed by a ScopedInvalidation, which bumps the generation
+//   and rejects all insertions while it is alive.
+// A reader captures the generation before reading and only inserts its
+// result if the generation has not changed since.
+class PointLookupCache {
+ public:
+  explicit PointLookupCache(std::shared_ptr<Cache> cache);
+
+  // To be called before acquiring the SuperVersion of a read whose result
+  // may be inserted.
+  uint64_t GetGeneration() const {
+    return generation_.load(std::memory_order_acquire);
+  }
+
+  // Looks up `user_key` for a read at `snapshot`. On a hit, sets `*found`
+  // and, if found, pins the value in `*value`.
+  bool Lookup(uint32_t cf_id, const Slice& user_key, SequenceNumber snapshot,
+              PinnableSlice* value, bool* found, Statistics* stats);
+
+  // Inserts the result of a read at `snapshot` that started at `generation`.
+  // `value` is ignored unless `found`.
+  void Insert(uint32_t cf_id, const Slice& user_key, uint64_t generation,
+              SequenceNumber snapshot, bool found, const Slice& value);
+
+  // Called from the write path for each key written at `seq`.
+  void InvalidateKey(uint32_t cf_id, const Slice& user_key,
+                     SequenceNumber seq);
+
+  // Called from the write path for writes at `seq` that may affect any key.
+  void InvalidateAll(SequenceNumber seq);
+
+  class ScopedInvalidation {
+   public:
+    // No-op if `cache` is null
+    explicit ScopedInvalidation(PointLookupCache* cache);
+    ~ScopedInvalidation();
+
+    ScopedInvalidation(const ScopedInvalidation&) = delete;
+    ScopedInvalidation& operator=(const ScopedInvalidation&) = delete;
+
+   private:
+    PointLookupCache* const cache_;
+  };
+
+ private:
+  struct Stripe {
+    port::Mutex mutex;
+    // Largest sequence number of a write to a key of this stripe
+    SequenceNumber last_write_seq = 0;
+  };
+
+  void AppendKey(uint64_t generation, uint32_t cf_id, const Slice& user_key,
+                 std::string* key) const;
+
+  const std::shared_ptr<Cache> cache_;
+  // Distinguishes the entries of this DB in a shared cache
+  std::string id_;
+  std::atomic<uint64_t> generation_{0};
+  // Results read at a lower sequence number are not inserted
+  std::atomic<SequenceNumber> min_insert_seq_{0};
+  std::atomic<uint32_t> num_active_invalidations_{0};
+  Striped<CacheAlignedWrapper<Stripe>> stripes_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
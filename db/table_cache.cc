@@ -67,7 +67,8 @@ TableCache::TableCache(const ImmutableOptions& ioptions,
                        const FileOptions* file_options, Cache* const cache,
                        BlockCacheTracer* const block_cache_tracer,
                        const std::shared_ptr<IOTracer>& io_tracer,
-                       const std::string& db_session_id)
+                       const std::string& db_session_id,
+                       BlockCacheHeatmap* block_cache_heatmap)
     : ioptions_(ioptions),
       file_options_(*file_options),
       cache_(cache),
@@ -75,7 +76,8 @@ TableCache::TableCache(const ImmutableOptions& ioptions,
       block_cache_tracer_(block_cache_tracer),
       loader_mutex_(kLoadConcurency),
       io_tracer_(io_tracer),
-      db_session_id_(db_session_id) {
+      db_session_id_(db_session_id),
+      block_cache_heatmap_(block_cache_heatmap) {
   if (ioptions_.row_cache) {
     // If the same cache is shared by multiple instances, we need to
     // disambiguate its entries.
@@ -143,18 +145,18 @@ Status TableCache::GetTableReader(
     } else {
       expected_unique_id = kNullUniqueId64x2;  // null ID == no verification
     }
+    TableReaderOptions table_reader_options(
+        ioptions_, mutable_cf_options.prefix_extractor, file_options,
+        internal_comparator, mutable_cf_options.block_protection_bytes_per_key,
+        skip_filters, immortal_tables_, false /* force_direct_prefetch */,
+        level, block_cache_tracer_, max_file_size_for_l0_meta_pin,
+        db_session_id_, file_meta.fd.GetNumber(), expected_unique_id,
+        file_meta.fd.largest_seqno, file_meta.tail_size,
+        file_meta.user_defined_timestamps_persisted);
+    table_reader_options.block_cache_heatmap = block_cache_heatmap_;
     s = mutable_cf_options.table_factory->NewTableReader(
-        ro,
-        TableReaderOptions(
-            ioptions_, mutable_cf_options.prefix_extractor, file_options,
-            internal_comparator,
-            mutable_cf_options.block_protection_bytes_per_key, skip_filters,
-            immortal_tables_, false /* force_direct_prefetch */, level,
-            block_cache_tracer_, max_file_size_for_l0_meta_pin, db_session_id_,
-            file_meta.fd.GetNumber(), expected_unique_id,
-            file_meta.fd.largest_seqno, file_meta.tail_size,
-            file_meta.user_defined_timestamps_persisted),
-        std::move(file_reader), file_meta.fd.GetFileSize(), table_reader,
+        ro, table_reader_options, std::move(file_reader),
+        file_meta.fd.GetFileSize(), table_reader,
         prefetch_index_and_filter_in_cache);
     TEST_SYNC_POINT("TableCache::GetTableReader:0");
   }
@@ -643,6 +645,29 @@ Status TableCache::ApproximateKeyAnchors(
   return s;
 }
 
+Status TableCache::GetCachedKeyRanges(
+    const ReadOptions& ro, const InternalKeyComparator& internal_comparator,
+    const FileMetaData& file_meta, const MutableCFOptions& mutable_cf_options,
+    std::vector<std::pair<std::string, std::string>>& ranges) {
+  Status s;
+  TableReader* t = file_meta.fd.table_reader;
+  TypedHandle* handle = nullptr;
+  if (t == nullptr) {
+    s = FindTable(ro, file_options_, internal_comparator, file_meta, &handle,
+                  mutable_cf_options);
+    if (s.ok()) {
+      t = cache_.Value(handle);
+    }
+  }
+  if (s.ok() && t != nullptr) {
+    s = t->GetCachedKeyRanges(ro, ranges);
+  }
+  if (handle != nullptr) {
+    cache_.Release(handle);
+  }
+  return s;
+}
+
 size_t TableCache::GetMemoryUsageByTableReader(
     const FileOptions& file_options, const ReadOptions& read_options,
     const InternalKeyComparator& internal_comparator,
@@ -31,6 +31,7 @@ namespace ROCKSDB_NAMESPACE {
 
 class Env;
 class Arena;
+class BlockCacheHeatmap;
 struct FileDescriptor;
 class GetContext;
 class HistogramImpl;
@@ -54,7 +55,8 @@ class TableCache {
              const FileOptions* storage_options, Cache* cache,
              BlockCacheTracer* const block_cache_tracer,
              const std::shared_ptr<IOTracer>& io_tracer,
-             const std::string& db_session_id);
+             const std::string& db_session_id,
+             BlockCacheHeatmap* block_cache_heatmap = nullptr);
   ~TableCache();
 
   // Cache interface for table cache
@@ -206,6 +208,12 @@ class TableCache {
                                const MutableCFOptions& mutable_cf_options,
                                std::vector<TableReader::Anchor>& anchors);
 
+  // See TableReader::GetCachedKeyRanges().
+  Status GetCachedKeyRanges(
+      const ReadOptions& ro, const InternalKeyComparator& internal_comparator,
+      const FileMetaData& file_meta, const MutableCFOptions& mutable_cf_options,
+      std::vector<std::pair<std::string, std::string>>& ranges);
+
   // Return total memory usage of the table reader of the file.
   // 0 if table reader of the file is not loaded.
   size_t GetMemoryUsageByTableReader(
@@ -287,6 +295,7 @@ class TableCache {
   Striped<CacheAlignedWrapper<port::Mutex>> loader_mutex_;
   std::shared_ptr<IOTracer> io_tracer_;
   std::string db_session_id_;
+  BlockCacheHeatmap* const block_cache_heatmap_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -1095,6 +1095,25 @@ class LevelIterator final : public InternalIterator {
 
   bool IsDeleteRangeSentinelKey() const override { return to_return_sentinel_; }
 
+  bool GetReusableDataBlock(const Slice* limit,
+                            ReusableDataBlock* block) override {
+    assert(Valid());
+    if (to_return_sentinel_) {
+      return false;
+    }
+    // The index key of the last block of a file can be a successor of its
+    // largest key, which the keys of the next file are not bound to exceed
+    if (file_index_ + 1 < flevel_->num_files) {
+      const Slice next_smallest =
+          ExtractUserKey(file_smallest_key(file_index_ + 1));
+      if (limit == nullptr ||
+          user_comparator_.Compare(next_smallest, *limit) < 0) {
+        return file_iter_.GetReusableDataBlock(&next_smallest, block);
+      }
+    }
+    return file_iter_.GetReusableDataBlock(limit, block);
+  }
+
   void SetRangeDelReadSeqno(SequenceNumber read_seq) override {
     read_seq_ = read_seq;
   }
@@ -2448,6 +2467,7 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
       max_covering_tombstone_seq, clock_, seq,
       merge_operator_ ? pinned_iters_mgr : nullptr, callback, is_blob_to_use,
       tracing_get_id, &blob_fetcher);
+  get_context.SetColumnProjection(read_options.column_projection);
 
   // Pin blocks that we read to hold merge operands
   if (merge_operator_) {
@@ -2635,6 +2655,7 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
         &iter->max_covering_tombstone_seq, clock_, nullptr,
         merge_operator_ ? &pinned_iters_mgr : nullptr, callback,
         &iter->is_blob_index, tracing_mget_id, &blob_fetcher);
+    get_ctx.back().SetColumnProjection(read_options.column_projection);
     // MergeInProgress status, if set, has been transferred to the get_context
     // state, so we set status to ok here. From now on, the iter status will
     // be used for IO errors, and get_context state will be used for any
@@ -4039,6 +4060,102 @@ void SortFileByOverlappingRatio(
       });
 }
 
+// Files of the sorted level `files` overlapping the user key range of `f`,
+// as [begin, end)
+std::pair<std::vector<FileMetaData*>::const_iterator,
+          std::vector<FileMetaData*>::const_iterator>
+OverlappingFilesInSortedLevel(const Comparator* ucmp,
+                              const std::vector<FileMetaData*>& files,
+                              const FileMetaData& f) {
+  const Slice smallest = f.smallest.user_key();
+  const Slice largest = f.largest.user_key();
+  auto begin = std::lower_bound(
+      files.begin(), files.end(), smallest,
+      [&](const FileMetaData* g, const Slice& key) {
+        return ucmp->CompareWithoutTimestamp(g->largest.user_key(), key) < 0;
+      });
+  auto end = begin;
+  while (end != files.end() && ucmp->CompareWithoutTimestamp(
+                                   (*end)->smallest.user_key(), largest) <= 0) {
+    ++end;
+  }
+  return {begin, end};
+}
+
+// Sort `temp` by the sampled reads of each file times the number of other
+// sorted runs overlapping its key range, per byte compacted into the next
+// level, highest first. Ties, notably files that are not read, are broken as
+// in SortFileByOverlappingRatio.
+void SortFileByReadHeat(const InternalKeyComparator& icmp,
+                        const std::vector<FileMetaData*>* level_files,
+                        int num_levels, int level, std::vector<Fsize>* temp) {
+  const Comparator* ucmp = icmp.user_comparator();
+  struct Order {
+    double read_heat = 0;
+    uint64_t overlapping_ratio = 0;
+  };
+  std::unordered_map<uint64_t, Order> file_to_order;
+  for (const Fsize& fsize : *temp) {
+    const FileMetaData& f = *fsize.file;
+    uint64_t overlapping_bytes = 0;
+    if (level + 1 < num_levels) {
+      auto range =
+          OverlappingFilesInSortedLevel(ucmp, level_files[level + 1], f);
+      for (auto it = range.first; it != range.second; ++it) {
+        overlapping_bytes += (*it)->fd.file_size;
+      }
+    }
+    // Sorted runs other than `f` that lookups in its key range may check
+    uint64_t other_runs = 0;
+    for (const FileMetaData* g : level_files[0]) {
+      if (g != &f &&
+          ucmp->CompareWithoutTimestamp(g->largest.user_key(),
+                                        f.smallest.user_key()) >= 0 &&
+          ucmp->CompareWithoutTimestamp(g->smallest.user_key(),
+                                        f.largest.user_key()) <= 0) {
+        ++other_runs;
+      }
+    }
+    for (int l = 1; l < num_levels; ++l) {
+      if (l != level) {
+        auto range = OverlappingFilesInSortedLevel(ucmp, level_files[l], f);
+        other_runs += range.first != range.second ? 1 : 0;
+      }
+    }
+    const uint64_t num_reads =
+        f.stats.num_reads_sampled.load(std::memory_order_relaxed);
+    assert(f.compensated_file_size != 0);
+    Order& order = file_to_order[f.fd.GetNumber()];
+    order.read_heat = static_cast<double>(num_reads * other_runs) /
+                      static_cast<double>(f.compensated_file_size +
+                                          overlapping_bytes);
+    order.overlapping_ratio =
+        overlapping_bytes * 1024U / f.compensated_file_size;
+  }
+
+  size_t num_to_sort = temp->size() > VersionStorageInfo::kNumberFilesToSort
+                           ? VersionStorageInfo::kNumberFilesToSort
+                           : temp->size();
+
+  std::partial_sort(
+      temp->begin(), temp->begin() + num_to_sort, temp->end(),
+      [&](const Fsize& f1, const Fsize& f2) -> bool {
+        if (f1.file->marked_for_compaction != f2.file->marked_for_compaction) {
+          return f1.file->marked_for_compaction >
+                 f2.file->marked_for_compaction;
+        }
+        const Order& o1 = file_to_order[f1.file->fd.GetNumber()];
+        const Order& o2 = file_to_order[f2.file->fd.GetNumber()];
+        if (o1.read_heat != o2.read_heat) {
+          return o1.read_heat > o2.read_heat;
+        }
+        if (o1.overlapping_ratio != o2.overlapping_ratio) {
+          return o1.overlapping_ratio < o2.overlapping_ratio;
+        }
+        return icmp.Compare(f1.file->smallest, f2.file->smallest) < 0;
+      });
+}
+
 void SortFileByRoundRobin(const InternalKeyComparator& icmp,
                           std::vector<InternalKey>* compact_cursor,
                           bool level0_non_overlapping, int level,
@@ -4149,6 +4266,10 @@ void VersionStorageInfo::UpdateFilesByCompactionPri(
         SortFileByRoundRobin(*internal_comparator_, &compact_cursor_,
                              level0_non_overlapping_, level, &temp);
         break;
+      case kByReadHeat:
+        SortFileByReadHeat(*internal_comparator_, files_, num_levels(), level,
+                           &temp);
+        break;
       default:
         assert(false);
     }
@@ -5319,6 +5440,23 @@ void VersionSet::AppendVersion(ColumnFamilyData* column_family_data,
   v->next_->prev_ = v;
 }
 
+void VersionSet::UpdateBlockCacheHeatmap(ColumnFamilyData* cfd,
+                                         const VersionEdit& edit) {
+  BlockCacheHeatmap* heatmap = cfd->internal_stats()->GetBlockCacheHeatmap();
+  std::unordered_map<uint64_t, int> new_file_levels;
+  for (const auto& new_file : edit.GetNewFiles()) {
+    new_file_levels[new_file.second.fd.GetNumber()] = new_file.first;
+  }
+  for (const auto& deleted_file : edit.GetDeletedFiles()) {
+    auto it = new_file_levels.find(deleted_file.second);
+    if (it != new_file_levels.end()) {
+      heatmap->OnFileMoved(it->first, it->second);
+    } else {
+      heatmap->OnFileDeleted(deleted_file.second);
+    }
+  }
+}
+
 Status VersionSet::ProcessManifestWrites(
     std::deque<ManifestWriter>& writers, InstrumentedMutex* mu,
     FSDirectory* dir_contains_current_file, bool new_descriptor_log,
@@ -5814,6 +5952,7 @@ Status VersionSet::ProcessManifestWrites(
           if (e->HasFullHistoryTsLow()) {
             cfd->SetFullHistoryTsLow(e->GetFullHistoryTsLow());
           }
+          UpdateBlockCacheHeatmap(cfd, *e);
         }
         if (e->HasMinLogNumberToKeep()) {
           last_min_log_number_to_keep =
@@ -1638,6 +1638,11 @@ class VersionSet {
 
   void AppendVersion(ColumnFamilyData* column_family_data, Version* v);
 
+  // Keeps the block cache heatmap of `cfd` in sync with the files moved and
+  // deleted by `edit`
+  static void UpdateBlockCacheHeatmap(ColumnFamilyData* cfd,
+                                      const VersionEdit& edit);
+
   ColumnFamilyData* CreateColumnFamily(const ColumnFamilyOptions& cf_options,
                                        const ReadOptions& read_options,
                                        const VersionEdit* edit, bool read_only);
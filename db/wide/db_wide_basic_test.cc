@@ -236,6 +236,107 @@ TEST_F(DBWideBasicTest, PutEntityColumnFamily) {
   ASSERT_OK(db_->Write(WriteOptions(), &batch));
 }
 
+TEST_F(DBWideBasicTest, ColumnProjection) {
+  Options options = GetDefaultOptions();
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  Reopen(options);
+
+  constexpr char first_key[] = "first";
+  WideColumns first_columns{{kDefaultWideColumnName, "hello"},
+                            {"attr_a", "a1"},
+                            {"attr_b", "b1"},
+                            {"attr_c", "c1"}};
+
+  constexpr char second_key[] = "second";
+  constexpr char second_value[] = "value";
+
+  constexpr char third_key[] = "third";
+  WideColumns third_columns{{"attr_a", "a3"}, {"attr_c", "c3"}};
+  constexpr char third_merge_operand[] = "m";
+  // The merge operand is appended to the empty default column of the entity
+  constexpr char third_merge_result[] = ",m";
+
+  ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                           first_key, first_columns));
+  ASSERT_OK(db_->Put(WriteOptions(), second_key, second_value));
+  ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                           third_key, third_columns));
+  ASSERT_OK(db_->Merge(WriteOptions(), db_->DefaultColumnFamily(), third_key,
+                       third_merge_operand));
+
+  auto verify = [&](const std::vector<Slice>& projection,
+                    const std::array<WideColumns, 3>& expected) {
+    ReadOptions read_options;
+    read_options.column_projection = &projection;
+
+    const std::array<Slice, 3> keys{{first_key, second_key, third_key}};
+    for (size_t i = 0; i < keys.size(); ++i) {
+      PinnableWideColumns result;
+      ASSERT_OK(db_->GetEntity(read_options, db_->DefaultColumnFamily(),
+                               keys[i], &result));
+      ASSERT_EQ(result.columns(), expected[i]);
+    }
+
+    {
+      std::array<PinnableWideColumns, 3> results;
+      std::array<Status, 3> statuses;
+      db_->MultiGetEntity(read_options, db_->DefaultColumnFamily(),
+                          keys.size(), keys.data(), results.data(),
+                          statuses.data());
+      for (size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_OK(statuses[i]);
+        ASSERT_EQ(results[i].columns(), expected[i]);
+      }
+    }
+
+    {
+      // value() is not affected by the projection
+      const std::array<Slice, 3> expected_values{
+          {"hello", second_value, third_merge_result}};
+      std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+      size_t i = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++i) {
+        ASSERT_EQ(iter->key(), keys[i]);
+        ASSERT_EQ(iter->value(), expected_values[i]);
+        ASSERT_EQ(iter->columns(), expected[i]);
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(i, keys.size());
+    }
+  };
+
+  auto verify_all = [&]() {
+    verify({"attr_c", "attr_a", "attr_x"},
+           {{WideColumns{{"attr_a", "a1"}, {"attr_c", "c1"}}, WideColumns{},
+             WideColumns{{"attr_a", "a3"}, {"attr_c", "c3"}}}});
+    verify({kDefaultWideColumnName},
+           {{WideColumns{{kDefaultWideColumnName, "hello"}},
+             WideColumns{{kDefaultWideColumnName, second_value}},
+             WideColumns{{kDefaultWideColumnName, third_merge_result}}}});
+    verify({}, {});
+  };
+
+  // Try reading from memtable
+  verify_all();
+
+  // Try reading from storage
+  ASSERT_OK(Flush());
+  verify_all();
+
+  // Try reading a merge result where the base value is in storage
+  ASSERT_OK(db_->Merge(WriteOptions(), db_->DefaultColumnFamily(), first_key,
+                       "x"));
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  first_columns[0].value() = "hello,x";
+  ReadOptions read_options;
+  const std::vector<Slice> projection{"attr_b"};
+  read_options.column_projection = &projection;
+  PinnableWideColumns result;
+  ASSERT_OK(db_->GetEntity(read_options, db_->DefaultColumnFamily(), first_key,
+                           &result));
+  ASSERT_EQ(result.columns(), (WideColumns{{"attr_b", "b1"}}));
+}
+
 TEST_F(DBWideBasicTest, GetEntityAsPinnableAttributeGroups) {
   Options options = GetDefaultOptions();
   CreateAndReopenWithCF({"hot_cf", "cold_cf"}, options);
@@ -66,6 +66,16 @@ Status WideColumnSerialization::Serialize(const WideColumns& columns,
 
 Status WideColumnSerialization::Deserialize(Slice& input,
                                             WideColumns& columns) {
+  return DeserializeImpl(input, nullptr, columns);
+}
+
+Status WideColumnSerialization::Deserialize(
+    Slice& input, const std::vector<Slice>& projection, WideColumns& columns) {
+  return DeserializeImpl(input, &projection, columns);
+}
+
+Status WideColumnSerialization::DeserializeImpl(
+    Slice& input, const std::vector<Slice>* projection, WideColumns& columns) {
   assert(columns.empty());
 
   uint32_t version = 0;
@@ -86,22 +96,35 @@ Status WideColumnSerialization::Deserialize(Slice& input,
     return Status::OK();
   }
 
-  columns.reserve(num_columns);
+  if (!projection) {
+    columns.reserve(num_columns);
+  }
 
   autovector<uint32_t, 16> column_value_sizes;
   column_value_sizes.reserve(num_columns);
-
+  // Whether each column is returned, when projecting
+  autovector<uint8_t, 16> column_projected;
+
+  // A sorted projection is matched against the sorted names in one pass
+  const bool sorted_projection =
+      projection != nullptr &&
+      std::is_sorted(projection->begin(), projection->end(),
+                     [](const Slice& lhs, const Slice& rhs) {
+                       return lhs.compare(rhs) < 0;
+                     });
+  size_t projection_pos = 0;
+
+  Slice prev_name;
   for (uint32_t i = 0; i < num_columns; ++i) {
     Slice name;
     if (!GetLengthPrefixedSlice(&input, &name)) {
       return Status::Corruption("Error decoding wide column name");
     }
 
-    if (!columns.empty() && columns.back().name().compare(name) >= 0) {
+    if (i > 0 && prev_name.compare(name) >= 0) {
       return Status::Corruption("Wide columns out of order");
     }
-
-    columns.emplace_back(name, Slice());
+    prev_name = name;
 
     uint32_t value_size = 0;
     if (!GetVarint32(&input, &value_size)) {
@@ -109,10 +132,32 @@ Status WideColumnSerialization::Deserialize(Slice& input,
     }
 
     column_value_sizes.emplace_back(value_size);
+
+    if (projection) {
+      bool projected = false;
+      if (sorted_projection) {
+        while (projection_pos < projection->size() &&
+               (*projection)[projection_pos].compare(name) < 0) {
+          ++projection_pos;
+        }
+        projected = projection_pos < projection->size() &&
+                    (*projection)[projection_pos] == name;
+      } else {
+        projected = std::find(projection->begin(), projection->end(), name) !=
+                    projection->end();
+      }
+      column_projected.emplace_back(projected ? 1 : 0);
+      if (!projected) {
+        continue;
+      }
+    }
+
+    columns.emplace_back(name, Slice());
   }
 
   const Slice data(input);
   size_t pos = 0;
+  size_t column_idx = 0;
 
   for (uint32_t i = 0; i < num_columns; ++i) {
     const uint32_t value_size = column_value_sizes[i];
@@ -121,7 +166,9 @@ Status WideColumnSerialization::Deserialize(Slice& input,
       return Status::Corruption("Error decoding wide column value payload");
     }
 
-    columns[i].value() = Slice(data.data() + pos, value_size);
+    if (!projection || column_projected[i] != 0) {
+      columns[column_idx++].value() = Slice(data.data() + pos, value_size);
+    }
 
     pos += value_size;
   }
@@ -148,4 +195,57 @@ Status WideColumnSerialization::GetValueOfDefaultColumn(Slice& input,
   return Status::OK();
 }
 
+Status WideColumnSerialization::GetValueOfColumn(Slice& input,
+                                                 const Slice& column_name,
+                                                 Slice& value, bool& found) {
+  found = false;
+
+  uint32_t version = 0;
+  if (!GetVarint32(&input, &version)) {
+    return Status::Corruption("Error decoding wide column version");
+  }
+
+  if (version > kCurrentVersion) {
+    return Status::NotSupported("Unsupported wide column version");
+  }
+
+  uint32_t num_columns = 0;
+  if (!GetVarint32(&input, &num_columns)) {
+    return Status::Corruption("Error decoding number of wide columns");
+  }
+
+  // The values start after the index, so the index is parsed in full
+  uint64_t value_offset = 0;
+  uint32_t value_size = 0;
+  uint64_t total_value_size = 0;
+  for (uint32_t i = 0; i < num_columns; ++i) {
+    Slice name;
+    if (!GetLengthPrefixedSlice(&input, &name)) {
+      return Status::Corruption("Error decoding wide column name");
+    }
+
+    uint32_t size = 0;
+    if (!GetVarint32(&input, &size)) {
+      return Status::Corruption("Error decoding wide column value size");
+    }
+
+    if (!found && name == column_name) {
+      found = true;
+      value_offset = total_value_size;
+      value_size = size;
+    }
+    total_value_size += size;
+  }
+
+  if (total_value_size > input.size()) {
+    return Status::Corruption("Error decoding wide column value payload");
+  }
+
+  if (found) {
+    value = Slice(input.data() + value_offset, value_size);
+  }
+
+  return Status::OK();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
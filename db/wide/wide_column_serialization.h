@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/status.h"
@@ -46,10 +47,25 @@ class WideColumnSerialization {
   static Status Serialize(const WideColumns& columns, std::string& output);
 
   static Status Deserialize(Slice& input, WideColumns& columns);
+  // Same as above but only returns the columns whose names are in
+  // `projection`. The index still has to be parsed in full, but no other
+  // column is materialized.
+  static Status Deserialize(Slice& input, const std::vector<Slice>& projection,
+                            WideColumns& columns);
 
   static Status GetValueOfDefaultColumn(Slice& input, Slice& value);
 
+  // Finds the value of the column `column_name` without materializing the
+  // other columns. Sets `found` to false if there is no such column.
+  static Status GetValueOfColumn(Slice& input, const Slice& column_name,
+                                 Slice& value, bool& found);
+
   static constexpr uint32_t kCurrentVersion = 1;
+
+ private:
+  static Status DeserializeImpl(Slice& input,
+                                const std::vector<Slice>* projection,
+                                WideColumns& columns);
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -126,6 +126,74 @@ TEST(WideColumnSerializationTest, SerializeDeserialize) {
   }
 }
 
+TEST(WideColumnSerializationTest, DeserializeProjection) {
+  WideColumns columns{{kDefaultWideColumnName, "def"},
+                      {"a", "1"},
+                      {"b", ""},
+                      {"c", "333"},
+                      {"d", "4444"}};
+  std::string output;
+
+  ASSERT_OK(WideColumnSerialization::Serialize(columns, output));
+
+  auto deserialize = [&](const std::vector<Slice>& projection) {
+    Slice input(output);
+    WideColumns deserialized_columns;
+    EXPECT_OK(WideColumnSerialization::Deserialize(input, projection,
+                                                   deserialized_columns));
+    return deserialized_columns;
+  };
+
+  // Sorted, unsorted, with duplicates and names not in the entity
+  ASSERT_EQ(deserialize({"b", "d"}), (WideColumns{{"b", ""}, {"d", "4444"}}));
+  ASSERT_EQ(deserialize({"d", "x", "b", "d"}),
+            (WideColumns{{"b", ""}, {"d", "4444"}}));
+  ASSERT_EQ(deserialize({kDefaultWideColumnName, "c"}),
+            (WideColumns{{kDefaultWideColumnName, "def"}, {"c", "333"}}));
+  ASSERT_EQ(deserialize({"a", "b", "c", "d", kDefaultWideColumnName}), columns);
+  ASSERT_TRUE(deserialize({}).empty());
+  ASSERT_TRUE(deserialize({"e"}).empty());
+
+  // Corruption in columns that are not projected is still detected
+  std::string truncated = output.substr(0, output.size() - 1);
+  Slice input(truncated);
+  WideColumns deserialized_columns;
+  ASSERT_TRUE(WideColumnSerialization::Deserialize(
+                  input, std::vector<Slice>{"a"}, deserialized_columns)
+                  .IsCorruption());
+}
+
+TEST(WideColumnSerializationTest, GetValueOfColumn) {
+  WideColumns columns{
+      {kDefaultWideColumnName, "def"}, {"a", "1"}, {"c", "333"}};
+  std::string output;
+
+  ASSERT_OK(WideColumnSerialization::Serialize(columns, output));
+
+  auto get = [&](const Slice& column_name, Slice* value) {
+    Slice input(output);
+    bool found = false;
+    EXPECT_OK(WideColumnSerialization::GetValueOfColumn(input, column_name,
+                                                        *value, found));
+    return found;
+  };
+
+  Slice value;
+  ASSERT_TRUE(get("c", &value));
+  ASSERT_EQ(value, "333");
+  ASSERT_TRUE(get(kDefaultWideColumnName, &value));
+  ASSERT_EQ(value, "def");
+  ASSERT_FALSE(get("b", &value));
+  ASSERT_FALSE(get("d", &value));
+
+  std::string truncated = output.substr(0, output.size() - 1);
+  Slice input(truncated);
+  bool found = false;
+  ASSERT_TRUE(
+      WideColumnSerialization::GetValueOfColumn(input, "a", value, found)
+          .IsCorruption());
+}
+
 TEST(WideColumnSerializationTest, SerializeDuplicateError) {
   WideColumns columns{{"foo", "bar"}, {"foo", "baz"}};
   std::string output;
@@ -8,6 +8,7 @@
 #include <ios>
 
 #include "db/wide/wide_column_serialization.h"
+#include "rocksdb/options.h"
 
 namespace ROCKSDB_NAMESPACE {
 void WideColumnsHelper::DumpWideColumns(const WideColumns& columns,
@@ -41,4 +42,83 @@ Status WideColumnsHelper::DumpSliceAsWideColumns(const Slice& value,
   return s;
 }
 
+Status WideColumnsHelper::SetProjectedWideColumnValue(
+    const Slice& entity, const std::vector<Slice>& projection,
+    PinnableWideColumns& columns) {
+  Slice input = entity;
+  WideColumns projected;
+  Status s = WideColumnSerialization::Deserialize(input, projection, projected);
+  if (!s.ok()) {
+    return s;
+  }
+
+  std::string output;
+  s = WideColumnSerialization::Serialize(projected, output);
+  if (!s.ok()) {
+    return s;
+  }
+
+  return columns.SetWideColumnValue(std::move(output));
+}
+
+void WideColumnsHelper::SetProjectedPlainValue(
+    const Slice& value, Cleanable* cleanable,
+    const std::vector<Slice>& projection, PinnableWideColumns& columns) {
+  if (!IsProjected(projection, kDefaultWideColumnName)) {
+    columns.Reset();
+    return;
+  }
+
+  columns.SetPlainValue(value, cleanable);
+}
+
+Status WideColumnsHelper::ProjectColumns(const std::vector<Slice>& projection,
+                                         PinnableWideColumns& columns) {
+  const WideColumns& current = columns.columns();
+  if (std::all_of(current.begin(), current.end(),
+                  [&](const WideColumn& column) {
+                    return IsProjected(projection, column.name());
+                  })) {
+    return Status::OK();
+  }
+
+  WideColumns projected;
+  for (const auto& column : current) {
+    if (IsProjected(projection, column.name())) {
+      projected.push_back(column);
+    }
+  }
+
+  std::string output;
+  const Status s = WideColumnSerialization::Serialize(projected, output);
+  if (!s.ok()) {
+    return s;
+  }
+
+  return columns.SetWideColumnValue(std::move(output));
+}
+
+bool WideColumnsHelper::PlainValueMatches(const ScanPredicate& predicate,
+                                          const Slice& value) {
+  return predicate.column_name == kDefaultWideColumnName &&
+         predicate.Matches(value);
+}
+
+Status WideColumnsHelper::EntityMatches(const ScanPredicate& predicate,
+                                        const Slice& entity, bool* matches) {
+  assert(matches);
+
+  Slice input = entity;
+  Slice value;
+  bool found = false;
+  const Status s = WideColumnSerialization::GetValueOfColumn(
+      input, predicate.column_name, value, found);
+  if (!s.ok()) {
+    return s;
+  }
+
+  *matches = found && predicate.Matches(value);
+  return Status::OK();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
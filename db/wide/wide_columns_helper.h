@@ -8,12 +8,15 @@
 #include <algorithm>
 #include <cassert>
 #include <ostream>
+#include <vector>
 
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/wide_columns.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+struct ScanPredicate;
+
 class WideColumnsHelper {
  public:
   static void DumpWideColumns(const WideColumns& columns, std::ostream& os,
@@ -36,6 +39,42 @@ class WideColumnsHelper {
     return columns.front().value();
   }
 
+  static bool IsProjected(const std::vector<Slice>& projection,
+                          const Slice& column_name) {
+    return std::find(projection.begin(), projection.end(), column_name) !=
+           projection.end();
+  }
+
+  // Sets `columns` to the columns of the serialized entity `entity` that are
+  // in `projection` (see ReadOptions::column_projection). Unlike
+  // SetWideColumnValue(), this does not pin `entity`: the projected columns
+  // are serialized again into a buffer owned by `columns`, so the result
+  // costs one copy of the projected columns and no reference to the block
+  // holding `entity`.
+  static Status SetProjectedWideColumnValue(
+      const Slice& entity, const std::vector<Slice>& projection,
+      PinnableWideColumns& columns);
+
+  // Sets `columns` to the plain value `value` if the default column is in
+  // `projection`, and to no columns otherwise.
+  static void SetProjectedPlainValue(const Slice& value, Cleanable* cleanable,
+                                     const std::vector<Slice>& projection,
+                                     PinnableWideColumns& columns);
+
+  // Drops the columns of `columns` that are not in `projection`, e.g. after
+  // a merge. A no-op when all columns are projected already.
+  static Status ProjectColumns(const std::vector<Slice>& projection,
+                               PinnableWideColumns& columns);
+
+  // Whether the plain value `value` satisfies `predicate` (see
+  // ReadOptions::scan_predicate).
+  static bool PlainValueMatches(const ScanPredicate& predicate,
+                                const Slice& value);
+
+  // Same as above for the serialized entity `entity`.
+  static Status EntityMatches(const ScanPredicate& predicate,
+                              const Slice& entity, bool* matches);
+
   static void SortColumns(WideColumns& columns) {
     std::sort(columns.begin(), columns.end(),
               [](const WideColumn& lhs, const WideColumn& rhs) {
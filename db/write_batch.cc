@@ -92,6 +92,8 @@ enum ContentFlags : uint32_t {
   HAS_BEGIN_UNPREPARE = 1 << 11,
   HAS_PUT_ENTITY = 1 << 12,
   HAS_TIMED_PUT = 1 << 13,
+  // Not derived from the contents, see ComputeContentFlags()
+  HAS_REFERENCED_VALUE = 1 << 14,
 };
 
 struct BatchContentClassifier : public WriteBatch::Handler {
@@ -203,6 +205,7 @@ WriteBatch::WriteBatch(const WriteBatch& src)
     : wal_term_point_(src.wal_term_point_),
       content_flags_(src.content_flags_.load(std::memory_order_relaxed)),
       max_bytes_(src.max_bytes_),
+      referenced_value_bytes_(src.referenced_value_bytes_),
       default_cf_ts_sz_(src.default_cf_ts_sz_),
       rep_(src.rep_) {
   if (src.save_points_ != nullptr) {
@@ -220,6 +223,7 @@ WriteBatch::WriteBatch(WriteBatch&& src) noexcept
       wal_term_point_(std::move(src.wal_term_point_)),
       content_flags_(src.content_flags_.load(std::memory_order_relaxed)),
       max_bytes_(src.max_bytes_),
+      referenced_value_bytes_(src.referenced_value_bytes_),
       prot_info_(std::move(src.prot_info_)),
       default_cf_ts_sz_(src.default_cf_ts_sz_),
       rep_(std::move(src.rep_)) {}
@@ -256,6 +260,7 @@ void WriteBatch::Clear() {
   rep_.resize(WriteBatchInternal::kHeader);
 
   content_flags_.store(0, std::memory_order_relaxed);
+  referenced_value_bytes_ = 0;
 
   if (save_points_ != nullptr) {
     while (!save_points_->stack.empty()) {
@@ -278,7 +283,8 @@ uint32_t WriteBatch::ComputeContentFlags() const {
     BatchContentClassifier classifier;
     // Should we handle status here?
     Iterate(&classifier).PermitUncheckedError();
-    rv = classifier.content_flags;
+    rv = classifier.content_flags |
+         (rv & ContentFlags::HAS_REFERENCED_VALUE);
 
     // this method is conceptually const, because it is performing a lazy
     // computation that doesn't affect the abstract state of the batch.
@@ -290,7 +296,7 @@ uint32_t WriteBatch::ComputeContentFlags() const {
 }
 
 void WriteBatch::MarkWalTerminationPoint() {
-  wal_term_point_.size = GetDataSize();
+  wal_term_point_.size = rep_.size();
   wal_term_point_.count = Count();
   wal_term_point_.content_flags = content_flags_;
 }
@@ -372,7 +378,8 @@ bool WriteBatch::HasRollback() const {
 Status ReadRecordFromWriteBatch(Slice* input, char* tag,
                                 uint32_t* column_family, Slice* key,
                                 Slice* value, Slice* blob, Slice* xid,
-                                uint64_t* write_unix_time) {
+                                uint64_t* write_unix_time,
+                                bool allow_value_references) {
   assert(key != nullptr && value != nullptr);
   *tag = (*input)[0];
   input->remove_prefix(1);
@@ -389,6 +396,32 @@ Status ReadRecordFromWriteBatch(Slice* input, char* tag,
         return Status::Corruption("bad WriteBatch Put");
       }
       break;
+    case kTypeColumnFamilyValueReference:
+      if (!allow_value_references) {
+        return Status::Corruption("unexpected WriteBatch value reference");
+      }
+      if (!GetVarint32(input, column_family)) {
+        return Status::Corruption("bad WriteBatch Put");
+      }
+      FALLTHROUGH_INTENDED;
+    case kTypeValueReference: {
+      if (!allow_value_references) {
+        return Status::Corruption("unexpected WriteBatch value reference");
+      }
+      uint32_t value_size = 0;
+      uint64_t value_address = 0;
+      if (!GetLengthPrefixedSlice(input, key) ||
+          !GetVarint32(input, &value_size) ||
+          !GetFixed64(input, &value_address)) {
+        return Status::Corruption("bad WriteBatch Put");
+      }
+      *value = Slice(reinterpret_cast<const char*>(
+                         static_cast<uintptr_t>(value_address)),
+                     value_size);
+      // Otherwise the same as a regular Put
+      *tag = *tag == kTypeValueReference ? kTypeValue : kTypeColumnFamilyValue;
+      break;
+    }
     case kTypeColumnFamilyDeletion:
     case kTypeColumnFamilySingleDeletion:
       if (!GetVarint32(input, column_family)) {
@@ -543,6 +576,7 @@ Status WriteBatchInternal::Iterate(const WriteBatch* wb,
   uint32_t column_family = 0;  // default
   bool last_was_try_again = false;
   bool handler_continue = true;
+  const bool has_referenced_values = HasReferencedValues(wb);
   while (((s.ok() && !input.empty()) || UNLIKELY(s.IsTryAgain()))) {
     handler_continue = handler->Continue();
     if (!handler_continue) {
@@ -555,7 +589,8 @@ Status WriteBatchInternal::Iterate(const WriteBatch* wb,
       column_family = 0;  // default
 
       s = ReadRecordFromWriteBatch(&input, &tag, &column_family, &key, &value,
-                                   &blob, &xid, &write_unix_time);
+                                   &blob, &xid, &write_unix_time,
+                                   has_referenced_values);
       if (!s.ok()) {
         return s;
       }
@@ -888,6 +923,49 @@ Status WriteBatchInternal::Put(WriteBatch* b, uint32_t column_family_id,
   return save.commit();
 }
 
+Status WriteBatchInternal::PutReferenced(WriteBatch* b,
+                                         uint32_t column_family_id,
+                                         const Slice& key, const Slice& value) {
+  if (key.size() > size_t{std::numeric_limits<uint32_t>::max()}) {
+    return Status::InvalidArgument("key is too large");
+  }
+  if (value.size() > size_t{std::numeric_limits<uint32_t>::max()}) {
+    return Status::InvalidArgument("value is too large");
+  }
+
+  LocalSavePoint save(b);
+  WriteBatchInternal::SetCount(b, WriteBatchInternal::Count(b) + 1);
+  if (column_family_id == 0) {
+    b->rep_.push_back(static_cast<char>(kTypeValueReference));
+  } else {
+    b->rep_.push_back(static_cast<char>(kTypeColumnFamilyValueReference));
+    PutVarint32(&b->rep_, column_family_id);
+  }
+  PutLengthPrefixedSlice(&b->rep_, key);
+  // The value length as for a regular Put, followed by the value's address
+  // in place of its bytes. AppendResolvedContents() relies on the address being
+  // the last field of the record.
+  PutVarint32(&b->rep_, static_cast<uint32_t>(value.size()));
+  PutFixed64(&b->rep_, static_cast<uint64_t>(
+                           reinterpret_cast<uintptr_t>(value.data())));
+  b->content_flags_.store(b->content_flags_.load(std::memory_order_relaxed) |
+                              ContentFlags::HAS_PUT |
+                              ContentFlags::HAS_REFERENCED_VALUE,
+                          std::memory_order_relaxed);
+  if (b->prot_info_ != nullptr) {
+    // See comment in WriteBatchInternal::Put() for why the optype is
+    // `kTypeValue`.
+    b->prot_info_->entries_.emplace_back(ProtectionInfo64()
+                                             .ProtectKVO(key, value, kTypeValue)
+                                             .ProtectC(column_family_id));
+  }
+  Status s = save.commit();
+  if (s.ok()) {
+    b->referenced_value_bytes_ += value.size();
+  }
+  return s;
+}
+
 Status WriteBatchInternal::TimedPut(WriteBatch* b, uint32_t column_family_id,
                                     const Slice& key, const Slice& value,
                                     uint64_t write_unix_time) {
@@ -960,6 +1038,26 @@ Status WriteBatch::Put(ColumnFamilyHandle* column_family, const Slice& key,
   return s;
 }
 
+Status WriteBatch::PutReferenced(ColumnFamilyHandle* column_family,
+                                 const Slice& key, const Slice& value) {
+  size_t ts_sz = 0;
+  uint32_t cf_id = 0;
+  Status s;
+
+  std::tie(s, cf_id, ts_sz) =
+      WriteBatchInternal::GetColumnFamilyIdAndTimestampSize(this,
+                                                            column_family);
+
+  if (!s.ok()) {
+    return s;
+  } else if (ts_sz != 0) {
+    return Status::NotSupported(
+        "PutReferenced is not supported in combination with user-defined "
+        "timestamps.");
+  }
+  return WriteBatchInternal::PutReferenced(this, cf_id, key, value);
+}
+
 Status WriteBatch::TimedPut(ColumnFamilyHandle* column_family, const Slice& key,
                             const Slice& value, uint64_t write_unix_time) {
   size_t ts_sz = 0;
@@ -1826,7 +1924,7 @@ void WriteBatch::SetSavePoint() {
   }
   // Record length and count of current batch of writes.
   save_points_->stack.push(SavePoint(
-      GetDataSize(), Count(), content_flags_.load(std::memory_order_relaxed)));
+      rep_.size(), Count(), content_flags_.load(std::memory_order_relaxed)));
 }
 
 Status WriteBatch::RollbackToSavePoint() {
@@ -1853,6 +1951,10 @@ Status WriteBatch::RollbackToSavePoint() {
     }
     WriteBatchInternal::SetCount(this, savepoint.count);
     content_flags_.store(savepoint.content_flags, std::memory_order_relaxed);
+    if (referenced_value_bytes_ > 0) {
+      referenced_value_bytes_ =
+          WriteBatchInternal::ComputeReferencedValueBytes(this, rep_.size());
+    }
   }
 
   return Status::OK();
@@ -1899,7 +2001,8 @@ Status WriteBatch::VerifyChecksum() const {
     value.clear();
     column_family = 0;
     s = ReadRecordFromWriteBatch(&input, &tag, &column_family, &key, &value,
-                                 &blob, &xid, /*write_unix_time=*/nullptr);
+                                 &blob, &xid, /*write_unix_time=*/nullptr,
+                                 WriteBatchInternal::HasReferencedValues(this));
     if (!s.ok()) {
       return s;
     }
@@ -2258,6 +2361,7 @@ class MemTableInserter : public WriteBatch::Handler {
       return ret_status;
     }
     assert(ret_status.ok());
+    InvalidatePointLookup(column_family_id, key);
 
     MemTable* mem = cf_mems_->GetMemTable();
     auto* moptions = mem->GetImmutableMemTableOptions();
@@ -2480,9 +2584,16 @@ class MemTableInserter : public WriteBatch::Handler {
     return s;
   }
 
-  Status DeleteImpl(uint32_t /*column_family_id*/, const Slice& key,
+  Status DeleteImpl(uint32_t column_family_id, const Slice& key,
                     const Slice& value, ValueType delete_type,
                     const ProtectionInfoKVOS64* kv_prot_info) {
+    if (delete_type == kTypeRangeDeletion) {
+      if (db_ != nullptr && db_->point_lookup_cache() != nullptr) {
+        db_->point_lookup_cache()->InvalidateAll(sequence_);
+      }
+    } else {
+      InvalidatePointLookup(column_family_id, key);
+    }
     Status ret_status;
     MemTable* mem = cf_mems_->GetMemTable();
     ret_status =
@@ -2743,6 +2854,7 @@ class MemTableInserter : public WriteBatch::Handler {
       return ret_status;
     }
     assert(ret_status.ok());
+    InvalidatePointLookup(column_family_id, key);
 
     MemTable* mem = cf_mems_->GetMemTable();
     auto* moptions = mem->GetImmutableMemTableOptions();
@@ -2931,6 +3043,15 @@ class MemTableInserter : public WriteBatch::Handler {
     return ret_status;
   }
 
+  // Keeps the point lookup cache coherent. Must happen before the write is
+  // published.
+  void InvalidatePointLookup(uint32_t column_family_id, const Slice& key) {
+    if (db_ != nullptr && db_->point_lookup_cache() != nullptr) {
+      db_->point_lookup_cache()->InvalidateKey(column_family_id, key,
+                                               sequence_);
+    }
+  }
+
   void CheckMemtableFull() {
     if (flush_scheduler_ != nullptr) {
       auto* cfd = cf_mems_->current();
@@ -3400,7 +3521,102 @@ Status WriteBatchInternal::SetContents(WriteBatch* b, const Slice& contents) {
   assert(b->prot_info_ == nullptr);
 
   b->rep_.assign(contents.data(), contents.size());
+  // Value references in `contents` are not resolved, see
+  // ReadRecordFromWriteBatch()
   b->content_flags_.store(ContentFlags::DEFERRED, std::memory_order_relaxed);
+  b->referenced_value_bytes_ = 0;
+  return Status::OK();
+}
+
+bool WriteBatchInternal::HasReferencedValues(const WriteBatch* b) {
+  return (b->content_flags_.load(std::memory_order_relaxed) &
+          ContentFlags::HAS_REFERENCED_VALUE) != 0;
+}
+
+size_t WriteBatchInternal::ComputeReferencedValueBytes(const WriteBatch* b,
+                                                       size_t size) {
+  if (!HasReferencedValues(b)) {
+    return 0;
+  }
+  assert(size >= kHeader && size <= b->rep_.size());
+  Slice input(b->rep_.data() + kHeader, size - kHeader);
+  Slice key, value, blob, xid;
+  size_t referenced_value_bytes = 0;
+  while (!input.empty()) {
+    const char record_tag = input[0];
+    char tag = 0;
+    uint32_t column_family = 0;
+    if (!ReadRecordFromWriteBatch(&input, &tag, &column_family, &key, &value,
+                                  &blob, &xid, nullptr /* write_unix_time */,
+                                  true /* allow_value_references */)
+             .ok()) {
+      break;
+    }
+    if (record_tag == static_cast<char>(kTypeValueReference) ||
+        record_tag == static_cast<char>(kTypeColumnFamilyValueReference)) {
+      referenced_value_bytes += value.size();
+    }
+  }
+  return referenced_value_bytes;
+}
+
+Status WriteBatchInternal::AppendResolvedContents(const WriteBatch* b,
+                                                  bool skip_header,
+                                                  std::vector<Slice>* parts,
+                                                  size_t* total_size) {
+  assert(parts != nullptr && total_size != nullptr);
+  const std::string& rep = b->rep_;
+  if (rep.size() < kHeader) {
+    return Status::Corruption("malformed WriteBatch (too small)");
+  }
+  // Start of the batch contents not yet covered by `parts`
+  const char* pending = rep.data() + (skip_header ? kHeader : 0);
+  const char* rep_end = rep.data() + rep.size();
+  *total_size += static_cast<size_t>(rep_end - pending);
+  if (HasReferencedValues(b)) {
+    static const char kValueTag = static_cast<char>(kTypeValue);
+    static const char kColumnFamilyValueTag =
+        static_cast<char>(kTypeColumnFamilyValue);
+
+    Slice input(rep.data() + kHeader, rep.size() - kHeader);
+    Slice key, value, blob, xid;
+    while (!input.empty()) {
+      const char* record = input.data();
+      char tag = 0;
+      uint32_t column_family = 0;
+      Status s = ReadRecordFromWriteBatch(
+          &input, &tag, &column_family, &key, &value, &blob, &xid,
+          nullptr /* write_unix_time */, true /* allow_value_references */);
+      if (!s.ok()) {
+        return s;
+      }
+      if (*record != static_cast<char>(kTypeValueReference) &&
+          *record != static_cast<char>(kTypeColumnFamilyValueReference)) {
+        continue;
+      }
+      // Replace the tag with the regular Put tag and the value address with
+      // the referenced value.
+      const char* address = input.data() - sizeof(uint64_t);
+      if (record > pending) {
+        parts->emplace_back(pending, static_cast<size_t>(record - pending));
+      }
+      parts->emplace_back(
+          *record == static_cast<char>(kTypeValueReference)
+              ? &kValueTag
+              : &kColumnFamilyValueTag,
+          1);
+      parts->emplace_back(record + 1,
+                          static_cast<size_t>(address - record - 1));
+      if (!value.empty()) {
+        parts->push_back(value);
+      }
+      *total_size = *total_size - sizeof(uint64_t) + value.size();
+      pending = input.data();
+    }
+  }
+  if (rep_end > pending) {
+    parts->emplace_back(pending, static_cast<size_t>(rep_end - pending));
+  }
   return Status::OK();
 }
 
@@ -3422,14 +3638,18 @@ Status WriteBatchInternal::Append(WriteBatch* dst, const WriteBatch* src,
 
   const SavePoint& batch_end = src->GetWalTerminationPoint();
 
+  size_t src_referenced_value_bytes;
   if (wal_only && !batch_end.is_cleared()) {
     src_len = batch_end.size - WriteBatchInternal::kHeader;
     src_count = batch_end.count;
     src_flags = batch_end.content_flags;
+    src_referenced_value_bytes =
+        ComputeReferencedValueBytes(src, batch_end.size);
   } else {
     src_len = src->rep_.size() - WriteBatchInternal::kHeader;
     src_count = Count(src);
     src_flags = src->content_flags_.load(std::memory_order_relaxed);
+    src_referenced_value_bytes = src->referenced_value_bytes_;
   }
 
   if (src->prot_info_ != nullptr) {
@@ -3451,6 +3671,7 @@ Status WriteBatchInternal::Append(WriteBatch* dst, const WriteBatch* src,
   dst->content_flags_.store(
       dst->content_flags_.load(std::memory_order_relaxed) | src_flags,
       std::memory_order_relaxed);
+  dst->referenced_value_bytes_ += src_referenced_value_bytes;
   return Status::OK();
 }
 
@@ -87,6 +87,9 @@ class WriteBatchInternal {
   static Status Put(WriteBatch* batch, uint32_t column_family_id,
                     const SliceParts& key, const SliceParts& value);
 
+  static Status PutReferenced(WriteBatch* batch, uint32_t column_family_id,
+                              const Slice& key, const Slice& value);
+
   static Status TimedPut(WriteBatch* batch, uint32_t column_family_id,
                          const Slice& key, const Slice& value,
                          uint64_t unix_write_time);
@@ -163,7 +166,29 @@ class WriteBatchInternal {
 
   static Slice Contents(const WriteBatch* batch) { return Slice(batch->rep_); }
 
-  static size_t ByteSize(const WriteBatch* batch) { return batch->rep_.size(); }
+  // Includes the values added with PutReferenced()
+  static size_t ByteSize(const WriteBatch* batch) {
+    return batch->GetDataSize();
+  }
+
+  // Returns true if the batch contains values added with PutReferenced(),
+  // whose bytes are not part of Contents().
+  static bool HasReferencedValues(const WriteBatch* batch);
+
+  // Returns the total size of the values added with PutReferenced() in the
+  // first `size` bytes of the batch contents
+  static size_t ComputeReferencedValueBytes(const WriteBatch* batch,
+                                            size_t size);
+
+  // Appends to `parts` slices whose concatenation is the batch contents with
+  // all referenced values resolved, i.e. what is written to the WAL, and adds
+  // their total size to `*total_size`. The parts point into the batch and
+  // into the referenced buffers. If `skip_header`, the batch header is left
+  // out, as when the batch is appended to another one.
+  static Status AppendResolvedContents(const WriteBatch* batch,
+                                       bool skip_header,
+                                       std::vector<Slice>* parts,
+                                       size_t* total_size);
 
   static Status SetContents(WriteBatch* batch, const Slice& contents);
 
@@ -262,7 +287,7 @@ class LocalSavePoint {
  public:
   explicit LocalSavePoint(WriteBatch* batch)
       : batch_(batch),
-        savepoint_(batch->GetDataSize(), batch->Count(),
+        savepoint_(batch->rep_.size(), batch->Count(),
                    batch->content_flags_.load(std::memory_order_relaxed))
 #ifndef NDEBUG
         ,
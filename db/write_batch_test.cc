@@ -185,6 +185,73 @@ TEST_F(WriteBatchTest, Multiple) {
   ASSERT_EQ(4u, batch.Count());
 }
 
+TEST_F(WriteBatchTest, PutReferenced) {
+  std::string large_value(100000, 'v');
+  WriteBatch referenced;
+  ASSERT_OK(referenced.Put(Slice("foo"), Slice("bar")));
+  ASSERT_OK(referenced.PutReferenced(Slice("baz"), Slice(large_value)));
+  ASSERT_OK(referenced.Delete(Slice("box")));
+  ASSERT_OK(referenced.PutReferenced(Slice("empty"), Slice()));
+  WriteBatchInternal::SetSequence(&referenced, 100);
+  ASSERT_EQ(4u, referenced.Count());
+  ASSERT_TRUE(referenced.HasPut());
+  ASSERT_TRUE(WriteBatchInternal::HasReferencedValues(&referenced));
+  // The value bytes are not copied into the batch, but are counted in its
+  // data size
+  ASSERT_LT(WriteBatchInternal::Contents(&referenced).size(),
+            large_value.size());
+  ASSERT_EQ(referenced.GetDataSize(),
+            WriteBatchInternal::Contents(&referenced).size() +
+                large_value.size());
+
+  WriteBatch copied;
+  ASSERT_OK(copied.Put(Slice("foo"), Slice("bar")));
+  ASSERT_OK(copied.Put(Slice("baz"), Slice(large_value)));
+  ASSERT_OK(copied.Delete(Slice("box")));
+  ASSERT_OK(copied.Put(Slice("empty"), Slice()));
+  WriteBatchInternal::SetSequence(&copied, 100);
+  ASSERT_FALSE(WriteBatchInternal::HasReferencedValues(&copied));
+  ASSERT_EQ(PrintContents(&copied), PrintContents(&referenced));
+
+  // What is written to the WAL is identical to a regular batch
+  std::vector<Slice> parts;
+  size_t total_size = 0;
+  ASSERT_OK(WriteBatchInternal::AppendResolvedContents(
+      &referenced, false /* skip_header */, &parts, &total_size));
+  std::string resolved;
+  Slice(SliceParts(parts.data(), static_cast<int>(parts.size())), &resolved);
+  ASSERT_EQ(total_size, resolved.size());
+  ASSERT_EQ(WriteBatchInternal::Contents(&copied), Slice(resolved));
+
+  // Appending keeps the references
+  WriteBatch appended;
+  ASSERT_OK(WriteBatchInternal::Append(&appended, &referenced));
+  ASSERT_TRUE(WriteBatchInternal::HasReferencedValues(&appended));
+  WriteBatchInternal::SetSequence(&appended, 100);
+  ASSERT_EQ(PrintContents(&copied), PrintContents(&appended));
+  ASSERT_EQ(referenced.GetDataSize(), appended.GetDataSize());
+
+  // A batch rebuilt from the contents, e.g. from the WAL, cannot resolve
+  // the references
+  WriteBatch rebuilt(referenced.Data());
+  ASSERT_FALSE(WriteBatchInternal::HasReferencedValues(&rebuilt));
+  ASSERT_TRUE(PrintContents(&rebuilt).find("Corruption") != std::string::npos);
+  WriteBatch contents_set;
+  ASSERT_OK(WriteBatchInternal::SetContents(
+      &contents_set, WriteBatchInternal::Contents(&referenced)));
+  ASSERT_TRUE(PrintContents(&contents_set).find("Corruption") !=
+              std::string::npos);
+
+  // Rolling back drops the referenced values from the data size
+  referenced.SetSavePoint();
+  ASSERT_OK(referenced.PutReferenced(Slice("more"), Slice(large_value)));
+  ASSERT_EQ(WriteBatchInternal::Contents(&referenced).size() +
+                2 * large_value.size(),
+            referenced.GetDataSize());
+  ASSERT_OK(referenced.RollbackToSavePoint());
+  ASSERT_EQ(appended.GetDataSize(), referenced.GetDataSize());
+}
+
 TEST_F(WriteBatchTest, Corruption) {
   WriteBatch batch;
   ASSERT_OK(batch.Put(Slice("foo"), Slice("bar")));
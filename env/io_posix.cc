@@ -24,10 +24,13 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 #if defined(OS_LINUX) || defined(OS_ANDROID)
 #include <sys/statfs.h>
 #include <sys/sysmacros.h>
@@ -133,6 +136,69 @@ bool PosixWrite(int fd, const char* buf, size_t nbyte) {
   return true;
 }
 
+// Like PosixWrite() for the concatenation of `num_slices` slices, using
+// writev(2) so that they are written with as few syscalls as possible.
+bool PosixWriteV(int fd, const Slice* slices, size_t num_slices) {
+  const size_t kLimit1Gb = 1UL << 30;
+
+  std::vector<struct iovec> iov;
+  iov.reserve(num_slices);
+  for (size_t i = 0; i < num_slices; ++i) {
+    if (slices[i].size() > kLimit1Gb) {
+      // Not worth handling here, see PosixWrite()
+      for (size_t j = 0; j < num_slices; ++j) {
+        if (!PosixWrite(fd, slices[j].data(), slices[j].size())) {
+          return false;
+        }
+      }
+      return true;
+    }
+    if (!slices[i].empty()) {
+      struct iovec v;
+      v.iov_base = const_cast<char*>(slices[i].data());
+      v.iov_len = slices[i].size();
+      iov.push_back(v);
+    }
+  }
+
+#ifdef IOV_MAX
+  const size_t kMaxCount = IOV_MAX;
+#else
+  const size_t kMaxCount = 1024;
+#endif
+  size_t next = 0;
+  while (next < iov.size()) {
+    // Also keep the size of one call within kLimit1Gb, see PosixWrite()
+    size_t count = 1;
+    size_t bytes = iov[next].iov_len;
+    while (next + count < iov.size() && count < kMaxCount &&
+           bytes + iov[next + count].iov_len <= kLimit1Gb) {
+      bytes += iov[next + count].iov_len;
+      ++count;
+    }
+    ssize_t done = writev(fd, &iov[next], static_cast<int>(count));
+    if (done < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    // Skip what has been written, which may end within a buffer
+    size_t left = static_cast<size_t>(done);
+    while (left > 0) {
+      if (left >= iov[next].iov_len) {
+        left -= iov[next].iov_len;
+        ++next;
+      } else {
+        iov[next].iov_base = static_cast<char*>(iov[next].iov_base) + left;
+        iov[next].iov_len -= left;
+        left = 0;
+      }
+    }
+  }
+  return true;
+}
+
 bool PosixPositionedWrite(int fd, const char* buf, size_t nbyte, off_t offset) {
   const size_t kLimit1Gb = 1UL << 30;
 
@@ -1360,6 +1426,22 @@ IOStatus PosixWritableFile::Append(const Slice& data, const IOOptions& /*opts*/,
   return IOStatus::OK();
 }
 
+IOStatus PosixWritableFile::AppendV(const Slice* data, size_t num_slices,
+                                    const IOOptions& opts,
+                                    IODebugContext* dbg) {
+  if (use_direct_io()) {
+    // Each write must be aligned
+    return FSWritableFile::AppendV(data, num_slices, opts, dbg);
+  }
+  if (!PosixWriteV(fd_, data, num_slices)) {
+    return IOError("While appending to file", filename_, errno);
+  }
+  for (size_t i = 0; i < num_slices; ++i) {
+    filesize_ += data[i].size();
+  }
+  return IOStatus::OK();
+}
+
 IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
                                              const IOOptions& /*opts*/,
                                              IODebugContext* /*dbg*/) {
@@ -390,6 +390,8 @@ class PosixWritableFile : public FSWritableFile {
                   IODebugContext* dbg) override {
     return Append(data, opts, dbg);
   }
+  IOStatus AppendV(const Slice* data, size_t num_slices, const IOOptions& opts,
+                   IODebugContext* dbg) override;
   IOStatus PositionedAppend(const Slice& data, uint64_t offset,
                             const IOOptions& opts,
                             IODebugContext* dbg) override;
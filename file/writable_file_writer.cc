@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <mutex>
+#include <vector>
 
 #include "db/version_edit.h"
 #include "file/file_util.h"
@@ -204,6 +205,75 @@ IOStatus WritableFileWriter::Append(const IOOptions& opts, const Slice& data,
   return s;
 }
 
+IOStatus WritableFileWriter::Append(const IOOptions& opts, const Slice* data,
+                                    size_t num_slices,
+                                    const uint32_t* crc32c_checksums) {
+  size_t total_size = 0;
+  for (size_t i = 0; i < num_slices; ++i) {
+    total_size += data[i].size();
+  }
+  // The buffer is the better choice when the data fits in it. Also, gathered
+  // writes do not support direct I/O, checksum handoff or rate limiting.
+  if (total_size <= max_buffer_size_ - std::min(max_buffer_size_,
+                                                buf_.CurrentSize()) ||
+      use_direct_io() || perform_data_verification_ ||
+      rate_limiter_ != nullptr) {
+    IOStatus s;
+    for (size_t i = 0; i < num_slices && s.ok(); ++i) {
+      s = Append(opts, data[i],
+                 crc32c_checksums != nullptr ? crc32c_checksums[i] : 0);
+    }
+    return s;
+  }
+
+  if (seen_error()) {
+    return GetWriterHasPreviousErrorStatus();
+  }
+
+  StopWatch sw(clock_, stats_, hist_type_,
+               GetFileWriteHistograms(hist_type_, opts.io_activity));
+
+  const IOOptions io_options = FinalizeIOOptions(opts);
+  pending_sync_ = true;
+
+  TEST_KILL_RANDOM_WITH_WEIGHT("WritableFileWriter::Append:0", REDUCE_ODDS2);
+
+  for (size_t i = 0; i < num_slices; ++i) {
+    UpdateFileChecksum(data[i]);
+  }
+
+  {
+    IOSTATS_TIMER_GUARD(prepare_write_nanos);
+    TEST_SYNC_POINT("WritableFileWriter::Append:BeforePrepareWrite");
+    writable_file_->PrepareWrite(static_cast<size_t>(GetFileSize()),
+                                 total_size, io_options, nullptr);
+  }
+
+  // Write out the buffered data along with the new data
+  std::vector<Slice> slices;
+  slices.reserve(num_slices + 1);
+  size_t buffered_size = buf_.CurrentSize();
+  if (buffered_size > 0) {
+    slices.emplace_back(buf_.BufferStart(), buffered_size);
+  }
+  for (size_t i = 0; i < num_slices; ++i) {
+    if (!data[i].empty()) {
+      slices.push_back(data[i]);
+    }
+  }
+  IOStatus s = WriteGathered(io_options, slices.data(), slices.size(),
+                             buffered_size + total_size);
+
+  TEST_KILL_RANDOM("WritableFileWriter::Append:1");
+  if (s.ok()) {
+    uint64_t cur_size = filesize_.load(std::memory_order_acquire);
+    filesize_.store(cur_size + total_size, std::memory_order_release);
+  } else {
+    set_seen_error(s);
+  }
+  return s;
+}
+
 IOStatus WritableFileWriter::Pad(const IOOptions& opts,
                                  const size_t pad_bytes) {
   if (seen_error()) {
@@ -664,6 +734,58 @@ IOStatus WritableFileWriter::WriteBuffered(const IOOptions& opts,
   return s;
 }
 
+IOStatus WritableFileWriter::WriteGathered(const IOOptions& opts,
+                                           const Slice* data,
+                                           size_t num_slices, size_t size) {
+  if (seen_error()) {
+    return GetWriterHasPreviousErrorStatus();
+  }
+
+  IOStatus s;
+  assert(!use_direct_io());
+  assert(!perform_data_verification_);
+  {
+    IOSTATS_TIMER_GUARD(write_nanos);
+    TEST_SYNC_POINT("WritableFileWriter::Flush:BeforeAppend");
+
+    FileOperationInfo::StartTimePoint start_ts;
+    uint64_t old_size = writable_file_->GetFileSize(opts, nullptr);
+    if (ShouldNotifyListeners()) {
+      start_ts = FileOperationInfo::StartNow();
+      old_size = next_write_offset_;
+    }
+    {
+      auto prev_perf_level = GetPerfLevel();
+
+      IOSTATS_CPU_TIMER_GUARD(cpu_write_nanos, clock_);
+      s = writable_file_->AppendV(data, num_slices, opts, nullptr);
+      SetPerfLevel(prev_perf_level);
+    }
+    if (ShouldNotifyListeners()) {
+      auto finish_ts = std::chrono::steady_clock::now();
+      NotifyOnFileWriteFinish(old_size, size, start_ts, finish_ts, s);
+      if (!s.ok()) {
+        NotifyOnIOError(s, FileOperationType::kAppend, file_name(), size,
+                        old_size);
+      }
+    }
+  }
+  // As in WriteBuffered(), the buffered data is dropped even if the write
+  // failed.
+  buf_.Size(0);
+  buffered_data_crc32c_checksum_ = 0;
+  if (!s.ok()) {
+    set_seen_error(s);
+    return s;
+  }
+
+  IOSTATS_ADD(bytes_written, size);
+  TEST_KILL_RANDOM("WritableFileWriter::WriteBuffered:0");
+  uint64_t cur_size = flushed_size_.load(std::memory_order_acquire);
+  flushed_size_.store(cur_size + size, std::memory_order_release);
+  return s;
+}
+
 IOStatus WritableFileWriter::WriteBufferedWithChecksum(const IOOptions& opts,
                                                        const char* data,
                                                        size_t size) {
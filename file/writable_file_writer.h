@@ -256,6 +256,14 @@ class WritableFileWriter {
   IOStatus Append(const IOOptions& opts, const Slice& data,
                   uint32_t crc32c_checksum = 0);
 
+  // Appends the concatenation of `num_slices` slices. If they do not fit in
+  // the buffer, they are written together with the buffered data by one
+  // FSWritableFile::AppendV() instead of being copied into the buffer first.
+  // If provided, `crc32c_checksums` has the checksum of each slice, with 0
+  // meaning not provided as for Append().
+  IOStatus Append(const IOOptions& opts, const Slice* data, size_t num_slices,
+                  const uint32_t* crc32c_checksums = nullptr);
+
   IOStatus Pad(const IOOptions& opts, const size_t pad_bytes);
 
   IOStatus Flush(const IOOptions& opts);
@@ -358,6 +366,9 @@ class WritableFileWriter {
   // Normal write.
   // `opts` should've been called with `FinalizeIOOptions()` before passing in
   IOStatus WriteBuffered(const IOOptions& opts, const char* data, size_t size);
+  // Writes the slices with FSWritableFile::AppendV() and clears the buffer.
+  IOStatus WriteGathered(const IOOptions& opts, const Slice* data,
+                         size_t num_slices, size_t size);
   // `opts` should've been called with `FinalizeIOOptions()` before passing in
   IOStatus WriteBufferedWithChecksum(const IOOptions& opts, const char* data,
                                      size_t size);
@@ -385,6 +385,18 @@ class Cache : public Customizable {
     return Status::NotSupported();
   }
 
+  // EXPERIMENTAL
+  // Registers a new tenant of the cache, identified by `*id`. Use
+  // NewCacheTenant() rather than calling this directly.
+  virtual Status AddTenant(const CacheTenantOptions& /*opts*/,
+                           uint8_t* /*id*/) {
+    return Status::NotSupported();
+  }
+
+  // EXPERIMENTAL
+  // Returns the total charge of the entries of tenant `id`
+  virtual size_t GetTenantUsage(uint8_t /*id*/) const { return 0; }
+
   // Call this on shutdown if you want to speed it up. Cache will disown
   // any underlying data and will not free it on delete. This call will leak
   // memory - call this only if you're shutting down the process.
@@ -667,6 +679,14 @@ class CacheWrapper : public Cache {
 
   uint32_t GetHashSeed() const override { return target_->GetHashSeed(); }
 
+  Status AddTenant(const CacheTenantOptions& opts, uint8_t* id) override {
+    return target_->AddTenant(opts, id);
+  }
+
+  size_t GetTenantUsage(uint8_t id) const override {
+    return target_->GetTenantUsage(id);
+  }
+
   void ReportProblems(const std::shared_ptr<Logger>& info_log) const override {
     target_->ReportProblems(info_log);
   }
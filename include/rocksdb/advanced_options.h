@@ -59,6 +59,15 @@ enum CompactionPri : char {
   // level. The file picking process will cycle through all the files in a
   // round-robin manner.
   kRoundRobin = 0x4,
+  // First compact files whose key range costs point lookups the most per
+  // byte compacted. The cost is estimated from the lookups sampled on each
+  // file (see FileMetaData::stats) times the number of other sorted runs
+  // overlapping its key range (L0 files and levels), which lookups of the
+  // range also have to check. Files without sampled lookups, e.g. cold bulk
+  // data, are picked as with kMinOverlappingRatio.
+  // Files marked for compaction will be prioritized over files that are not
+  // marked.
+  kByReadHeat = 0x5,
 };
 
 struct FileTemperatureAge {
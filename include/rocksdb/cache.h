@@ -15,6 +15,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rocksdb/compression_type.h"
 #include "rocksdb/data_structure.h"
@@ -24,7 +25,9 @@ namespace ROCKSDB_NAMESPACE {
 
 class Cache;  // defined in advanced_cache.h
 struct ConfigOptions;
+class FileSystem;
 class SecondaryCache;
+class Statistics;
 
 // These definitions begin source compatibility for a future change in which
 // a specific class for block cache is split away from general caches, so that
@@ -189,6 +192,27 @@ struct ShardedCacheOptions {
   //   repeatable behavior on a host, for diagnostic purposes.
   int32_t hash_seed = kHostHashSeed;
 
+  // EXPERIMENTAL
+  // If true, the cache keeps an approximate count of recent lookups for each
+  // key (a count-min sketch per shard, periodically aged), and a new entry
+  // that would require an eviction is only inserted if its key was looked up
+  // more often recently than the entry it would evict (TinyLFU admission).
+  // This keeps one-off accesses, such as the blocks read by a large scan with
+  // fill_cache=true, from flushing the working set. A rejected entry is
+  // handled as if inserted and immediately evicted: a handle requested from
+  // Insert() refers to an entry outside of the cache that is freed on
+  // release. Entries inserted with Priority::HIGH are always admitted, and
+  // admission does not apply with strict_capacity_limit.
+  //
+  // For LRUCache, the eviction victim is the least recently used entry. For
+  // HyperClockCache, where it is not known ahead of the eviction, the entry
+  // evicted last is used instead.
+  bool frequency_admission = false;
+
+  // If non-nullptr, the decisions of `frequency_admission` are recorded in
+  // these statistics (CACHE_ADMISSION_ADMITTED and CACHE_ADMISSION_REJECTED).
+  std::shared_ptr<Statistics> admission_statistics;
+
   ShardedCacheOptions() {}
   ShardedCacheOptions(
       size_t _capacity, int _num_shard_bits, bool _strict_capacity_limit,
@@ -371,6 +395,49 @@ inline std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
   return opts.MakeSharedSecondaryCache();
 }
 
+// EXPERIMENTAL
+// Options for a SecondaryCache that keeps saved (typically compressed) blocks
+// in a file on local flash, e.g. as TieredCacheOptions::nvm_sec_cache.
+//
+// The file is divided into fixed size regions that are filled sequentially
+// through a DRAM write buffer and written out in full, and reclaimed in FIFO
+// order when the file is full, so the device only sees large writes. An
+// in-memory hash index maps each key to its location. Entries up to the
+// largest size class are rounded up to their size class and packed into
+// regions holding entries of that class only; larger entries are appended
+// to regions of their own. Lookups with wait=false are issued with
+// FSRandomAccessFile::ReadAsync (io_uring on Posix) when the FileSystem
+// supports it, and completed in WaitAll.
+//
+// The contents of the file are discarded when the cache is created, and the
+// file is deleted when it is destroyed.
+//
+// DRAM usage is one write buffer of region_size per size class plus one for
+// large entries, and about 48 bytes per cached entry for the index.
+struct FlashSecondaryCacheOptions {
+  // Path of the cache file. Required.
+  std::string path;
+
+  // FileSystem the cache file lives on. FileSystem::Default() if null.
+  std::shared_ptr<FileSystem> file_system;
+
+  // Size of the cache file in bytes. Must be enough for at least two
+  // regions more than there are write buffers.
+  size_t capacity = 0;
+
+  // Unit of allocation and of writes to the file. At most 32MB.
+  size_t region_size = 4 << 20;
+
+  // Sizes, in increasing order, that small entries (including a 12 byte
+  // header and the key) are rounded up to. Rounded up to multiples of 64.
+  std::vector<uint32_t> size_classes = {512, 1024, 2048, 4096, 8192};
+};
+
+// EXPERIMENTAL
+// Creates a FlashSecondaryCache, truncating any existing file at opts.path.
+Status NewFlashSecondaryCache(const FlashSecondaryCacheOptions& opts,
+                              std::shared_ptr<SecondaryCache>* result);
+
 // HyperClockCache - A lock-free Cache alternative for RocksDB block cache
 // that offers much improved CPU efficiency vs. LRUCache under high parallel
 // load or high contention, with some caveats:
@@ -478,6 +545,22 @@ struct HyperClockCacheOptions : public ShardedCacheOptions {
   // keep operations very fast.
   int eviction_effort_cap = 30;
 
+  // EXPERIMENTAL: When > 0, enables an S3-FIFO style variant of the CLOCK
+  // eviction. New entries (except with Priority::HIGH) start on probation,
+  // in a FIFO queue holding about this share of the entries that fit in
+  // the cache. Entries still not hit when they reach the head of the queue
+  // are evicted first, and their keys are remembered in a ghost set for
+  // about as many evictions as the cache holds entries. Entries hit while
+  // on probation, or inserted again while remembered in the ghost set, are
+  // kept by the regular CLOCK. This keeps blocks read only once (e.g. by
+  // point lookups over cold keys) from displacing warmer entries. Lookups
+  // remain lock-free. A typical setting is 0.1.
+  //
+  // Only supported with estimated_entry_charge > 0, and the size of the
+  // queue is fixed at creation time like the rest of the table. Ignored
+  // otherwise.
+  double probationary_ratio = 0.0;
+
   HyperClockCacheOptions(
       size_t _capacity, size_t _estimated_entry_charge,
       int _num_shard_bits = -1, bool _strict_capacity_limit = false,
@@ -555,6 +638,22 @@ struct TieredCacheOptions {
   // divided between the primary block cache and compressed secondary cache
   size_t total_capacity = 0;
   double compressed_secondary_ratio = 0.0;
+  // EXPERIMENTAL
+  // If true, compressed_secondary_ratio is only the initial split of
+  // total_capacity, which is then tuned automatically, within
+  // [min_compressed_secondary_ratio, max_compressed_secondary_ratio].
+  // A sample of the cache keys is tracked in small shadow caches, to
+  // estimate how many more hits each tier would get with
+  // adaptive_ratio_step * total_capacity more memory. Every
+  // adaptive_tuning_interval lookups, that much memory is moved to the tier
+  // with clearly more such hits. Not supported with nvm_sec_cache.
+  bool adaptive_compressed_secondary_ratio = false;
+  // Must be > 0, as the compressed secondary cache cannot be re-enabled once
+  // its ratio is 0.0
+  double min_compressed_secondary_ratio = 0.05;
+  double max_compressed_secondary_ratio = 0.9;
+  double adaptive_ratio_step = 0.05;
+  uint64_t adaptive_tuning_interval = 1 << 20;
   // An optional secondary cache that will serve as the persistent cache
   // tier. If present, compressed blocks will be written to this
   // secondary cache.
@@ -572,8 +671,58 @@ std::shared_ptr<Cache> NewTieredCache(const TieredCacheOptions& cache_opts);
 // 2. Once the compressed secondary cache is disabled by setting the
 //    compressed_secondary_ratio to 0.0, it cannot be dynamically re-enabled
 //    again
+// With adaptive_compressed_secondary_ratio, a compressed_secondary_ratio
+// given here is where the automatic tuning continues from.
 Status UpdateTieredCache(
     const std::shared_ptr<Cache>& cache, int64_t total_capacity = -1,
     double compressed_secondary_ratio = std::numeric_limits<double>::max(),
     TieredAdmissionPolicy adm_policy = TieredAdmissionPolicy::kAdmPolicyMax);
+
+// EXPERIMENTAL
+// Options for a tenant of a shared cache, see NewCacheTenant().
+struct CacheTenantOptions {
+  // Identifies the tenant in its stats
+  std::string name;
+  // Fraction of the capacity of the cache reserved for the entries of the
+  // tenant. While they take up less than that, they are only evicted if no
+  // other entry can be. The reservations of all the tenants of a cache must
+  // add up to at most 1.0.
+  double reserved_ratio = 0.0;
+  // Fraction of the capacity of the cache that the entries of the tenant
+  // should not exceed. Beyond it, they are evicted ahead of all other
+  // entries. As this is enforced by eviction, the tenant can exceed its
+  // ceiling for as long as no other entry needs the space.
+  double max_ratio = 1.0;
+};
+
+// EXPERIMENTAL
+// Returns a view of `cache` that inserts entries on behalf of a new tenant
+// of `cache`, with its own reservation and ceiling. For example, column
+// families sharing a block cache can be isolated from each other by setting
+// a different tenant of the cache as the BlockBasedTableOptions::block_cache
+// of each of them. Entries inserted into `cache` directly belong to no
+// tenant and are neither protected nor limited. Supported by LRUCache and by
+// HyperClockCache with a fixed estimated_entry_charge, including as the
+// primary cache of a TieredCache, with up to 15 tenants per cache. Returns
+// nullptr if `cache` does not support tenants, if it has too many of them or
+// if the options are invalid.
+std::shared_ptr<Cache> NewCacheTenant(const std::shared_ptr<Cache>& cache,
+                                      const CacheTenantOptions& opts);
+
+// EXPERIMENTAL
+struct CacheTenantStats {
+  std::string name;
+  double reserved_ratio = 0.0;
+  double max_ratio = 1.0;
+  // Total charge of the entries of the tenant in the cache
+  size_t usage = 0;
+  // Lookups through the tenant
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+};
+
+// EXPERIMENTAL
+// Gets the stats of a cache returned by NewCacheTenant(). Returns
+// InvalidArgument for any other cache.
+Status GetCacheTenantStats(const Cache& cache, CacheTenantStats* stats);
 }  // namespace ROCKSDB_NAMESPACE
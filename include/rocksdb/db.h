@@ -1206,6 +1206,22 @@ class DB {
     //      stale values more frequently to reduce overhead and latency.
     static const std::string kFastBlockCacheEntryStats;
 
+    //  "rocksdb.block-cache-tenant-stats" - returns a string or map with the
+    //      stats of the tenant of the block cache used by the column family,
+    //      if it is one (see NewCacheTenant()). The map has the keys "name",
+    //      "usage", "reserved-ratio", "max-ratio", "hits", "misses" and
+    //      "hit-ratio".
+    static const std::string kBlockCacheTenantStats;
+
+    //  "rocksdb.block-cache-heatmap" - returns a string or map with sampled
+    //      estimates of the block cache hits and misses of the column family,
+    //      as "l<level>.<block type>.{hits,misses}" (level "unknown" for
+    //      tables whose level is not known) and "l<level>.{hits,misses}",
+    //      and of its hottest live files by misses, as
+    //      "file.<number>.{level,hits,misses}". "sample-interval" is the
+    //      number of lookups per recorded one.
+    static const std::string kBlockCacheHeatmap;
+
     //  "rocksdb.num-immutable-mem-table" - returns number of immutable
     //      memtables that have not yet been flushed.
     static const std::string kNumImmutableMemTable;
@@ -1557,6 +1573,26 @@ class DB {
     GetApproximateMemTableStats(DefaultColumnFamily(), range, count, size);
   }
 
+  // EXPERIMENTAL
+  // Splits the key range [begin, end) of the column family (unbounded on a
+  // side without a value) into up to `num_partitions` consecutive ranges
+  // holding roughly the same amount of data, e.g. to scan them in parallel
+  // (see PartitionedScan). Stores in `*boundaries` the keys separating the
+  // ranges, in increasing order and strictly within (begin, end); there can
+  // be fewer than `num_partitions - 1` of them if the range holds too little
+  // data.
+  //
+  // Like subcompaction boundaries, the split is based on key anchors sampled
+  // from the index blocks of the SST files overlapping the range, so data in
+  // memtables is not accounted for. Not supported with user-defined
+  // timestamps.
+  virtual Status GetScanPartitionBoundaries(
+      const ReadOptions& /*options*/, ColumnFamilyHandle* /*column_family*/,
+      const OptSlice& /*begin*/, const OptSlice& /*end*/,
+      size_t /*num_partitions*/, std::vector<std::string>* /*boundaries*/) {
+    return Status::NotSupported("GetScanPartitionBoundaries() not supported");
+  }
+
   // Compact the underlying storage for the key range [*begin,*end].
   // The actual compaction interval might be superset of [*begin, *end].
   // In particular, deleted and overwritten versions are discarded,
@@ -1071,6 +1071,22 @@ class FSWritableFile {
     return Append(data, options, dbg);
   }
 
+  // EXPERIMENTAL
+  // Append the concatenation of `num_slices` slices, like writev(2), so that
+  // the caller does not have to copy data from several buffers into one.
+  // The default implementation calls Append() for each slice. (Wrappers do
+  // not forward it, so that their Append() sees all appended data.)
+  virtual IOStatus AppendV(const Slice* data, size_t num_slices,
+                           const IOOptions& options, IODebugContext* dbg) {
+    for (size_t i = 0; i < num_slices; ++i) {
+      IOStatus s = Append(data[i], options, dbg);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    return IOStatus::OK();
+  }
+
   // PositionedAppend data to the specified offset. The new EOF after append
   // must be larger than the previous EOF. This is to be used when writes are
   // not backed by OS buffers and hence has to always start from the start of
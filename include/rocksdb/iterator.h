@@ -95,6 +95,24 @@ class Iterator : public IteratorBase {
     return Slice();
   }
 
+  // EXPERIMENTAL
+  // Returns the current entry and the ones following it, and moves past
+  // them, as if by calling key(), value() and Next() for each. `keys` and
+  // `values` must have room for `max_entries` elements. Stops after
+  // `max_entries` entries, once the keys and values returned add up to
+  // `max_bytes` or more, or when the iterator becomes invalid, and returns
+  // the number of entries returned. At least one entry is returned if
+  // Valid() and `max_entries` > 0.
+  //
+  // The returned slices point either to data pinned by the iterator or to
+  // copies in `*buf`, and remain valid until the next modification of the
+  // iterator or of `*buf`. Like after Next(), check status() once the
+  // iterator is no longer Valid(). Compared to calling Next() for each
+  // entry, this amortizes the per-entry overhead of the call chain, which
+  // matters for scans of small entries.
+  virtual size_t NextBatch(size_t max_entries, size_t max_bytes, Slice* keys,
+                           Slice* values, std::string* buf);
+
   // RocksDB Internal - DO NOT USE
   // Prepare the iterator to scan the ranges specified in scan_opts. The
   // upper bound and other table specific limits may be specified. This will
@@ -897,6 +897,23 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   uint32_t max_subcompactions = 1;
 
+  // EXPERIMENTAL
+  // If greater than 1, a compaction split into subcompactions is split into
+  // up to this many times more key ranges than it runs threads (see
+  // max_subcompactions). Each thread takes the next unprocessed range when it
+  // is done with one, so that threads done early take over ranges of skewed
+  // parts of the key space (e.g. many tombstones, expensive compaction
+  // filters or long merge chains) instead of waiting for the slowest range.
+  // Each range produces its own output files, so the last output file of
+  // each range might be smaller than the target file size. Ranges are never
+  // smaller than the target file size of the output level. Not applied to
+  // kRoundRobin compaction priority, which already splits compactions by
+  // input file.
+  // Default: 1 (one range per thread)
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  uint32_t subcompaction_ranges_per_thread = 1;
+
   // DEPRECATED: RocksDB automatically decides this based on the
   // value of max_background_jobs. For backwards compatibility we will set
   // `max_background_jobs = max_background_compactions + max_background_flushes`
@@ -1322,6 +1339,23 @@ struct DBOptions {
   // Default: nullptr (disabled)
   std::shared_ptr<RowCache> row_cache = nullptr;
 
+  // EXPERIMENTAL
+  // A cache for the results of Get() at the latest sequence number, keyed on
+  // column family and user key and including keys that were not found. A
+  // hit skips the memtables and all SST files, so this pays off for hot keys
+  // that are read much more often than they are written. Writes keep the
+  // cache coherent: each written key is invalidated before the write becomes
+  // visible, and range deletions, file ingestion and DeleteFilesInRange()
+  // invalidate all entries.
+  //
+  // Only Get() of plain values without an explicit snapshot, timestamp or
+  // read callback use the cache, and only in column families without a
+  // compaction filter and not using FIFO compaction, which change the
+  // visible data outside of the write path. Incompatible with
+  // unordered_write and two_write_queues.
+  // Default: nullptr (disabled)
+  std::shared_ptr<Cache> point_lookup_cache = nullptr;
+
   // A filter object supplied to be invoked while processing write-ahead-logs
   // (WALs) during recovery. The filter provides a way to inspect log
   // records, ignoring a particular record or skipping replay.
@@ -1772,6 +1806,39 @@ struct ScanOptions {
       : range(_start, _upper_bound) {}
 };
 
+// EXPERIMENTAL
+//
+// A range condition on the value of one wide column, for filtering scans with
+// ReadOptions::scan_predicate. Plain key-values are treated as entities with
+// only the default column (kDefaultWideColumnName). An entry that does not
+// have the column never satisfies the predicate.
+struct ScanPredicate {
+  // Name of the column to test
+  Slice column_name;
+  // When has_value(), only values >= lower_bound (in bytewise order) satisfy
+  // the predicate
+  OptSlice lower_bound;
+  // When has_value(), only values < upper_bound (in bytewise order) satisfy
+  // the predicate
+  OptSlice upper_bound;
+
+  ScanPredicate() {}
+  ScanPredicate(const Slice& _column_name, const OptSlice& _lower_bound,
+                const OptSlice& _upper_bound)
+      : column_name(_column_name),
+        lower_bound(_lower_bound),
+        upper_bound(_upper_bound) {}
+
+  // Whether a column value within [min, max] can satisfy the predicate
+  bool MayMatch(const Slice& min, const Slice& max) const {
+    return (!lower_bound.has_value() || max.compare(*lower_bound) >= 0) &&
+           (!upper_bound.has_value() || min.compare(*upper_bound) < 0);
+  }
+
+  // Whether the column value `value` satisfies the predicate
+  bool Matches(const Slice& value) const { return MayMatch(value, value); }
+};
+
 // Options that control read operations
 struct ReadOptions {
   // *** BEGIN options relevant to point lookups as well as scans ***
@@ -1842,6 +1909,22 @@ struct ReadOptions {
   // to point lookups and is disabled by default.
   std::optional<size_t> merge_operand_count_threshold;
 
+  // EXPERIMENTAL
+  // If non-null, GetEntity, MultiGetEntity and Iterator::columns() only
+  // return the wide columns whose names are in this list (in any order),
+  // which saves deserializing and copying the other columns of wide entities.
+  // Note that the returned columns are then copied out of the block cache
+  // rather than pinned, so projecting most of the columns of large entities
+  // may cost more than reading them in full.
+  // A plain key-value is treated as an entity with only the default column
+  // (see kDefaultWideColumnName), so it is returned only if the default
+  // column is in the list. Other results of the lookup, e.g. the status and
+  // Get() / Iterator::value(), are unaffected.
+  //
+  // The vector and the names it points to must remain valid for the
+  // duration of the read, or for the lifetime of the iterator.
+  const std::vector<Slice>* column_projection = nullptr;
+
   // If true, all data read from underlying storage will be
   // verified against corresponding checksums.
   bool verify_checksums = true;
@@ -2040,6 +2123,24 @@ struct ReadOptions {
   // Default: false
   bool allow_unprepared_value = false;
 
+  // EXPERIMENTAL
+  //
+  // If non-nullptr, iterators only return the entries that satisfy the
+  // predicate, as if the others did not exist. The predicate is applied to
+  // the newest visible version of each key, after merging.
+  //
+  // Besides saving the copying and merging of the filtered entries in the
+  // upper layers, block-based tables evaluate the predicate while scanning
+  // entries that are the only version of their key (sequence number zero),
+  // and skip whole data blocks and files using the statistics configured with
+  // BlockBasedTableOptions::data_block_column_stats. This is only done for
+  // column families without a merge operator or user-defined timestamps.
+  //
+  // The predicate must remain valid for the lifetime of the iterator.
+  //
+  // Default: nullptr
+  const ScanPredicate* scan_predicate = nullptr;
+
   // EXPERIMENTAL
   //
   // Long-running iterators are holding onto memory and storage resources long
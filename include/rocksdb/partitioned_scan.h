@@ -0,0 +1,93 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "rocksdb/iterator.h"
+#include "rocksdb/options.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class ColumnFamilyHandle;
+class DB;
+class Snapshot;
+
+// EXPERIMENTAL
+//
+// A scan of a key range split into partitions holding roughly the same
+// amount of data (see DB::GetScanPartitionBoundaries()), with one iterator
+// per partition. All iterators read the same snapshot, so together they see
+// a consistent view of the range, and they can be used concurrently from
+// different threads.
+//
+// Example:
+//
+//   std::unique_ptr<PartitionedScan> scan;
+//   Status s = PartitionedScan::Create(db, ReadOptions(), cf, "a", "z",
+//                                      /*num_partitions=*/64, &scan);
+//   if (s.ok()) {
+//     s = scan->ForEach(/*num_threads=*/8, [](size_t, Iterator* it) {
+//       for (it->SeekToFirst(); it->Valid(); it->Next()) {
+//         ...
+//       }
+//       return it->status();
+//     });
+//   }
+//
+// The scan must be destroyed before the DB.
+class PartitionedScan {
+ public:
+  // Splits [begin, end) of `column_family` (unbounded on a side without a
+  // value) into up to `num_partitions` partitions and creates an iterator
+  // for each. The iterators read `read_options.snapshot` if set, or else a
+  // snapshot taken here and released with the scan. Each iterator is bounded
+  // to its partition; the iterate bounds of `read_options` are ignored.
+  static Status Create(DB* db, const ReadOptions& read_options,
+                       ColumnFamilyHandle* column_family,
+                       const OptSlice& begin, const OptSlice& end,
+                       size_t num_partitions,
+                       std::unique_ptr<PartitionedScan>* scan);
+
+  ~PartitionedScan();
+
+  PartitionedScan(const PartitionedScan&) = delete;
+  PartitionedScan& operator=(const PartitionedScan&) = delete;
+
+  size_t NumPartitions() const { return partitions_.size(); }
+
+  // Bounds of partition `i`, with no value on an unbounded side
+  OptSlice LowerBound(size_t i) const;
+  OptSlice UpperBound(size_t i) const;
+
+  // Iterator over partition `i`, owned by the scan
+  Iterator* GetIterator(size_t i) const;
+
+  // Calls `fn(i, GetIterator(i))` for each partition i, on up to
+  // `num_threads` threads including the calling one, and waits for all
+  // calls to finish. After a call returns a non-OK status, no more
+  // partitions are started and the first such status is returned.
+  Status ForEach(
+      size_t num_threads,
+      const std::function<Status(size_t partition, Iterator* iter)>& fn);
+
+ private:
+  struct Partition;
+
+  explicit PartitionedScan(DB* db);
+
+  DB* const db_;
+  // Set if the scan took its own snapshot
+  const Snapshot* snapshot_ = nullptr;
+  // Heap allocated, as the iterators point to the bounds in them
+  std::vector<std::unique_ptr<Partition>> partitions_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -542,6 +542,23 @@ enum Tickers : uint32_t {
   // TransactionOptions::large_txn_commit_optimize_threshold.
   NUMBER_WBWI_INGEST,
 
+  // Decisions of the frequency-based admission policy of a cache (see
+  // ShardedCacheOptions::frequency_admission), recorded in
+  // ShardedCacheOptions::admission_statistics. Only insertions into a full
+  // cache are subject to admission.
+  CACHE_ADMISSION_ADMITTED,
+  CACHE_ADMISSION_REJECTED,
+
+  // Get() results served by / not found in DBOptions::point_lookup_cache
+  POINT_LOOKUP_CACHE_HIT,
+  POINT_LOOKUP_CACHE_MISS,
+
+  // Data blocks written by compactions as stored in their input files, and
+  // their uncompressed size (see
+  // BlockBasedTableOptions::reuse_data_blocks_in_compaction)
+  COMPACTION_REUSED_DATA_BLOCKS,
+  COMPACTION_REUSED_DATA_BYTES,
+
   TICKER_ENUM_MAX
 };
 
@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "rocksdb/cache.h"
 #include "rocksdb/customizable.h"
@@ -258,6 +259,20 @@ struct BlockBasedTableOptions {
     // Makes the index significantly bigger (2x or more), especially when keys
     // are long.
     kBinarySearchWithFirstKey = 0x03,
+
+    // EXPERIMENTAL
+    // Like kBinarySearch, but the table also stores a small piecewise-linear
+    // model, fitted when the table is built, that predicts the position of a
+    // key in the index block. Index lookups then binary search only within
+    // the predicted window rather than the whole index block, which lowers
+    // the cost of index seeks on large index blocks and makes a larger
+    // index_block_restart_interval (i.e. smaller index) cheaper to search.
+    // The model projects keys by their first 8 bytes, so it is only built
+    // for comparators that order keys consistently with bytewise order on
+    // that prefix (e.g. BytewiseComparator()); otherwise this behaves exactly
+    // as kBinarySearch. Files written with this index type cannot be read by
+    // versions without it.
+    kLearnedSearch = 0x04,
   };
 
   IndexType index_type = kBinarySearch;
@@ -274,6 +289,71 @@ struct BlockBasedTableOptions {
   // kDataBlockBinaryAndHash.
   double data_block_hash_table_util_ratio = 0.75;
 
+  // EXPERIMENTAL
+  // If true, data blocks smaller than 64KiB also store the first 8 bytes of
+  // the key at each restart point in a dense fixed-width array. Seeks within
+  // a data block then narrow the search to the restart interval(s) that can
+  // hold the target by comparing integers (with SIMD where available) rather
+  // than decoding and comparing keys, which reduces seek CPU for read-heavy
+  // workloads. Costs 8 bytes per restart point.
+  //
+  // Only takes effect with format_version >= 7, BytewiseComparator() and no
+  // user-defined timestamps; ignored otherwise.
+  bool data_block_restart_key_prefixes = false;
+
+  // EXPERIMENTAL
+  // Names of the wide columns (kDefaultWideColumnName for plain values) for
+  // which the minimum and maximum value of each data block are recorded in a
+  // meta block. Iterators with ReadOptions::scan_predicate on one of these
+  // columns use them to skip data blocks and files without reading them.
+  // Costs a pass over each data block when it is written, plus the size of
+  // the statistics, which grows with the size of the column values.
+  //
+  // Default: empty (no statistics)
+  std::vector<std::string> data_block_column_stats;
+
+  // EXPERIMENTAL
+  // If true, a range filter over the user keys is written to each file, and
+  // iterators consult it on Seek() with ReadOptions::iterate_upper_bound: if
+  // the file has no key in [seek key, upper bound), the seek ends without
+  // reading any index or data block, and a level iterator does not move on to
+  // the following files. This helps short range scans, for which Bloom
+  // filters cannot be used.
+  //
+  // As in SuRF, the filter keeps for each key the shortest prefix that
+  // distinguishes it from its neighbors, plus `range_filter_suffix_bytes`
+  // more bytes, so it is exact for ranges that fall between keys with
+  // different prefixes. Its size is a few bytes per key. Like the other
+  // filters, it is kept with the table reader, or in the block cache with
+  // cache_index_and_filter_blocks.
+  //
+  // Only takes effect with BytewiseComparator() and no user-defined
+  // timestamps. Versions that do not support the filter ignore it.
+  bool range_filter = false;
+
+  // See range_filter. Larger values lower the false positive rate for ranges
+  // that fall between keys sharing a prefix, at the cost of memory.
+  uint32_t range_filter_suffix_bytes = 1;
+
+  // EXPERIMENTAL
+  // If true, compactions write the data blocks of their input files that come
+  // out of the compaction unchanged as they are stored, without building and
+  // compressing them again. All entries still go through the compaction, so
+  // compaction filters, snapshots, filters and table properties are accounted
+  // for as usual. A data block is written as stored when no other input
+  // overlaps its key range and all its entries come out unchanged. The last
+  // data block of each output file is always built again. Compactions read
+  // the data blocks of such input files from the file instead of the block
+  // cache. This mostly helps compactions that rewrite large unchanged key
+  // ranges, such as those of a bottommost level into which little is merged.
+  //
+  // Only takes effect with the default flush_block_policy_factory, without
+  // parallel compression, compression dictionary, custom compression manager,
+  // per-key placement or block cache warming of compaction outputs, and for
+  // input files with the same format_version and compression type as the
+  // output.
+  bool reuse_data_blocks_in_compaction = false;
+
   // Option hash_index_allow_collision is now deleted.
   // It will behave as if hash_index_allow_collision=true.
 
@@ -561,6 +641,9 @@ struct BlockBasedTableOptions {
   // misplaced within or between files is as likely to fail checksum
   // verification as random corruption. Also checksum-protects SST footer.
   // Can be read by RocksDB versions >= 8.6.0.
+  // 7 -- Data blocks can store restart key prefixes (see
+  // data_block_restart_key_prefixes). Can only be read by versions that
+  // support it.
   //
   // Using the default setting of format_version is strongly recommended, so
   // that available enhancements are adopted eventually and automatically. The
@@ -647,11 +730,23 @@ struct BlockBasedTableOptions {
     kDisable,
     // Prepopulate blocks during flush only.
     kFlushOnly,
+    // EXPERIMENTAL
+    // Prepopulate blocks during flush, and during compaction the data blocks
+    // of the output files holding keys whose data blocks were in the block
+    // cache in the input files. Otherwise a compaction of a hot key range
+    // leaves all of its blocks cold and readers take a burst of cache misses.
+    // Bounded by prepopulate_block_cache_compaction_budget.
+    kFlushAndCompaction,
   };
 
   PrepopulateBlockCache prepopulate_block_cache =
       PrepopulateBlockCache::kDisable;
 
+  // With PrepopulateBlockCache::kFlushAndCompaction, the maximum number of
+  // bytes of uncompressed data blocks a single compaction inserts into the
+  // block cache. 0 disables prepopulating during compaction.
+  uint64_t prepopulate_block_cache_compaction_budget = 64 << 20;
+
   // RocksDB does auto-readahead for iterators on noticing more than two reads
   // for a table file if user doesn't provide readahead_size. The readahead size
   // starts at initial_auto_readahead_size and doubles on every additional read
@@ -95,6 +95,28 @@ class CompactionOptionsUniversal {
   // Default: -1
   int max_read_amp;
 
+  // EXPERIMENTAL
+  // If non-zero, sorted runs are compacted by lazy leveling, a hybrid of
+  // tiering and leveling: sorted runs other than the last one are tiered,
+  // i.e. consecutive sorted runs are merged into one once there are
+  // `lazy_leveling_fanout` of them that are less than `lazy_leveling_fanout`
+  // times larger than the newest of them. The last sorted run is leveled:
+  // the other sorted runs are merged into it once their total size reaches
+  // 1 / `lazy_leveling_fanout` of its size, compacting only the files of the
+  // last level that they overlap. Compared to the default universal
+  // compaction, this bounds space amplification by about
+  // 1 / `lazy_leveling_fanout` with write amplification close to tiering,
+  // while the number of sorted runs grows with the number of tiers, which
+  // Bloom filters keep cheap for point lookups.
+  //
+  // When set, size_ratio, max_size_amplification_percent, max_read_amp and
+  // stop_style are ignored, and min_merge_width and max_merge_width bound the
+  // number of sorted runs merged within a tier. Compactions are still only
+  // considered once there are level0_file_num_compaction_trigger sorted runs.
+  // Must be 0 or at least 2.
+  // Default: 0
+  unsigned int lazy_leveling_fanout;
+
   // The algorithm used to stop picking files into a single compaction run
   // Default: kCompactionStopStyleTotalSize
   CompactionStopStyle stop_style;
@@ -119,6 +141,7 @@ class CompactionOptionsUniversal {
         max_size_amplification_percent(200),
         compression_size_percent(-1),
         max_read_amp(-1),
+        lazy_leveling_fanout(0),
         stop_style(kCompactionStopStyleTotalSize),
         allow_trivial_move(false),
         incremental(false) {}
@@ -348,6 +348,14 @@ class StackableDB : public DB { // Stackable（可堆叠的）：意思是这种
     return db_->GetApproximateSizes(options, column_family, r, n, sizes);
   }
 
+  Status GetScanPartitionBoundaries(
+      const ReadOptions& options, ColumnFamilyHandle* column_family,
+      const OptSlice& begin, const OptSlice& end, size_t num_partitions,
+      std::vector<std::string>* boundaries) override {
+    return db_->GetScanPartitionBoundaries(options, column_family, begin, end,
+                                           num_partitions, boundaries);
+  }
+
   using DB::GetApproximateMemTableStats;
   void GetApproximateMemTableStats(ColumnFamilyHandle* column_family,
                                    const Range& range, uint64_t* const count,
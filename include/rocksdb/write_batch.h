@@ -108,6 +108,24 @@ class WriteBatch : public WriteBatchBase {
   Status TimedPut(ColumnFamilyHandle* column_family, const Slice& key,
                   const Slice& value, uint64_t write_unix_time) override;
 
+  // EXPERIMENTAL
+  // Like Put(), but the batch only records a reference to `value` instead of
+  // copying it. When the batch is written with DB::Write(), the value is
+  // copied directly from the caller's buffer into the WAL and the memtable,
+  // which saves a copy for large values.
+  // The memory pointed to by `value` must remain valid and unchanged until
+  // the DB::Write() of this batch (or of a batch it was appended to) returns,
+  // or until the batch is cleared or destroyed. Iterate() reports the value
+  // as a regular Put. Data() and Release() contain the reference rather than
+  // the value bytes, so a WriteBatch constructed from them reports the
+  // record as corruption. GetDataSize() counts the value bytes.
+  // Not supported for column families with user-defined timestamps.
+  Status PutReferenced(ColumnFamilyHandle* column_family, const Slice& key,
+                       const Slice& value);
+  Status PutReferenced(const Slice& key, const Slice& value) {
+    return PutReferenced(nullptr, key, value);
+  }
+
   // Store the mapping "key->{column1:value1, column2:value2, ...}" in the
   // column family specified by "column_family".
   using WriteBatchBase::PutEntity;
@@ -381,8 +399,9 @@ class WriteBatch : public WriteBatchBase {
   // Release the serialized data and clear this batch.
   std::string Release();
 
-  // Retrieve data size of the batch.
-  size_t GetDataSize() const { return rep_.size(); }
+  // Retrieve data size of the batch, including the values added with
+  // PutReferenced(), which are not part of Data().
+  size_t GetDataSize() const { return rep_.size() + referenced_value_bytes_; }
 
   // Returns the number of updates in the batch
   uint32_t Count() const;
@@ -533,6 +552,9 @@ class WriteBatch : public WriteBatchBase {
   // Maximum size of rep_.
   size_t max_bytes_;
 
+  // Total size of the values added with PutReferenced()
+  size_t referenced_value_bytes_ = 0;
+
   std::unique_ptr<ProtectionInfo> prot_info_;
 
   size_t default_cf_ts_sz_ = 0;
@@ -17,6 +17,7 @@
 #include <cstddef>
 #include <list>
 #include <mutex>
+#include <vector>
 
 #include "rocksdb/cache.h"
 
@@ -47,9 +48,19 @@ class WriteBufferManager final {
   // allow_stall: if set true, it will enable stalling of writes when
   // memory_usage() exceeds buffer_size. It will wait for flush to complete and
   // memory usage to drop down.
+  //
+  // arena_block_pool_size: if > 0, arena blocks of memtables that are freed
+  // (e.g. after flush) are kept in a pool of up to this many bytes and reused
+  // by new memtables instead of being returned to the allocator. This saves
+  // page faults and allocator work when memtables are switched frequently.
+  // Pooled blocks are charged to memory_usage() (and to `cache`, if
+  // provided), and are never kept if doing so would exceed _buffer_size.
+  // The pool is only used by memtables whose memory is tracked by this
+  // manager, i.e. when enabled() or cost_to_cache() is true.
   explicit WriteBufferManager(size_t _buffer_size,
                               std::shared_ptr<Cache> cache = {},
-                              bool allow_stall = false);
+                              bool allow_stall = false,
+                              size_t arena_block_pool_size = 0);
   // No copying allowed
   WriteBufferManager(const WriteBufferManager&) = delete;
   WriteBufferManager& operator=(const WriteBufferManager&) = delete;
@@ -76,6 +87,17 @@ class WriteBufferManager final {
 
   size_t dummy_entries_in_cache_usage() const;
 
+  // Returns the memory held by the arena block pool. It is included in
+  // memory_usage().
+  size_t arena_block_pool_usage() const {
+    return arena_block_pool_usage_.load(std::memory_order_relaxed);
+  }
+
+  // Returns the capacity of the arena block pool. 0 means disabled.
+  size_t arena_block_pool_capacity() const {
+    return arena_block_pool_capacity_;
+  }
+
   // Returns the buffer_size.
   size_t buffer_size() const {
     return buffer_size_.load(std::memory_order_relaxed);
@@ -159,6 +181,21 @@ class WriteBufferManager final {
 
   void RemoveDBFromQueue(StallInterface* wbm_stall);
 
+  // Returns a pooled arena block of exactly `block_size` bytes, or nullptr if
+  // there is none. The returned block is no longer charged as pooled memory,
+  // so the caller must charge it again (usually through its AllocTracker).
+  // `*usable_size` is set to the memory actually held by the block.
+  char* TakeArenaBlock(size_t block_size, size_t* usable_size);
+
+  // Offers `block`, allocated with new char[block_size], to the arena block
+  // pool. Returns true if the pool took ownership of it, in which case its
+  // `usable_size` bytes are charged as pooled memory. Returns false if the
+  // pool is disabled, full or keeping the block would exceed buffer_size().
+  bool ReturnArenaBlock(char* block, size_t block_size, size_t usable_size);
+
+  // Frees all pooled arena blocks.
+  void ReleaseArenaBlockPool();
+
  private:
   std::atomic<size_t> buffer_size_;
   std::atomic<size_t> mutable_limit_;
@@ -177,6 +214,18 @@ class WriteBufferManager final {
   // while holding mu_, but it can be read without a lock.
   std::atomic<bool> stall_active_;
 
+  struct PooledArenaBlock {
+    char* block;
+    size_t block_size;
+    size_t usable_size;
+  };
+  const size_t arena_block_pool_capacity_;
+  // Protected by arena_block_pool_mu_
+  std::vector<PooledArenaBlock> arena_block_pool_;
+  // Can be read without a lock.
+  std::atomic<size_t> arena_block_pool_usage_;
+  std::mutex arena_block_pool_mu_;
+
   void ReserveMemWithCache(size_t mem);
   void FreeMemWithCache(size_t mem);
 };
@@ -6874,6 +6874,9 @@ class IndexTypeJni {
       case ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
           kBinarySearchWithFirstKey:
         return 0x3;
+      case ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
+          kLearnedSearch:
+        return 0x4;
       default:
         return 0x7F;  // undefined
     }
@@ -6896,6 +6899,9 @@ class IndexTypeJni {
       case 0x3:
         return ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
             kBinarySearchWithFirstKey;
+      case 0x4:
+        return ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
+            kLearnedSearch;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
@@ -36,7 +36,13 @@ public enum IndexType {
    * Makes the index significantly bigger (2x or more), especially when keys
    * are long.
    */
-  kBinarySearchWithFirstKey((byte) 3);
+  kBinarySearchWithFirstKey((byte) 3),
+  /**
+   * EXPERIMENTAL. Like {@link #kBinarySearch}, but the table also stores a
+   * small piecewise-linear model of the index block, so that index lookups
+   * only binary search within the window of entries it predicts.
+   */
+  kLearnedSearch((byte) 4);
 
   /**
    * Returns the byte value of the enumerations value
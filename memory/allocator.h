@@ -48,6 +48,10 @@ class AllocTracker {
 
   bool is_freed() const { return write_buffer_manager_ == nullptr || freed_; }
 
+  WriteBufferManager* write_buffer_manager() const {
+    return write_buffer_manager_;
+  }
+
  private:
   WriteBufferManager* write_buffer_manager_;
   std::atomic<size_t> bytes_allocated_;
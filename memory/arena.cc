@@ -53,11 +53,44 @@ Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size)
   }
 }
 
+namespace {
+size_t AllocatedBlockSize(char* block, size_t block_bytes) {
+#ifdef ROCKSDB_MALLOC_USABLE_SIZE
+  (void)block_bytes;
+  return malloc_usable_size(block);
+#else
+  (void)block;
+  return block_bytes;
+#endif  // ROCKSDB_MALLOC_USABLE_SIZE
+}
+}  // namespace
+
 Arena::~Arena() {
   if (tracker_ != nullptr) {
     assert(tracker_->is_freed());
     tracker_->FreeMem();
   }
+  WriteBufferManager* wbm = BlockPoolManager();
+  if (wbm != nullptr) {
+    for (auto& block : regular_blocks_) {
+      if (wbm->ReturnArenaBlock(block.get(), kBlockSize,
+                                AllocatedBlockSize(block.get(), kBlockSize))) {
+        // Now owned by the pool
+        block.release();
+      }
+    }
+  }
+}
+
+WriteBufferManager* Arena::BlockPoolManager() const {
+  if (tracker_ == nullptr) {
+    return nullptr;
+  }
+  WriteBufferManager* wbm = tracker_->write_buffer_manager();
+  if (wbm == nullptr || wbm->arena_block_pool_capacity() == 0) {
+    return nullptr;
+  }
+  return wbm;
 }
 
 char* Arena::AllocateFallback(size_t bytes, bool aligned) {
@@ -143,12 +176,31 @@ char* Arena::AllocateAligned(size_t bytes, size_t huge_page_size,
 }
 
 char* Arena::AllocateNewBlock(size_t block_bytes) {
+  const bool regular = block_bytes == kBlockSize;
+  WriteBufferManager* wbm = regular ? BlockPoolManager() : nullptr;
+  size_t allocated_size;
+  char* block = nullptr;
+  if (wbm != nullptr) {
+    block = wbm->TakeArenaBlock(block_bytes, &allocated_size);
+  }
+  if (block != nullptr) {
+    regular_blocks_.push_back(std::unique_ptr<char[]>(block));
+    blocks_memory_ += allocated_size;
+    if (tracker_ != nullptr) {
+      tracker_->Allocate(allocated_size);
+    }
+    return block;
+  }
+
   // NOTE: std::make_unique zero-initializes the block so is not appropriate
   // here
-  char* block = new char[block_bytes];
-  blocks_.push_back(std::unique_ptr<char[]>(block));
+  block = new char[block_bytes];
+  if (regular) {
+    regular_blocks_.push_back(std::unique_ptr<char[]>(block));
+  } else {
+    blocks_.push_back(std::unique_ptr<char[]>(block));
+  }
 
-  size_t allocated_size;
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
   allocated_size = malloc_usable_size(block);
 #ifndef NDEBUG
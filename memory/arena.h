@@ -10,6 +10,9 @@
 // Arena is an implementation of Allocator class. For a request of small size,
 // it allocates a block with pre-defined block size. For a request of big
 // size, it uses malloc to directly get the requested size.
+//
+// If the arena is tracked by a WriteBufferManager with an arena block pool,
+// blocks of the pre-defined size are taken from and returned to that pool.
 
 #pragma once
 
@@ -64,7 +67,8 @@ class Arena : public Allocator {
   // by the arena (exclude the space allocated but not yet used for future
   // allocations).
   size_t ApproximateMemoryUsage() const {
-    return blocks_memory_ + blocks_.size() * sizeof(char*) -
+    return blocks_memory_ +
+           (blocks_.size() + regular_blocks_.size()) * sizeof(char*) -
            alloc_bytes_remaining_;
   }
 
@@ -79,7 +83,7 @@ class Arena : public Allocator {
   size_t BlockSize() const override { return kBlockSize; }
 
   bool IsInInlineBlock() const {
-    return blocks_.empty() && huge_blocks_.empty();
+    return blocks_.empty() && regular_blocks_.empty() && huge_blocks_.empty();
   }
 
   // check and adjust the block_size so that the return value is
@@ -91,8 +95,11 @@ class Arena : public Allocator {
   alignas(std::max_align_t) char inline_block_[kInlineSize];
   // Number of bytes allocated in one block
   const size_t kBlockSize;
-  // Allocated memory blocks
+  // Allocated memory blocks of irregular size
   std::deque<std::unique_ptr<char[]>> blocks_;
+  // Allocated memory blocks of exactly kBlockSize bytes, which can be
+  // recycled through the write buffer manager's arena block pool
+  std::deque<std::unique_ptr<char[]>> regular_blocks_;
   // Huge page allocations
   std::deque<MemMapping> huge_blocks_;
   size_t irregular_block_num = 0;
@@ -112,6 +119,9 @@ class Arena : public Allocator {
   char* AllocateFromHugePage(size_t bytes);
   char* AllocateFallback(size_t bytes, bool aligned);
   char* AllocateNewBlock(size_t block_bytes);
+  // Returns the write buffer manager whose arena block pool this arena uses,
+  // or nullptr.
+  WriteBufferManager* BlockPoolManager() const;
 
   // Bytes of memory in blocks allocated so far
   size_t blocks_memory_ = 0;
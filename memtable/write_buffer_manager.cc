@@ -20,14 +20,17 @@
 namespace ROCKSDB_NAMESPACE {
 WriteBufferManager::WriteBufferManager(size_t _buffer_size,
                                        std::shared_ptr<Cache> cache,
-                                       bool allow_stall)
+                                       bool allow_stall,
+                                       size_t arena_block_pool_size)
     : buffer_size_(_buffer_size),
       mutable_limit_(buffer_size_ * 7 / 8),
       memory_used_(0),
       memory_active_(0),
       cache_res_mgr_(nullptr),
       allow_stall_(allow_stall),
-      stall_active_(false) {
+      stall_active_(false),
+      arena_block_pool_capacity_(arena_block_pool_size),
+      arena_block_pool_usage_(0) {
   if (cache) {
     // Memtable's memory usage tends to fluctuate frequently
     // therefore we set delayed_decrease = true to save some dummy entry
@@ -43,6 +46,9 @@ WriteBufferManager::~WriteBufferManager() {
   std::unique_lock<std::mutex> lock(mu_);
   assert(queue_.empty());
 #endif
+  for (auto& pooled : arena_block_pool_) {
+    delete[] pooled.block;
+  }
 }
 
 std::size_t WriteBufferManager::dummy_entries_in_cache_usage() const {
@@ -115,9 +121,100 @@ void WriteBufferManager::FreeMemWithCache(size_t mem) {
   s.PermitUncheckedError();
 }
 
+char* WriteBufferManager::TakeArenaBlock(size_t block_size,
+                                         size_t* usable_size) {
+  assert(usable_size != nullptr);
+  if (arena_block_pool_usage() == 0) {
+    return nullptr;
+  }
+  PooledArenaBlock taken{nullptr, 0, 0};
+  {
+    std::lock_guard<std::mutex> lock(arena_block_pool_mu_);
+    // Prefer the most recently returned block, whose pages are the most
+    // likely to still be resident and cached.
+    for (auto it = arena_block_pool_.rbegin(); it != arena_block_pool_.rend();
+         ++it) {
+      if (it->block_size == block_size) {
+        taken = *it;
+        arena_block_pool_.erase(std::next(it).base());
+        arena_block_pool_usage_.fetch_sub(taken.usable_size,
+                                          std::memory_order_relaxed);
+        break;
+      }
+    }
+  }
+  if (taken.block == nullptr) {
+    return nullptr;
+  }
+  // Uncharge as pooled memory. The new owner charges it again.
+  FreeMem(taken.usable_size);
+  *usable_size = taken.usable_size;
+  return taken.block;
+}
+
+bool WriteBufferManager::ReturnArenaBlock(char* block, size_t block_size,
+                                          size_t usable_size) {
+  assert(block != nullptr);
+  if (arena_block_pool_capacity_ == 0 || IsStallActive()) {
+    return false;
+  }
+  if (enabled() && memory_usage() + usable_size > buffer_size()) {
+    // Don't hold on to memory the memtables may need.
+    return false;
+  }
+  // Charge before the block becomes visible to TakeArenaBlock(), which
+  // uncharges it.
+  if (cache_res_mgr_ != nullptr) {
+    ReserveMemWithCache(usable_size);
+  } else if (enabled()) {
+    memory_used_.fetch_add(usable_size, std::memory_order_relaxed);
+  }
+  bool pooled = false;
+  {
+    std::lock_guard<std::mutex> lock(arena_block_pool_mu_);
+    if (arena_block_pool_usage_.load(std::memory_order_relaxed) + usable_size <=
+        arena_block_pool_capacity_) {
+      arena_block_pool_.push_back({block, block_size, usable_size});
+      arena_block_pool_usage_.fetch_add(usable_size,
+                                        std::memory_order_relaxed);
+      pooled = true;
+    }
+  }
+  if (!pooled) {
+    FreeMem(usable_size);
+  }
+  return pooled;
+}
+
+void WriteBufferManager::ReleaseArenaBlockPool() {
+  // Perform all deallocations outside of the lock.
+  std::vector<PooledArenaBlock> released;
+  size_t released_bytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(arena_block_pool_mu_);
+    released.swap(arena_block_pool_);
+    for (auto& pooled : released) {
+      released_bytes += pooled.usable_size;
+    }
+    arena_block_pool_usage_.fetch_sub(released_bytes,
+                                      std::memory_order_relaxed);
+  }
+  for (auto& pooled : released) {
+    delete[] pooled.block;
+  }
+  if (released_bytes > 0) {
+    FreeMem(released_bytes);
+  }
+}
+
 void WriteBufferManager::BeginWriteStall(StallInterface* wbm_stall) {
   assert(wbm_stall != nullptr);
 
+  // Pooled arena blocks must not keep writes stalled.
+  if (arena_block_pool_usage() > 0) {
+    ReleaseArenaBlockPool();
+  }
+
   // Allocate outside of the lock.
   std::list<StallInterface*> new_node = {wbm_stall};
 
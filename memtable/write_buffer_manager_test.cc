@@ -9,6 +9,7 @@
 
 #include "rocksdb/write_buffer_manager.h"
 
+#include "memory/arena.h"
 #include "rocksdb/advanced_cache.h"
 #include "test_util/testharness.h"
 
@@ -78,6 +79,68 @@ TEST_F(WriteBufferManagerTest, ShouldFlush) {
   ASSERT_FALSE(wbf->ShouldFlush());
 }
 
+TEST_F(WriteBufferManagerTest, ArenaBlockPool) {
+  constexpr size_t kBlockSize = 64 * 1024;
+  WriteBufferManager wbm(10 * 1024 * 1024, {} /* cache */,
+                         false /* allow_stall */,
+                         4 * kBlockSize /* arena_block_pool_size */);
+  ASSERT_EQ(wbm.arena_block_pool_capacity(), 4 * kBlockSize);
+
+  size_t arena_usage = 0;
+  {
+    AllocTracker tracker(&wbm);
+    Arena arena(kBlockSize, &tracker);
+    // Fills six regular blocks
+    for (int i = 0; i < 24; ++i) {
+      ASSERT_NE(arena.Allocate(kBlockSize / 4), nullptr);
+    }
+    arena_usage = wbm.memory_usage();
+    ASSERT_GE(arena_usage, 6 * kBlockSize);
+    ASSERT_EQ(wbm.arena_block_pool_usage(), 0);
+    tracker.FreeMem();
+  }
+  // Up to the pool capacity is kept, and still charged
+  size_t pooled = wbm.arena_block_pool_usage();
+  ASSERT_GT(pooled, 0);
+  ASSERT_LE(pooled, 4 * kBlockSize);
+  ASSERT_EQ(wbm.memory_usage(), pooled);
+  ASSERT_EQ(wbm.mutable_memtable_memory_usage(), 0);
+
+  {
+    AllocTracker tracker(&wbm);
+    Arena arena(kBlockSize, &tracker);
+    ASSERT_NE(arena.Allocate(kBlockSize / 4), nullptr);
+    // One block moved from the pool to the arena
+    ASSERT_LT(wbm.arena_block_pool_usage(), pooled);
+    ASSERT_EQ(wbm.memory_usage(), pooled + Arena::kInlineSize);
+    // Blocks of other sizes are not served from the pool
+    size_t usable = 0;
+    ASSERT_EQ(wbm.TakeArenaBlock(2 * kBlockSize, &usable), nullptr);
+    tracker.FreeMem();
+  }
+  ASSERT_EQ(wbm.arena_block_pool_usage(), pooled);
+  ASSERT_EQ(wbm.memory_usage(), pooled);
+
+  wbm.ReleaseArenaBlockPool();
+  ASSERT_EQ(wbm.arena_block_pool_usage(), 0);
+  ASSERT_EQ(wbm.memory_usage(), 0);
+}
+
+TEST_F(WriteBufferManagerTest, ArenaBlockPoolWithinBufferSize) {
+  constexpr size_t kBlockSize = 64 * 1024;
+  WriteBufferManager wbm(kBlockSize, {} /* cache */, false /* allow_stall */,
+                         8 * kBlockSize /* arena_block_pool_size */);
+  char* block = new char[kBlockSize];
+  wbm.ReserveMem(kBlockSize / 2);
+  // Keeping the block would exceed the buffer size
+  ASSERT_FALSE(wbm.ReturnArenaBlock(block, kBlockSize, kBlockSize));
+  ASSERT_EQ(wbm.arena_block_pool_usage(), 0);
+  wbm.FreeMem(kBlockSize / 2);
+  ASSERT_TRUE(wbm.ReturnArenaBlock(block, kBlockSize, kBlockSize));
+  ASSERT_EQ(wbm.memory_usage(), kBlockSize);
+  // Freed with the write buffer manager
+}
+
 class ChargeWriteBufferTest : public testing::Test {};
 
 TEST_F(ChargeWriteBufferTest, Basic) {
@@ -0,0 +1,129 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "monitoring/block_cache_heatmap.h"
+
+#include <algorithm>
+
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// The first lookup of each thread is recorded
+thread_local uint32_t tl_block_cache_heatmap_countdown = 0;
+
+BlockCacheHeatmap::BlockCacheHeatmap(int num_levels)
+    : num_levels_(num_levels),
+      cells_(new Cell[(num_levels + 1) * kNumBlockTypes]) {}
+
+size_t BlockCacheHeatmap::CellIndex(int level, BlockType block_type) const {
+  // Levels beyond the configured ones (e.g. while changing num_levels) are
+  // counted with the last one
+  const size_t level_index =
+      static_cast<size_t>(std::min(std::max(level, -1), num_levels_ - 1) + 1);
+  const size_t type_index =
+      std::min(static_cast<size_t>(block_type), kNumBlockTypes - 1);
+  return level_index * kNumBlockTypes + type_index;
+}
+
+void BlockCacheHeatmap::RecordSample(int level, uint64_t file_number,
+                                     BlockType block_type, bool hit) {
+  if (file_number != 0) {
+    MutexLock l(&file_mutex_);
+    auto it = files_.find(file_number);
+    if (it == files_.end() && files_.size() < kMaxFiles) {
+      it = files_.emplace(file_number, FileState{level, Counts()}).first;
+    }
+    if (it != files_.end()) {
+      level = it->second.level;
+      Counts& counts = it->second.counts;
+      ++(hit ? counts.hits : counts.misses);
+    }
+  }
+  Cell& cell = cells_[CellIndex(level, block_type)];
+  (hit ? cell.hits : cell.misses).FetchAddRelaxed(1);
+}
+
+void BlockCacheHeatmap::OnFileMoved(uint64_t file_number, int level) {
+  MutexLock l(&file_mutex_);
+  auto it = files_.find(file_number);
+  if (it != files_.end()) {
+    it->second.level = level;
+  } else if (files_.size() < kMaxFiles) {
+    // Not looked up yet, but its table reader might already be open for the
+    // former level
+    files_.emplace(file_number, FileState{level, Counts()});
+  }
+}
+
+void BlockCacheHeatmap::OnFileDeleted(uint64_t file_number) {
+  MutexLock l(&file_mutex_);
+  files_.erase(file_number);
+}
+
+BlockCacheHeatmap::Counts BlockCacheHeatmap::GetLevelCounts(
+    int level, BlockType block_type) const {
+  const Cell& cell = cells_[CellIndex(level, block_type)];
+  Counts counts;
+  counts.hits = cell.hits.LoadRelaxed() * kSampleInterval;
+  counts.misses = cell.misses.LoadRelaxed() * kSampleInterval;
+  return counts;
+}
+
+BlockCacheHeatmap::Counts BlockCacheHeatmap::GetLevelCounts(int level) const {
+  Counts total;
+  for (size_t i = 0; i < kNumBlockTypes; ++i) {
+    Counts counts = GetLevelCounts(level, static_cast<BlockType>(i));
+    total.hits += counts.hits;
+    total.misses += counts.misses;
+  }
+  return total;
+}
+
+void BlockCacheHeatmap::GetFileCounts(
+    const std::function<bool(uint64_t)>& is_live,
+    std::map<uint64_t, Counts>* file_counts) {
+  MutexLock l(&file_mutex_);
+  for (auto it = files_.begin(); it != files_.end();) {
+    if (!is_live(it->first)) {
+      it = files_.erase(it);
+      continue;
+    }
+    Counts& counts = (*file_counts)[it->first];
+    counts.hits = it->second.counts.hits * kSampleInterval;
+    counts.misses = it->second.counts.misses * kSampleInterval;
+    ++it;
+  }
+}
+
+const char* BlockCacheHeatmap::BlockTypeName(BlockType block_type) {
+  switch (block_type) {
+    case BlockType::kData:
+      return "data";
+    case BlockType::kFilter:
+      return "filter";
+    case BlockType::kFilterPartitionIndex:
+      return "filter-partition-index";
+    case BlockType::kProperties:
+      return "properties";
+    case BlockType::kCompressionDictionary:
+      return "compression-dict";
+    case BlockType::kRangeDeletion:
+      return "range-deletion";
+    case BlockType::kHashIndexPrefixes:
+      return "hash-index-prefixes";
+    case BlockType::kHashIndexMetadata:
+      return "hash-index-metadata";
+    case BlockType::kMetaIndex:
+      return "meta-index";
+    case BlockType::kIndex:
+      return "index";
+    case BlockType::kInvalid:
+      break;
+  }
+  return "other";
+}
+
+}  // namespace ROCKSDB_NAMESPACE
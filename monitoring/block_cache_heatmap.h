@@ -0,0 +1,109 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "port/port.h"
+#include "table/block_based/block_type.h"
+#include "util/atomic.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Countdown to the next block cache lookup of the current thread to be
+// recorded by a BlockCacheHeatmap
+extern thread_local uint32_t tl_block_cache_heatmap_countdown;
+
+// Always-on counts of the block cache hits and misses of the tables of a
+// column family, by level and block type and by file. Unlike block cache
+// tracing, which records every access for offline analysis, only one in
+// kSampleInterval lookups of each thread is recorded, so that the counts
+// can be kept up to date on the read path. The counts reported are
+// estimates of the actual ones, scaled up by kSampleInterval.
+class BlockCacheHeatmap {
+ public:
+  static constexpr uint32_t kSampleInterval = 64;
+  // Bound on the number of files tracked at once. Files are forgotten once
+  // they are deleted (see OnFileDeleted), or once they are no longer live if
+  // obsolete table readers still record lookups (see GetFileCounts).
+  static constexpr size_t kMaxFiles = 4096;
+
+  struct Counts {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+  };
+
+  explicit BlockCacheHeatmap(int num_levels);
+
+  // To be called on every block cache lookup of a table on `level` (-1 if
+  // unknown). The lookups of tracked files are counted with the level they
+  // were last moved to, as the table reader keeps the level it was opened
+  // for.
+  void Record(int level, uint64_t file_number, BlockType block_type,
+              bool hit) {
+    if (tl_block_cache_heatmap_countdown > 1) {
+      --tl_block_cache_heatmap_countdown;
+      return;
+    }
+    tl_block_cache_heatmap_countdown = kSampleInterval;
+    RecordSample(level, file_number, block_type, hit);
+  }
+
+  // To be called when a version edit moves `file_number` to `level` while
+  // keeping the file, as trivial moves do
+  void OnFileMoved(uint64_t file_number, int level);
+
+  // To be called when a version edit deletes `file_number` without adding
+  // it back
+  void OnFileDeleted(uint64_t file_number);
+
+  Counts GetLevelCounts(int level, BlockType block_type) const;
+
+  // Sums over block types
+  Counts GetLevelCounts(int level) const;
+
+  // Returns the counts of the files for which `is_live` is true, and stops
+  // tracking the others
+  void GetFileCounts(const std::function<bool(uint64_t)>& is_live,
+                     std::map<uint64_t, Counts>* file_counts);
+
+  int num_levels() const { return num_levels_; }
+
+  static const char* BlockTypeName(BlockType block_type);
+
+ private:
+  struct Cell {
+    RelaxedAtomic<uint64_t> hits{0};
+    RelaxedAtomic<uint64_t> misses{0};
+  };
+
+  struct FileState {
+    int level;
+    Counts counts;
+  };
+
+  static constexpr size_t kNumBlockTypes =
+      static_cast<size_t>(BlockType::kInvalid) + 1;
+
+  // Level -1 is stored first
+  size_t CellIndex(int level, BlockType block_type) const;
+
+  void RecordSample(int level, uint64_t file_number, BlockType block_type,
+                    bool hit);
+
+  const int num_levels_;
+  std::unique_ptr<Cell[]> cells_;
+
+  port::Mutex file_mutex_;
+  std::unordered_map<uint64_t, FileState> files_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -273,6 +273,12 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {FILE_READ_CORRUPTION_RETRY_SUCCESS_COUNT,
      "rocksdb.file.read.corruption.retry.success.count"},
     {NUMBER_WBWI_INGEST, "rocksdb.number.wbwi.ingest"},
+    {CACHE_ADMISSION_ADMITTED, "rocksdb.cache.admission.admitted"},
+    {CACHE_ADMISSION_REJECTED, "rocksdb.cache.admission.rejected"},
+    {POINT_LOOKUP_CACHE_HIT, "rocksdb.point.lookup.cache.hit"},
+    {POINT_LOOKUP_CACHE_MISS, "rocksdb.point.lookup.cache.miss"},
+    {COMPACTION_REUSED_DATA_BLOCKS, "rocksdb.compaction.reused.data.blocks"},
+    {COMPACTION_REUSED_DATA_BYTES, "rocksdb.compaction.reused.data.bytes"},
 };
 
 const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
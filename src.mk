@@ -5,13 +5,17 @@ LIB_SOURCES =                                                   \
   cache/cache_key.cc                                            \
   cache/cache_helpers.cc                                        \
   cache/cache_reservation_manager.cc                            \
+  cache/cache_tenant.cc                                         \
   cache/charged_cache.cc                                        \
   cache/clock_cache.cc                                          \
+  cache/frequency_sketch.cc                                     \
   cache/lru_cache.cc                                            \
   cache/compressed_secondary_cache.cc                           \
+  cache/flash_secondary_cache.cc                                \
   cache/secondary_cache.cc                                      \
   cache/secondary_cache_adapter.cc                              \
   cache/sharded_cache.cc                                        \
+  cache/tiered_cache_tuner.cc                                   \
   cache/tiered_secondary_cache.cc                               \
   db/arena_wrapped_db_iter.cc                                   \
   db/attribute_group_iterator_impl.cc                           \
@@ -81,7 +85,9 @@ LIB_SOURCES =                                                   \
   db/merge_helper.cc                                            \
   db/merge_operator.cc                                          \
   db/output_validator.cc                                        \
+  db/partitioned_scan.cc                                        \
   db/periodic_task_scheduler.cc                                 \
+  db/point_lookup_cache.cc                                      \
   db/range_del_aggregator.cc                                    \
   db/range_tombstone_fragmenter.cc                              \
   db/repair.cc                                                  \
@@ -144,6 +150,7 @@ LIB_SOURCES =                                                   \
   memtable/vectorrep.cc                                         \
   memtable/wbwi_memtable.cc                                     \
   memtable/write_buffer_manager.cc                              \
+  monitoring/block_cache_heatmap.cc                             \
   monitoring/histogram.cc                                       \
   monitoring/histogram_windowing.cc                             \
   monitoring/in_memory_stats_history.cc                         \
@@ -184,8 +191,10 @@ LIB_SOURCES =                                                   \
   table/block_based/block_based_table_reader.cc                 \
   table/block_based/block_builder.cc                            \
   table/block_based/block_cache.cc                              \
+  table/block_based/block_learned_index.cc                      \
   table/block_based/block_prefetcher.cc                         \
   table/block_based/block_prefix_index.cc                       \
+  table/block_based/data_block_column_stats.cc                  \
   table/block_based/data_block_hash_index.cc                    \
   table/block_based/data_block_footer.cc                        \
   table/block_based/filter_block_reader_common.cc               \
@@ -195,11 +204,14 @@ LIB_SOURCES =                                                   \
   table/block_based/hash_index_reader.cc                        \
   table/block_based/index_builder.cc                            \
   table/block_based/index_reader_common.cc                      \
+  table/block_based/learned_index_reader.cc                     \
   table/block_based/parsed_full_filter_block.cc                 \
   table/block_based/partitioned_filter_block.cc                 \
   table/block_based/partitioned_index_iterator.cc               \
   table/block_based/partitioned_index_reader.cc                 \
+  table/block_based/range_filter_block.cc                       \
   table/block_based/reader_common.cc                            \
+  table/block_based/restart_key_prefixes.cc                     \
   table/block_based/uncompression_dict_reader.cc                \
   table/block_fetcher.cc                                        \
   table/cuckoo/cuckoo_table_builder.cc                          \
@@ -208,6 +220,7 @@ LIB_SOURCES =                                                   \
   table/external_table.cc					\
   table/format.cc                                               \
   table/get_context.cc                                          \
+  table/hot_key_ranges.cc                                       \
   table/iterator.cc                                             \
   table/merging_iterator.cc                                     \
   table/compaction_merging_iterator.cc                          \
@@ -20,7 +20,9 @@
 #include "port/port.h"
 #include "port/stack_trace.h"
 #include "rocksdb/comparator.h"
+#include "table/block_based/block_learned_index.h"
 #include "table/block_based/block_prefix_index.h"
+#include "table/block_based/restart_key_prefixes.h"
 #include "table/block_based/data_block_footer.h"
 #include "table/format.h"
 #include "util/coding.h"
@@ -307,7 +309,7 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = SeekRestartInterval(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -315,6 +317,29 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   FindKeyAfterBinarySeek(seek_key, index, skip_linear_scan);
 }
 
+bool DataBlockIter::SeekRestartInterval(const Slice& target, uint32_t* index,
+                                        bool* skip_linear_scan) {
+  if (restart_key_prefixes_ == nullptr) {
+    return BinarySeek<DecodeKey>(target, index, skip_linear_scan);
+  }
+  // Restart keys before `lower` are known to be smaller than `target` and
+  // those from `upper` on to be larger, only the ones in between need to be
+  // compared.
+  uint32_t lower = 0, upper = 0;
+  FindRestartKeyPrefixRange(restart_key_prefixes_, num_restarts_,
+                            KeyPrefixAsUint64(ExtractUserKey(target)), &lower,
+                            &upper);
+  if (upper == 0) {
+    // The very first key in the block is the final seek result.
+    *skip_linear_scan = true;
+    *index = 0;
+    return true;
+  }
+  return BinarySeek<DecodeKey>(target, index, skip_linear_scan,
+                               static_cast<int64_t>(lower) - 1,
+                               static_cast<int64_t>(upper) - 1);
+}
+
 void MetaBlockIter::SeekImpl(const Slice& target) {
   Slice seek_key = target;
   PERF_TIMER_GUARD(block_seek_nanos);
@@ -494,6 +519,8 @@ void IndexBlockIter::SeekImpl(const Slice& target) {
     // restart interval must be one when hash search is enabled so the binary
     // search simply lands at the right place.
     skip_linear_scan = true;
+  } else if (learned_index_) {
+    ok = LearnedSeek(seek_key, &index, &skip_linear_scan);
   } else if (value_delta_encoded_) {
     ok = BinarySeek<DecodeKeyV4>(seek_key, &index, &skip_linear_scan);
   } else {
@@ -514,7 +541,7 @@ void DataBlockIter::SeekForPrevImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = SeekRestartInterval(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -827,7 +854,8 @@ void BlockIter<TValue>::FindKeyAfterBinarySeek(const Slice& target,
 template <class TValue>
 template <typename DecodeKeyFunc>
 bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
-                                   bool* skip_linear_scan) {
+                                   bool* skip_linear_scan, int64_t left,
+                                   int64_t right) {
   if (restarts_ == 0) {
     // SST files dedicated to range tombstones are written with index blocks
     // that have no keys while also having `num_restarts_ == 1`. This would
@@ -845,7 +873,10 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
   //   keys.
   // - Any restart keys after index `right` are strictly greater than the target
   //   key.
-  int64_t left = -1, right = num_restarts_ - 1;
+  if (right < 0) {
+    right = num_restarts_ - 1;
+  }
+  assert(left >= -1 && left <= right);
   while (left != right) {
     // The `mid` is computed by rounding up so it lands in (`left`, `right`].
     int64_t mid = left + (right - left + 1) / 2;
@@ -905,6 +936,57 @@ int IndexBlockIter::CompareBlockKey(uint32_t block_index, const Slice& target) {
   return CompareCurrentKey(target);
 }
 
+bool IndexBlockIter::LearnedSeek(const Slice& target, uint32_t* index,
+                                 bool* skip_linear_scan) {
+  assert(learned_index_);
+  if (restarts_ == 0) {
+    // See BinarySeek()
+    return false;
+  }
+  uint32_t first = 0, last = 0;
+  learned_index_->Predict(
+      raw_key_.IsUserKey() ? target : ExtractUserKey(target), &first, &last);
+
+  // Establish the BinarySeek() invariants on the window boundaries. Should the
+  // prediction be off, the window is widened on that side instead. A
+  // boundary key equal to the target is the seek result, as in BinarySeek().
+  int64_t left = -1;
+  int64_t right = num_restarts_ - 1;
+  if (first > 0 && first < num_restarts_) {
+    int cmp = CompareBlockKey(first, target);
+    if (cmp == 0 && status_.ok()) {
+      *index = first;
+      *skip_linear_scan = true;
+      return true;
+    } else if (cmp < 0) {
+      left = first;
+    } else {
+      right = first - 1;
+    }
+  }
+  if (last < right && status_.ok()) {
+    int cmp = CompareBlockKey(last + 1, target);
+    if (cmp == 0 && status_.ok()) {
+      *index = last + 1;
+      *skip_linear_scan = true;
+      return true;
+    } else if (cmp > 0) {
+      right = last;
+    } else {
+      left = last + 1;
+    }
+  }
+  if (!status_.ok()) {
+    return false;
+  }
+
+  if (value_delta_encoded_) {
+    return BinarySeek<DecodeKeyV4>(target, index, skip_linear_scan, left,
+                                   right);
+  }
+  return BinarySeek<DecodeKey>(target, index, skip_linear_scan, left, right);
+}
+
 // Binary search in block_ids to find the first block
 // with a key >= target
 bool IndexBlockIter::BinaryBlockIndexSeek(const Slice& target,
@@ -1050,6 +1132,19 @@ BlockBasedTableOptions::DataBlockIndexType Block::IndexType() const {
   return index_type;
 }
 
+bool Block::HasRestartKeyPrefixes() const {
+  assert(size_ >= 2 * sizeof(uint32_t));
+  if (size_ > kMaxBlockSizeSupportedByHashIndex) {
+    // The check is for the same reason as that in NumRestarts()
+    return false;
+  }
+  uint32_t block_footer = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  bool has_restart_key_prefixes = false;
+  UnPackIndexTypeAndNumRestarts(block_footer, nullptr, nullptr,
+                                &has_restart_key_prefixes);
+  return has_restart_key_prefixes;
+}
+
 Block::~Block() {
   // This sync point can be re-enabled if RocksDB can control the
   // initialization order of any/all static options created by the user.
@@ -1105,6 +1200,18 @@ Block::Block(BlockContents&& contents, size_t read_amp_bytes_per_bit,
       default:
         size_ = 0;  // Error marker
     }
+    if (size_ != 0 && HasRestartKeyPrefixes()) {
+      // The prefix array sits between the restart array and what follows it
+      const uint64_t prefixes_size =
+          uint64_t{num_restarts_} * sizeof(uint64_t);
+      if (prefixes_size > restart_offset_) {
+        size_ = 0;
+      } else {
+        restart_offset_ -= static_cast<uint32_t>(prefixes_size);
+        restart_key_prefixes_ =
+            data_ + restart_offset_ + num_restarts_ * sizeof(uint32_t);
+      }
+    }
   }
   if (read_amp_bytes_per_bit != 0 && statistics && size_ != 0) {
     read_amp_bitmap_.reset(new BlockReadAmpBitmap(
@@ -1275,11 +1382,12 @@ DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
     return ret_iter;
   } else {
     ret_iter->Initialize(
-        raw_ucmp, data_, restart_offset_, num_restarts_, global_seqno,
+        raw_ucmp, data_, size_, restart_offset_, num_restarts_, global_seqno,
         read_amp_bitmap_.get(), block_contents_pinned,
         user_defined_timestamps_persisted,
         data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr,
-        protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
+        restart_key_prefixes_, protection_bytes_per_key_, kv_checksum_,
+        block_restart_interval_);
     if (read_amp_bitmap_) {
       if (read_amp_bitmap_->GetStatistics() != stats) {
         // DB changed the Statistics pointer, we need to notify read_amp_bitmap_
@@ -1296,7 +1404,7 @@ IndexBlockIter* Block::NewIndexIterator(
     IndexBlockIter* iter, Statistics* /*stats*/, bool total_order_seek,
     bool have_first_key, bool key_includes_seq, bool value_is_full,
     bool block_contents_pinned, bool user_defined_timestamps_persisted,
-    BlockPrefixIndex* prefix_index) {
+    BlockPrefixIndex* prefix_index, const BlockLearnedIndex* learned_index) {
   IndexBlockIter* ret_iter;
   if (iter != nullptr) {
     ret_iter = iter;
@@ -1316,8 +1424,8 @@ IndexBlockIter* Block::NewIndexIterator(
         total_order_seek ? nullptr : prefix_index;
     ret_iter->Initialize(
         raw_ucmp, data_, restart_offset_, num_restarts_, global_seqno,
-        prefix_index_ptr, have_first_key, key_includes_seq, value_is_full,
-        block_contents_pinned, user_defined_timestamps_persisted,
+        prefix_index_ptr, learned_index, have_first_key, key_includes_seq,
+        value_is_full, block_contents_pinned, user_defined_timestamps_persisted,
         protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
   }
 
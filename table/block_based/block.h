@@ -39,6 +39,7 @@ class DataBlockIter;
 class IndexBlockIter;
 class MetaBlockIter;
 class BlockPrefixIndex;
+class BlockLearnedIndex;
 
 // BlockReadAmpBitmap is a bitmap that map the ROCKSDB_NAMESPACE::Block data
 // bytes to a bitmap with ratio bytes_per_bit. Whenever we access a range of
@@ -172,6 +173,9 @@ class Block {
 
   BlockBasedTableOptions::DataBlockIndexType IndexType() const;
 
+  // Whether the block carries restart key prefixes (restart_key_prefixes.h).
+  bool HasRestartKeyPrefixes() const;
+
   // raw_ucmp is a raw (i.e., not wrapped by `UserComparatorWrapper`) user key
   // comparator.
   //
@@ -227,6 +231,10 @@ class Block {
   // If `prefix_index` is not nullptr this block will do hash lookup for the key
   // prefix. If total_order_seek is true, prefix_index_ is ignored.
   //
+  // If `learned_index` is not nullptr, seeks binary search only the window of
+  // restart points it predicts for the target, after verifying the window's
+  // boundaries against the block.
+  //
   // `have_first_key` controls whether IndexValue will contain
   // first_internal_key. It affects data serialization format, so the same value
   // have_first_key must be used when writing and reading index.
@@ -239,7 +247,8 @@ class Block {
       bool have_first_key, bool key_includes_seq, bool value_is_full,
       bool block_contents_pinned = false,
       bool user_defined_timestamps_persisted = true,
-      BlockPrefixIndex* prefix_index = nullptr);
+      BlockPrefixIndex* prefix_index = nullptr,
+      const BlockLearnedIndex* learned_index = nullptr);
 
   // Report an approximation of how much memory has been used.
   size_t ApproximateMemoryUsage() const;
@@ -288,6 +297,8 @@ class Block {
   uint32_t block_restart_interval_{0};
   uint8_t protection_bytes_per_key_{0};
   DataBlockHashIndex data_block_hash_index_;
+  // Points into data_ if the block has restart key prefixes
+  const char* restart_key_prefixes_{nullptr};
 };
 
 // A `BlockIter` iterates over the entries in a `Block`'s data buffer. The
@@ -665,9 +676,14 @@ class BlockIter : public InternalIteratorBase<TValue> {
   }
 
  protected:
+  // `left` and `right` optionally narrow the search to restart points
+  // (`left`, `right`], where the restart key at `left` (if not -1) is known to
+  // be <= `target` and every restart key after `right` is known to be
+  // > `target`. `right` of -1 means the last restart point.
   template <typename DecodeKeyFunc>
   inline bool BinarySeek(const Slice& target, uint32_t* index,
-                         bool* is_index_key_result);
+                         bool* is_index_key_result, int64_t left = -1,
+                         int64_t right = -1);
 
   // Find the first key in restart interval `index` that is >= `target`.
   // If there is no such key, iterator is positioned at the first key in
@@ -685,14 +701,18 @@ class BlockIter : public InternalIteratorBase<TValue> {
 class DataBlockIter final : public BlockIter<Slice> {
  public:
   DataBlockIter()
-      : BlockIter(), read_amp_bitmap_(nullptr), last_bitmap_offset_(0) {}
+      : BlockIter(),
+        read_amp_bitmap_(nullptr),
+        last_bitmap_offset_(0),
+        restart_key_prefixes_(nullptr) {}
   void Initialize(const Comparator* raw_ucmp, const char* data,
-                  uint32_t restarts, uint32_t num_restarts,
+                  size_t block_size, uint32_t restarts, uint32_t num_restarts,
                   SequenceNumber global_seqno,
                   BlockReadAmpBitmap* read_amp_bitmap,
                   bool block_contents_pinned,
                   bool user_defined_timestamps_persisted,
                   DataBlockHashIndex* data_block_hash_index,
+                  const char* restart_key_prefixes,
                   uint8_t protection_bytes_per_key, const char* kv_checksum,
                   uint32_t block_restart_interval) {
     InitializeBase(raw_ucmp, data, restarts, num_restarts, global_seqno,
@@ -703,8 +723,15 @@ class DataBlockIter final : public BlockIter<Slice> {
     read_amp_bitmap_ = read_amp_bitmap;
     last_bitmap_offset_ = current_ + 1;
     data_block_hash_index_ = data_block_hash_index;
+    restart_key_prefixes_ = restart_key_prefixes;
+    block_size_ = block_size;
   }
 
+  bool IsAtFirstEntry() const { return Valid() && current_ == 0; }
+
+  // The whole block, as built by a BlockBuilder
+  Slice block_contents() const { return Slice(data_, block_size_); }
+
   Slice value() const override {
     assert(Valid());
     if (read_amp_bitmap_ && current_ < restarts_ &&
@@ -779,8 +806,15 @@ class DataBlockIter final : public BlockIter<Slice> {
   int32_t prev_entries_idx_ = -1;
 
   DataBlockHashIndex* data_block_hash_index_;
+  // Restart key prefix array of the block, if any
+  const char* restart_key_prefixes_;
+  size_t block_size_ = 0;
 
   bool SeekForGetImpl(const Slice& target);
+  // Same contract as BinarySeek(), using restart key prefixes when the block
+  // has them to bound the binary search without decoding keys.
+  bool SeekRestartInterval(const Slice& target, uint32_t* index,
+                           bool* skip_linear_scan);
 };
 
 // Iterator over MetaBlocks.  MetaBlocks are similar to Data Blocks and
@@ -825,7 +859,8 @@ class MetaBlockIter final : public BlockIter<Slice> {
 
 class IndexBlockIter final : public BlockIter<IndexValue> {
  public:
-  IndexBlockIter() : BlockIter(), prefix_index_(nullptr) {}
+  IndexBlockIter()
+      : BlockIter(), prefix_index_(nullptr), learned_index_(nullptr) {}
 
   // key_includes_seq, default true, means that the keys are in internal key
   // format.
@@ -834,6 +869,7 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
   void Initialize(const Comparator* raw_ucmp, const char* data,
                   uint32_t restarts, uint32_t num_restarts,
                   SequenceNumber global_seqno, BlockPrefixIndex* prefix_index,
+                  const BlockLearnedIndex* learned_index,
                   bool have_first_key, bool key_includes_seq,
                   bool value_is_full, bool block_contents_pinned,
                   bool user_defined_timestamps_persisted,
@@ -845,6 +881,7 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
                    kv_checksum, block_restart_interval);
     raw_key_.SetIsUserKey(!key_includes_seq);
     prefix_index_ = prefix_index;
+    learned_index_ = learned_index;
     value_delta_encoded_ = !value_is_full;
     have_first_key_ = have_first_key;
     if (have_first_key_ && global_seqno != kDisableGlobalSequenceNumber) {
@@ -914,6 +951,7 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
   bool value_delta_encoded_;
   bool have_first_key_;  // value includes first_internal_key
   BlockPrefixIndex* prefix_index_;
+  const BlockLearnedIndex* learned_index_;
   // Whether the value is delta encoded. In that case the value is assumed to be
   // BlockHandle. The first value in each restart interval is the full encoded
   // BlockHandle; the restart of encoded size part of the BlockHandle. The
@@ -952,6 +990,11 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
                             uint32_t left, uint32_t right, uint32_t* index,
                             bool* prefix_may_exist);
   inline int CompareBlockKey(uint32_t block_index, const Slice& target);
+  // Binary search restricted to the window of restart points predicted by
+  // `learned_index_`, widened as needed so the result always matches an
+  // unrestricted BinarySeek().
+  bool LearnedSeek(const Slice& target, uint32_t* index,
+                   bool* skip_linear_scan);
 
   inline bool ParseNextIndexKey();
 
@@ -42,12 +42,16 @@
 #include "table/block_based/block_based_table_factory.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/data_block_column_stats.h"
+#include "table/block_based/range_filter_block.h"
 #include "table/block_based/filter_block.h"
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/full_filter_block.h"
 #include "table/block_based/partitioned_filter_block.h"
 #include "table/format.h"
+#include "table/hot_key_ranges.h"
 #include "table/meta_blocks.h"
+#include "table/reusable_data_block.h"
 #include "table/table_builder.h"
 #include "util/coding.h"
 #include "util/compression.h"
@@ -256,6 +260,10 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     // checking for "has no value". Only at the end of its life will it be
     // assigned "no value". Thus, it needs to start with a value.
     std::optional<std::string> first_key_in_next_block = std::string{};
+    // See data_block_column_stats
+    std::string column_stats;
+    // Whether the block holds keys of hot_key_ranges
+    bool hot = false;
     Keys keys;
     BlockRepSlot slot;
     Status status;
@@ -514,6 +522,8 @@ struct BlockBasedTableBuilder::Rep {
   // compression dictionary is enabled so we can finalize the dictionary before
   // compressing any data blocks.
   std::vector<std::string> data_block_buffers;
+  // Whether each of data_block_buffers holds keys of hot_key_ranges
+  std::vector<bool> data_block_buffers_hot;
   BlockBuilder range_del_block;
 
   InternalKeySliceTransform internal_prefix_transform;
@@ -524,6 +534,33 @@ struct BlockBasedTableBuilder::Rep {
   std::string last_ikey;  // Internal key or empty (unset)
   const Slice* first_key_in_next_block = nullptr;
   bool warm_cache = false;
+  // For compactions with PrepopulateBlockCache::kFlushAndCompaction, data
+  // blocks holding keys of these ranges are inserted into the block cache
+  HotKeyRanges* hot_key_ranges = nullptr;
+  size_t hot_key_cursor = 0;
+  // Whether the data block being built holds keys of hot_key_ranges
+  bool data_block_hot = false;
+  // Whether the data block being written is to be inserted into the block
+  // cache because of hot_key_ranges. Only accessed by the thread writing data
+  // blocks.
+  bool warm_data_block = false;
+
+  // For compactions with reuse_data_blocks_in_compaction, see
+  // ReusableDataBlock. Only when the data blocks are compressed as they are
+  // built, by a builtin compressor without dictionary, are neither inserted
+  // into the block cache nor summarized by column stats, and when data
+  // blocks are cut by size, as reused data blocks also have about the
+  // configured size.
+  bool reuse_data_blocks = false;
+  // The type data blocks are compressed with, if compression pays off
+  CompressionType reusable_compression_type = kNoCompression;
+  // Whether the entries added since reusable_block was set are the entries
+  // of reusable_block, which are not added to data_block
+  bool in_reusable_block = false;
+  ReusableDataBlock reusable_block;
+  // Announced for the next entry added, which starts a new data block
+  ReusableDataBlock next_reusable_block;
+  bool has_next_reusable_block = false;
 
   uint64_t sample_for_compression;
   std::atomic<uint64_t> compressible_input_data_bytes;
@@ -607,6 +644,11 @@ struct BlockBasedTableBuilder::Rep {
   BlockHandle pending_handle;  // Handle to add to index block
 
   std::string single_threaded_compressed_output;
+  // Set if data_block_column_stats is not empty
+  std::unique_ptr<DataBlockColumnStatsBuilder> column_stats_builder;
+  std::string single_threaded_column_stats;
+  // Set if range_filter is enabled and usable with the comparator
+  std::unique_ptr<RangeFilterBuilder> range_filter_builder;
   std::unique_ptr<FlushBlockPolicy> flush_block_policy;
 
   std::vector<std::unique_ptr<InternalTblPropColl>> table_properties_collectors;
@@ -720,7 +762,13 @@ struct BlockBasedTableBuilder::Rep {
                        ? BlockBasedTableOptions::kDataBlockBinarySearch
                        : table_options.data_block_index_type,
                    table_options.data_block_hash_table_util_ratio, ts_sz,
-                   persist_user_defined_timestamps),
+                   persist_user_defined_timestamps, false /* is_user_key */,
+                   table_options.data_block_restart_key_prefixes &&
+                       FormatVersionSupportsRestartKeyPrefixes(
+                           table_options.format_version) &&
+                       ts_sz == 0 &&
+                       tbo.internal_comparator.user_comparator()
+                               ->GetRootComparator() == BytewiseComparator()),
         range_del_block(
             1 /* block_restart_interval */, true /* use_delta_encoding */,
             false /* use_value_delta_encoding */,
@@ -754,6 +802,17 @@ struct BlockBasedTableBuilder::Rep {
         tail_size(0),
         status_ok(true),
         io_status_ok(true) {
+    if (!table_options.data_block_column_stats.empty()) {
+      column_stats_builder.reset(new DataBlockColumnStatsBuilder(
+          table_options.data_block_column_stats));
+    }
+    if (table_options.range_filter && ts_sz == 0 &&
+        tbo.internal_comparator.user_comparator()->GetRootComparator() ==
+            BytewiseComparator()) {
+      range_filter_builder.reset(
+          new RangeFilterBuilder(table_options.range_filter_suffix_bytes));
+    }
+
     FilterBuildingContext filter_context(table_options);
 
     filter_context.info_log = ioptions.logger;
@@ -834,6 +893,13 @@ struct BlockBasedTableBuilder::Rep {
       case BlockBasedTableOptions::PrepopulateBlockCache::kFlushOnly:
         warm_cache = (reason == TableFileCreationReason::kFlush);
         break;
+      case BlockBasedTableOptions::PrepopulateBlockCache::kFlushAndCompaction:
+        warm_cache = (reason == TableFileCreationReason::kFlush);
+        if (reason == TableFileCreationReason::kCompaction &&
+            table_options.block_cache) {
+          hot_key_ranges = tbo.hot_key_ranges;
+        }
+        break;
       case BlockBasedTableOptions::PrepopulateBlockCache::kDisable:
         warm_cache = false;
         break;
@@ -843,6 +909,19 @@ struct BlockBasedTableBuilder::Rep {
         warm_cache = false;
     }
 
+    reuse_data_blocks =
+        table_options.reuse_data_blocks_in_compaction &&
+        reason == TableFileCreationReason::kCompaction &&
+        tbo.moptions.compression_manager == nullptr &&
+        state == State::kUnbuffered && !IsParallelCompressionEnabled() &&
+        !warm_cache && hot_key_ranges == nullptr &&
+        column_stats_builder == nullptr &&
+        strcmp(table_options.flush_block_policy_factory->Name(),
+               FlushBlockBySizePolicyFactory::kClassName()) == 0;
+    if (basic_compressor) {
+      reusable_compression_type = tbo.compression_type;
+    }
+
     const auto compress_dict_build_buffer_charged =
         table_options.cache_usage_options.options_overrides
             .at(CacheEntryRole::kCompressionDictionaryBuildingBuffer)
@@ -1016,9 +1095,20 @@ void BlockBasedTableBuilder::Add(const Slice& ikey, const Slice& value) {
     }
 #endif  // !NDEBUG
 
-    auto should_flush = r->flush_block_policy->Update(ikey, value);
+    bool should_flush;
+    if (r->in_reusable_block &&
+        r->internal_comparator.Compare(ikey, r->reusable_block.separator) >
+            0) {
+      // Past the reusable data block, which is written by Flush()
+      should_flush = true;
+    } else if (r->has_next_reusable_block) {
+      should_flush = !r->data_block.empty();
+    } else {
+      should_flush = !r->in_reusable_block &&
+                     r->flush_block_policy->Update(ikey, value);
+    }
     if (should_flush) {
-      assert(!r->data_block.empty());
+      assert(!r->data_block.empty() || r->in_reusable_block);
       r->first_key_in_next_block = &ikey;
       Flush();
       if (r->state == Rep::State::kBuffered) {
@@ -1077,7 +1167,21 @@ void BlockBasedTableBuilder::Add(const Slice& ikey, const Slice& value) {
       }
     }
 
-    r->data_block.AddWithLastKey(ikey, value, r->last_ikey);
+    if (r->range_filter_builder) {
+      r->range_filter_builder->AddKey(ExtractUserKey(ikey));
+    }
+    if (r->has_next_reusable_block) {
+      std::swap(r->reusable_block, r->next_reusable_block);
+      r->has_next_reusable_block = false;
+      r->in_reusable_block = true;
+    }
+    if (!r->in_reusable_block) {
+      r->data_block.AddWithLastKey(ikey, value, r->last_ikey);
+    }
+    if (r->hot_key_ranges != nullptr && !r->data_block_hot) {
+      r->data_block_hot = r->hot_key_ranges->Contains(ExtractUserKey(ikey),
+                                                      &r->hot_key_cursor);
+    }
     r->last_ikey.assign(ikey.data(), ikey.size());
     assert(!r->last_ikey.empty());
     if (r->state == Rep::State::kBuffered) {
@@ -1133,12 +1237,94 @@ void BlockBasedTableBuilder::Add(const Slice& ikey, const Slice& value) {
   }
 }
 
+void BlockBasedTableBuilder::SetReusableDataBlock(ReusableDataBlock&& block) {
+  Rep* r = rep_;
+  if (!r->reuse_data_blocks || r->state != Rep::State::kUnbuffered) {
+    return;
+  }
+  // Blocks compressed differently than this table would compress them are
+  // not reused. That includes blocks that were not worth compressing, as the
+  // input table might not have been compressed at all.
+  if (block.format_version != r->table_options.format_version ||
+      block.compression_type != r->reusable_compression_type) {
+    return;
+  }
+  r->next_reusable_block = std::move(block);
+  r->has_next_reusable_block = true;
+}
+
+void BlockBasedTableBuilder::AbandonReusableDataBlock() {
+  Rep* r = rep_;
+  if (!r->in_reusable_block) {
+    return;
+  }
+  r->in_reusable_block = false;
+  if (!ok()) {
+    return;
+  }
+  // The entries added since are the first ones of the block, up to
+  // last_ikey, which are added to the data block as they would have been
+  const ReusableDataBlock& reusable = r->reusable_block;
+  BlockContents contents;
+  if (reusable.compression_type == kNoCompression) {
+    contents = BlockContents(reusable.stored_contents);
+  } else {
+    r->SetStatus(DecompressBlockData(
+        reusable.stored_contents.data(), reusable.stored_contents.size(),
+        reusable.compression_type, *r->basic_decompressor, &contents,
+        r->ioptions));
+    if (!ok()) {
+      return;
+    }
+  }
+  Block block(std::move(contents));
+  std::unique_ptr<DataBlockIter> iter(block.NewDataIterator(
+      r->internal_comparator.user_comparator(), kDisableGlobalSequenceNumber));
+  std::string last_key;
+  for (iter->SeekToFirst();
+       iter->Valid() &&
+       r->internal_comparator.Compare(iter->key(), r->last_ikey) <= 0;
+       iter->Next()) {
+    r->data_block.AddWithLastKey(iter->key(), iter->value(), last_key);
+    last_key.assign(iter->key().data(), iter->key().size());
+  }
+  r->SetStatus(iter->status());
+}
+
+void BlockBasedTableBuilder::WriteReusableDataBlock() {
+  Rep* r = rep_;
+  assert(r->in_reusable_block);
+  r->in_reusable_block = false;
+  const ReusableDataBlock& reusable = r->reusable_block;
+  NotifyCollectTableCollectorsOnBlockAdd(
+      r->table_properties_collectors, reusable.uncompressed_size,
+      0 /*block_compressed_bytes_slow*/, 0 /*block_compressed_bytes_fast*/);
+  r->compressible_input_data_bytes.fetch_add(reusable.uncompressed_size,
+                                             std::memory_order_relaxed);
+  r->uncompressible_input_data_bytes.fetch_add(kBlockTrailerSize,
+                                               std::memory_order_relaxed);
+  RecordTick(r->ioptions.stats, COMPACTION_REUSED_DATA_BLOCKS);
+  RecordTick(r->ioptions.stats, COMPACTION_REUSED_DATA_BYTES,
+             reusable.uncompressed_size);
+  const Slice stored = reusable.stored_contents;
+  WriteMaybeCompressedBlock(stored, reusable.compression_type,
+                            &r->pending_handle, BlockType::kData, &stored);
+  // Counted as it was before compression
+  r->pre_compression_size += reusable.uncompressed_size - stored.size();
+  r->props.data_size = r->get_offset();
+  ++r->props.num_data_blocks;
+}
+
 void BlockBasedTableBuilder::Flush() {
   Rep* r = rep_;
   assert(rep_->state != Rep::State::kClosed);
   if (!ok()) {
     return;
   }
+  if (r->in_reusable_block) {
+    WriteReusableDataBlock();
+    return;
+  }
   if (r->data_block.empty()) {
     return;
   }
@@ -1220,23 +1406,27 @@ void BlockBasedTableBuilder::Flush() {
     r->data_block.SwapAndReset(uncompressed_block_holder);
     assert(uncompressed_block_data.size() == uncompressed_block_holder.size());
     rep_->data_block_buffers.emplace_back(std::move(uncompressed_block_holder));
+    rep_->data_block_buffers_hot.push_back(r->data_block_hot);
     rep_->data_begin_offset += uncompressed_block_data.size();
   } else if (r->IsParallelCompressionEnabled()) {
     assert(rep_->state == Rep::State::kUnbuffered);
     ParallelCompressionRep::BlockRep* block_rep =
         r->pc_rep->PrepareBlock(r->first_key_in_next_block, &(r->data_block));
     assert(block_rep != nullptr);
+    block_rep->hot = r->data_block_hot;
     r->pc_rep->file_size_estimator.EmitBlock(block_rep->uncompressed.size(),
                                              r->get_offset());
     r->pc_rep->EmitBlock(block_rep);
   } else {
     assert(rep_->state == Rep::State::kUnbuffered);
+    r->warm_data_block = r->data_block_hot;
     WriteBlock(uncompressed_block_data, &r->pending_handle, BlockType::kData);
     r->data_block.Reset();
   }
+  r->data_block_hot = false;
 }
 
-void BlockBasedTableBuilder::WriteBlock(const Slice& uncompressed_block_data,
+void BlockBasedTableBuilder::WriteBlock(const Slice& block_data,
                                         BlockHandle* handle,
                                         BlockType block_type) {
   Rep* r = rep_;
@@ -1244,6 +1434,11 @@ void BlockBasedTableBuilder::WriteBlock(const Slice& uncompressed_block_data,
   CompressionType type;
   Status compress_status;
   bool is_data_block = block_type == BlockType::kData;
+  Slice uncompressed_block_data = block_data;
+  if (is_data_block && r->column_stats_builder) {
+    r->column_stats_builder->ComputeBlockStats(
+        block_data, &r->single_threaded_column_stats);
+  }
   CompressAndVerifyBlock(
       uncompressed_block_data, is_data_block,
       is_data_block ? r->data_block_working_areas[0] : r->basic_working_area,
@@ -1262,6 +1457,10 @@ void BlockBasedTableBuilder::WriteBlock(const Slice& uncompressed_block_data,
                             type, handle, block_type, &uncompressed_block_data);
   r->single_threaded_compressed_output.clear();
   if (is_data_block) {
+    if (ok() && r->column_stats_builder) {
+      r->column_stats_builder->AddBlock(handle->offset(),
+                                        r->single_threaded_column_stats);
+    }
     r->props.data_size = r->get_offset();
     ++r->props.num_data_blocks;
   }
@@ -1273,6 +1472,10 @@ void BlockBasedTableBuilder::BGWorkCompression(WorkingAreaPair& working_area) {
     assert(block_rep != nullptr);
     // Skip compression if we are aborting anyway
     if (ok()) {
+      if (rep_->column_stats_builder) {
+        rep_->column_stats_builder->ComputeBlockStats(
+            block_rep->uncompressed, &block_rep->column_stats);
+      }
       CompressAndVerifyBlock(block_rep->uncompressed, true, /* is_data_block*/
                              working_area, &block_rep->compressed,
                              &block_rep->compression_type, &block_rep->status);
@@ -1459,7 +1662,9 @@ void BlockBasedTableBuilder::WriteMaybeCompressedBlock(
     }
   }
 
-  if (r->warm_cache) {
+  if (r->warm_cache ||
+      (is_data_block && r->warm_data_block &&
+       r->hot_key_ranges->TryCharge(uncompressed_block_data->size()))) {
     Status s =
         InsertBlockInCacheHelper(*uncompressed_block_data, handle, block_type);
     if (!s.ok()) {
@@ -1537,6 +1742,7 @@ void BlockBasedTableBuilder::BGWorkWriteMaybeCompressedBlock() {
         block_rep->uncompressed.size());
     Slice compressed = block_rep->compressed;
     Slice uncompressed = block_rep->uncompressed;
+    r->warm_data_block = block_rep->hot;
     WriteMaybeCompressedBlock(block_rep->compression_type == kNoCompression
                                   ? uncompressed
                                   : compressed,
@@ -1546,6 +1752,10 @@ void BlockBasedTableBuilder::BGWorkWriteMaybeCompressedBlock() {
       break;
     }
 
+    if (r->column_stats_builder) {
+      r->column_stats_builder->AddBlock(r->pending_handle.offset(),
+                                        block_rep->column_stats);
+    }
     r->props.data_size = r->get_offset();
     ++r->props.num_data_blocks;
 
@@ -1890,6 +2100,31 @@ void BlockBasedTableBuilder::WriteRangeDelBlock(
   }
 }
 
+void BlockBasedTableBuilder::WriteDataBlockColumnStatsBlock(
+    MetaIndexBuilder* meta_index_builder) {
+  if (ok() && rep_->column_stats_builder &&
+      !rep_->column_stats_builder->empty()) {
+    BlockHandle column_stats_block_handle;
+    WriteMaybeCompressedBlock(rep_->column_stats_builder->Finish(),
+                              kNoCompression, &column_stats_block_handle,
+                              BlockType::kProperties);
+    meta_index_builder->Add(kDataBlockColumnStatsBlock,
+                            column_stats_block_handle);
+  }
+}
+
+void BlockBasedTableBuilder::WriteRangeFilterBlock(
+    MetaIndexBuilder* meta_index_builder) {
+  if (ok() && rep_->range_filter_builder &&
+      !rep_->range_filter_builder->empty()) {
+    BlockHandle range_filter_block_handle;
+    WriteMaybeCompressedBlock(rep_->range_filter_builder->Finish(),
+                              kNoCompression, &range_filter_block_handle,
+                              BlockType::kProperties);
+    meta_index_builder->Add(kRangeFilterBlock, range_filter_block_handle);
+  }
+}
+
 void BlockBasedTableBuilder::WriteFooter(BlockHandle& metaindex_block_handle,
                                          BlockHandle& index_block_handle) {
   assert(ok());
@@ -2055,6 +2290,7 @@ void BlockBasedTableBuilder::EnterUnbuffered() {
           first_key_in_next_block_ptr, &data_block, &keys);
 
       assert(block_rep != nullptr);
+      block_rep->hot = r->data_block_buffers_hot[i];
       r->pc_rep->file_size_estimator.EmitBlock(block_rep->uncompressed.size(),
                                                r->get_offset());
       r->pc_rep->EmitBlock(block_rep);
@@ -2071,6 +2307,7 @@ void BlockBasedTableBuilder::EnterUnbuffered() {
         }
         r->index_builder->OnKeyAdded(key);
       }
+      r->warm_data_block = r->data_block_buffers_hot[i];
       WriteBlock(Slice(data_block), &r->pending_handle, BlockType::kData);
       if (ok() && i + 1 < r->data_block_buffers.size()) {
         assert(next_block_iter != nullptr);
@@ -2088,6 +2325,7 @@ void BlockBasedTableBuilder::EnterUnbuffered() {
     std::swap(iter, next_block_iter);
   }
   r->data_block_buffers.clear();
+  r->data_block_buffers_hot.clear();
   r->data_begin_offset = 0;
   // Release all reserved cache for data block buffers
   if (r->compression_dict_buffer_cache_res_mgr != nullptr) {
@@ -2100,6 +2338,9 @@ void BlockBasedTableBuilder::EnterUnbuffered() {
 Status BlockBasedTableBuilder::Finish() {
   Rep* r = rep_;
   assert(r->state != Rep::State::kClosed);
+  // Whether all the entries of the reusable data block were added is only
+  // known from the entry after them
+  AbandonReusableDataBlock();
   bool empty_data_block = r->data_block.empty();
   r->first_key_in_next_block = nullptr;
   Flush();
@@ -2139,6 +2380,8 @@ Status BlockBasedTableBuilder::Finish() {
   WriteIndexBlock(&meta_index_builder, &index_block_handle);
   WriteCompressionDictBlock(&meta_index_builder);
   WriteRangeDelBlock(&meta_index_builder);
+  WriteDataBlockColumnStatsBlock(&meta_index_builder);
+  WriteRangeFilterBlock(&meta_index_builder);
   WritePropertiesBlock(&meta_index_builder);
   if (ok()) {
     // flush the meta index block
@@ -180,7 +180,8 @@ static std::unordered_map<std::string, BlockBasedTableOptions::IndexType>
         {"kTwoLevelIndexSearch",
          BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch},
         {"kBinarySearchWithFirstKey",
-         BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey}};
+         BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey},
+        {"kLearnedSearch", BlockBasedTableOptions::IndexType::kLearnedSearch}};
 
 static std::unordered_map<std::string,
                           BlockBasedTableOptions::DataBlockIndexType>
@@ -221,7 +222,9 @@ static std::unordered_map<std::string,
     block_base_table_prepopulate_block_cache_string_map = {
         {"kDisable", BlockBasedTableOptions::PrepopulateBlockCache::kDisable},
         {"kFlushOnly",
-         BlockBasedTableOptions::PrepopulateBlockCache::kFlushOnly}};
+         BlockBasedTableOptions::PrepopulateBlockCache::kFlushOnly},
+        {"kFlushAndCompaction", BlockBasedTableOptions::PrepopulateBlockCache::
+                                    kFlushAndCompaction}};
 
 static struct BlockBasedTableTypeInfo {
   std::unordered_map<std::string, OptionTypeInfo> info;
@@ -273,6 +276,25 @@ static struct BlockBasedTableTypeInfo {
          {offsetof(struct BlockBasedTableOptions,
                    data_block_hash_table_util_ratio),
           OptionType::kDouble, OptionVerificationType::kNormal}},
+        {"data_block_restart_key_prefixes",
+         {offsetof(struct BlockBasedTableOptions,
+                   data_block_restart_key_prefixes),
+          OptionType::kBoolean, OptionVerificationType::kNormal}},
+        {"data_block_column_stats",
+         OptionTypeInfo::Vector<std::string>(
+             offsetof(struct BlockBasedTableOptions, data_block_column_stats),
+             OptionVerificationType::kNormal, OptionTypeFlags::kNone,
+             {0, OptionType::kEncodedString})},
+        {"range_filter",
+         {offsetof(struct BlockBasedTableOptions, range_filter),
+          OptionType::kBoolean, OptionVerificationType::kNormal}},
+        {"range_filter_suffix_bytes",
+         {offsetof(struct BlockBasedTableOptions, range_filter_suffix_bytes),
+          OptionType::kUInt32T, OptionVerificationType::kNormal}},
+        {"reuse_data_blocks_in_compaction",
+         {offsetof(struct BlockBasedTableOptions,
+                   reuse_data_blocks_in_compaction),
+          OptionType::kBoolean, OptionVerificationType::kNormal}},
         {"checksum",
          {offsetof(struct BlockBasedTableOptions, checksum),
           OptionType::kChecksumType, OptionVerificationType::kNormal}},
@@ -385,6 +407,10 @@ static struct BlockBasedTableTypeInfo {
          OptionTypeInfo::Enum<BlockBasedTableOptions::PrepopulateBlockCache>(
              offsetof(struct BlockBasedTableOptions, prepopulate_block_cache),
              &block_base_table_prepopulate_block_cache_string_map)},
+        {"prepopulate_block_cache_compaction_budget",
+         {offsetof(struct BlockBasedTableOptions,
+                   prepopulate_block_cache_compaction_budget),
+          OptionType::kUInt64T, OptionVerificationType::kNormal}},
         {"initial_auto_readahead_size",
          {offsetof(struct BlockBasedTableOptions, initial_auto_readahead_size),
           OptionType::kSizeT, OptionVerificationType::kNormal}},
@@ -578,7 +604,8 @@ Status BlockBasedTableFactory::NewTableReader(
       table_reader_options.max_file_size_for_l0_meta_pin,
       table_reader_options.cur_db_session_id, table_reader_options.cur_file_num,
       table_reader_options.unique_id,
-      table_reader_options.user_defined_timestamps_persisted);
+      table_reader_options.user_defined_timestamps_persisted,
+      table_reader_options.block_cache_heatmap);
 }
 
 TableBuilder* BlockBasedTableFactory::NewTableBuilder(
@@ -768,6 +795,26 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  data_block_hash_table_util_ratio: %lf\n",
            table_options_.data_block_hash_table_util_ratio);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_restart_key_prefixes: %d\n",
+           table_options_.data_block_restart_key_prefixes);
+  ret.append(buffer);
+  ret.append("  data_block_column_stats: ");
+  for (size_t i = 0; i < table_options_.data_block_column_stats.size(); ++i) {
+    if (i > 0) {
+      ret.append(":");
+    }
+    ret.append(table_options_.data_block_column_stats[i]);
+  }
+  ret.append("\n");
+  snprintf(buffer, kBufferSize, "  range_filter: %d\n",
+           table_options_.range_filter);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  range_filter_suffix_bytes: %u\n",
+           table_options_.range_filter_suffix_bytes);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  reuse_data_blocks_in_compaction: %d\n",
+           table_options_.reuse_data_blocks_in_compaction);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  checksum: %d\n", table_options_.checksum);
   ret.append(buffer);
   snprintf(buffer, kBufferSize, "  no_block_cache: %d\n",
@@ -845,6 +892,10 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  prepopulate_block_cache: %d\n",
            static_cast<int>(table_options_.prepopulate_block_cache));
   ret.append(buffer);
+  snprintf(buffer, kBufferSize,
+           "  prepopulate_block_cache_compaction_budget: %" PRIu64 "\n",
+           table_options_.prepopulate_block_cache_compaction_budget);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize,
            "  initial_auto_readahead_size: %" ROCKSDB_PRIszt "\n",
            table_options_.initial_auto_readahead_size);
@@ -980,6 +1031,10 @@ const std::string BlockBasedTablePropertyNames::kDecoupledPartitionedFilters =
 const std::string kHashIndexPrefixesBlock = "rocksdb.hashindex.prefixes";
 const std::string kHashIndexPrefixesMetadataBlock =
     "rocksdb.hashindex.metadata";
+const std::string kLearnedIndexModelBlock = "rocksdb.learnedindex.model";
+const std::string kDataBlockColumnStatsBlock =
+    "rocksdb.datablock.columnstats";
+const std::string kRangeFilterBlock = "rocksdb.rangefilter";
 const std::string kPropTrue = "1";
 const std::string kPropFalse = "0";
 
@@ -8,6 +8,14 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "table/block_based/block_based_table_iterator.h"
 
+#include <algorithm>
+
+#include "db/wide/wide_columns_helper.h"
+#include "table/block_fetcher.h"
+#include "table/reusable_data_block.h"
+#include "util/coding.h"
+#include "util/stop_watch.h"
+
 namespace ROCKSDB_NAMESPACE {
 
 void BlockBasedTableIterator::SeekToFirst() { SeekImpl(nullptr, false); }
@@ -59,15 +67,19 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
       is_first_pass && read_options_.auto_readahead_size &&
       (read_options_.iterate_upper_bound || read_options_.prefix_same_as_start);
 
+  // Readahead would also fetch the blocks that scan_predicate_ skips
   if (autotune_readaheadsize &&
       table_->get_rep()->table_options.block_cache.get() &&
-      direction_ == IterDirection::kForward) {
+      direction_ == IterDirection::kForward && scan_predicate_ == nullptr) {
     readahead_cache_lookup_ = true;
   }
 
   is_out_of_bound_ = false;
   is_at_first_key_from_index_ = false;
   seek_stat_state_ = kNone;
+  if (SkipFile()) {
+    return;
+  }
   bool filter_checked = false;
   if (target &&
       !CheckPrefixMayMatch(*target, IterDirection::kForward, &filter_checked)) {
@@ -77,6 +89,12 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
                                             : NON_LAST_LEVEL_SEEK_FILTERED);
     return;
   }
+  if (target && !CheckRangeMayMatch(*target, &filter_checked)) {
+    RecordTick(table_->GetStatistics(), is_last_level_
+                                            ? LAST_LEVEL_SEEK_FILTERED
+                                            : NON_LAST_LEVEL_SEEK_FILTERED);
+    return;
+  }
   if (filter_checked) {
     seek_stat_state_ = kFilterUsed;
     RecordTick(table_->GetStatistics(), is_last_level_
@@ -144,7 +162,8 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
   } else {
     // Need to use the data block.
     if (!same_block) {
-      if (read_options_.async_io && async_prefetch) {
+      if (read_options_.async_io && async_prefetch &&
+          FindPreparedBlock(v.handle) == nullptr) {
         AsyncInitDataBlock(/*is_first_pass=*/true);
         if (async_read_in_progress_) {
           // Status::TryAgain indicates asynchronous request for retrieval of
@@ -186,6 +205,9 @@ void BlockBasedTableIterator::SeekForPrev(const Slice& target) {
   is_out_of_bound_ = false;
   is_at_first_key_from_index_ = false;
   seek_stat_state_ = kNone;
+  if (SkipFile()) {
+    return;
+  }
   bool filter_checked = false;
   // For now totally disable prefix seek in auto prefix mode because we don't
   // have logic
@@ -260,6 +282,9 @@ void BlockBasedTableIterator::SeekToLast() {
   is_out_of_bound_ = false;
   is_at_first_key_from_index_ = false;
   seek_stat_state_ = kNone;
+  if (SkipFile()) {
+    return;
+  }
 
   SavePrevIndexValue();
 
@@ -367,6 +392,7 @@ void BlockBasedTableIterator::InitDataBlock() {
     bool is_for_compaction =
         lookup_context_.caller == TableReaderCaller::kCompaction;
 
+    CachableEntry<Block>* prepared_block = nullptr;
     // Initialize Data Block From CacheableEntry.
     if (is_in_cache) {
       Status s;
@@ -374,6 +400,13 @@ void BlockBasedTableIterator::InitDataBlock() {
       table_->NewDataBlockIterator<DataBlockIter>(
           read_options_, (block_handles_->front().cachable_entry_).As<Block>(),
           &block_iter_, s);
+    } else if ((prepared_block = FindPreparedBlock(data_block_handle)) !=
+               nullptr) {
+      Status s;
+      block_iter_.Invalidate(Status::OK());
+      table_->NewDataBlockIterator<DataBlockIter>(read_options_,
+                                                  *prepared_block,
+                                                  &block_iter_, s);
     } else {
       auto* rep = table_->get_rep();
 
@@ -398,13 +431,17 @@ void BlockBasedTableIterator::InitDataBlock() {
           /*no_sequential_checking=*/false, read_options_, readaheadsize_cb,
           read_options_.async_io);
 
-      Status s;
-      table_->NewDataBlockIterator<DataBlockIter>(
-          read_options_, data_block_handle, &block_iter_, BlockType::kData,
-          /*get_context=*/nullptr, &lookup_context_,
-          block_prefetcher_.prefetch_buffer(),
-          /*for_compaction=*/is_for_compaction, /*async_read=*/false, s,
-          use_block_cache_for_lookup);
+      if (ReadsStoredDataBlocks()) {
+        ReadStoredDataBlock(data_block_handle);
+      } else {
+        Status s;
+        table_->NewDataBlockIterator<DataBlockIter>(
+            read_options_, data_block_handle, &block_iter_, BlockType::kData,
+            /*get_context=*/nullptr, &lookup_context_,
+            block_prefetcher_.prefetch_buffer(),
+            /*for_compaction=*/is_for_compaction, /*async_read=*/false, s,
+            use_block_cache_for_lookup);
+      }
     }
     block_iter_points_to_real_block_ = true;
 
@@ -420,6 +457,266 @@ void BlockBasedTableIterator::InitDataBlock() {
   }
 }
 
+CachableEntry<Block>* BlockBasedTableIterator::FindPreparedBlock(
+    const BlockHandle& handle) {
+  if (multi_scan_ == nullptr) {
+    return nullptr;
+  }
+  const std::vector<BlockHandle>& handles = multi_scan_->handles;
+  auto it = std::lower_bound(handles.begin(), handles.end(), handle,
+                             [](const BlockHandle& a, const BlockHandle& b) {
+                               return a.offset() < b.offset();
+                             });
+  if (it == handles.end() || it->offset() != handle.offset()) {
+    return nullptr;
+  }
+  const size_t idx = static_cast<size_t>(it - handles.begin());
+  if (idx < multi_scan_->loaded_begin || idx >= multi_scan_->loaded_end) {
+    LoadPreparedBlocks(idx);
+  }
+  CachableEntry<Block>* block = &multi_scan_->blocks[idx];
+  return block->GetValue() != nullptr ? block : nullptr;
+}
+
+void BlockBasedTableIterator::LoadPreparedBlocks(size_t first) {
+  MultiScanState* state = multi_scan_.get();
+  for (size_t i = state->loaded_begin; i < state->loaded_end; ++i) {
+    state->blocks[i].Reset();
+  }
+  size_t end = first;
+  size_t loaded_bytes = 0;
+  do {
+    loaded_bytes += BlockBasedTable::BlockSizeWithTrailer(state->handles[end]);
+    ++end;
+  } while (end < state->handles.size() &&
+           loaded_bytes +
+                   BlockBasedTable::BlockSizeWithTrailer(state->handles[end]) <=
+               state->max_loaded_bytes);
+  state->loaded_begin = first;
+  state->loaded_end = end;
+
+  // Pin the blocks that are already cached, and read the others together
+  std::vector<BlockHandle> handles_to_read;
+  std::vector<size_t> block_idx_to_read;
+  const bool use_block_cache =
+      table_->get_rep()->table_options.block_cache != nullptr;
+  for (size_t i = first; i < end; ++i) {
+    if (use_block_cache) {
+      Status s = table_->LookupAndPinBlocksInCache<Block_kData>(
+          read_options_, state->handles[i],
+          &state->blocks[i].As<Block_kData>());
+      if (!s.ok()) {
+        // Left to the regular read path, which reports any error
+        s.PermitUncheckedError();
+        continue;
+      }
+      if (state->blocks[i].GetValue() != nullptr) {
+        continue;
+      }
+    }
+    handles_to_read.push_back(state->handles[i]);
+    block_idx_to_read.push_back(i);
+  }
+  if (handles_to_read.empty() ||
+      read_options_.read_tier == ReadTier::kBlockCacheTier) {
+    return;
+  }
+
+  std::vector<CachableEntry<Block>> results;
+  std::vector<Status> statuses;
+  table_->MultiReadDataBlocks(read_options_, handles_to_read, &results,
+                              &statuses);
+  for (size_t i = 0; i < handles_to_read.size(); ++i) {
+    if (statuses[i].ok()) {
+      state->blocks[block_idx_to_read[i]] = std::move(results[i]);
+    } else {
+      // Left to the regular read path, which reports any error
+      statuses[i].PermitUncheckedError();
+    }
+  }
+}
+
+void BlockBasedTableIterator::Prepare(
+    const std::vector<ScanOptions>* scan_opts) {
+  multi_scan_.reset();
+  if (scan_opts == nullptr || scan_opts->empty() ||
+      lookup_context_.caller == TableReaderCaller::kCompaction) {
+    return;
+  }
+
+  // Collect the handles of the data blocks that may contain keys of the scan
+  // ranges. For a range without a limit only the first block is read ahead;
+  // regular readahead takes over from there.
+  const size_t ts_sz = user_comparator_.user_comparator()->timestamp_size();
+  std::vector<BlockHandle> handles;
+  std::string seek_key;
+  for (const ScanOptions& scan_opt : *scan_opts) {
+    if (!scan_opt.range.start.has_value()) {
+      continue;
+    }
+    const Slice& start = scan_opt.range.start.value();
+    seek_key.clear();
+    if (ts_sz > 0) {
+      AppendKeyWithMaxTimestamp(&seek_key, start, ts_sz);
+    } else {
+      seek_key.assign(start.data(), start.size());
+    }
+    AppendInternalKeyFooter(&seek_key, kMaxSequenceNumber, kValueTypeForSeek);
+    for (index_iter_->Seek(seek_key); index_iter_->Valid();
+         index_iter_->Next()) {
+      IndexValue v = index_iter_->value();
+      if (!scan_opt.range.limit.has_value()) {
+        handles.push_back(v.handle);
+        break;
+      }
+      const Slice& limit = scan_opt.range.limit.value();
+      if (!v.first_internal_key.empty() &&
+          user_comparator_.CompareWithoutTimestamp(
+              ExtractUserKey(v.first_internal_key), /*a_has_ts=*/true, limit,
+              /*b_has_ts=*/false) >= 0) {
+        // The range ends before this block
+        break;
+      }
+      handles.push_back(v.handle);
+      if (user_comparator_.CompareWithoutTimestamp(
+              index_iter_->user_key(), /*a_has_ts=*/true, limit,
+              /*b_has_ts=*/false) >= 0) {
+        // All keys of the next blocks are beyond the limit
+        break;
+      }
+    }
+    if (!index_iter_->status().ok() && !index_iter_->status().IsNotFound()) {
+      // The error surfaces again when seeking
+      return;
+    }
+  }
+
+  // index_iter_ has moved, so the current block is no longer usable
+  ResetDataIter();
+  ResetBlockCacheLookupVar();
+  ResetPreviousBlockOffset();
+  is_index_at_curr_block_ = true;
+  is_at_first_key_from_index_ = false;
+  is_out_of_bound_ = false;
+
+  std::sort(handles.begin(), handles.end(),
+            [](const BlockHandle& a, const BlockHandle& b) {
+              return a.offset() < b.offset();
+            });
+  handles.erase(std::unique(handles.begin(), handles.end(),
+                            [](const BlockHandle& a, const BlockHandle& b) {
+                              return a.offset() == b.offset();
+                            }),
+                handles.end());
+  if (handles.empty()) {
+    return;
+  }
+
+  // The blocks are read ahead as the scan moves forward, within the same
+  // budget as regular readahead so that a wide scan does not pin an
+  // unbounded amount of memory
+  multi_scan_.reset(new MultiScanState());
+  multi_scan_->handles = std::move(handles);
+  multi_scan_->blocks.resize(multi_scan_->handles.size());
+  multi_scan_->max_loaded_bytes =
+      read_options_.readahead_size > 0
+          ? read_options_.readahead_size
+          : table_->get_rep()->table_options.max_auto_readahead_size;
+  LoadPreparedBlocks(0);
+}
+
+bool BlockBasedTableIterator::ReadsStoredDataBlocks() {
+  const BlockBasedTable::Rep* rep = table_->get_rep();
+  // Blocks compressed with a dictionary cannot be reused without it, and the
+  // keys of files with a global sequence number differ from the stored ones
+  return lookup_context_.caller == TableReaderCaller::kCompaction &&
+         rep->table_options.reuse_data_blocks_in_compaction &&
+         rep->compression_dict_handle.IsNull() &&
+         rep->get_global_seqno(BlockType::kData) ==
+             kDisableGlobalSequenceNumber &&
+         !DoesContainBlockHandles();
+}
+
+void BlockBasedTableIterator::ReadStoredDataBlock(const BlockHandle& handle) {
+  const BlockBasedTable::Rep* rep = table_->get_rep();
+  MemoryAllocator* allocator = GetMemoryAllocator(rep->table_options);
+  BlockContents stored;
+  Status s;
+  {
+    StopWatch sw(rep->ioptions.clock, rep->ioptions.stats,
+                 READ_BLOCK_COMPACTION_MICROS);
+    BlockFetcher block_fetcher(
+        rep->file.get(), block_prefetcher_.prefetch_buffer(), rep->footer,
+        read_options_, handle, &stored, rep->ioptions,
+        /*do_uncompress=*/false, /*maybe_compressed=*/true, BlockType::kData,
+        /*decompressor=*/nullptr, rep->persistent_cache_options, allocator,
+        allocator, /*for_compaction=*/true);
+    s = block_fetcher.ReadBlockContents();
+    stored_data_block_type_ = block_fetcher.compression_type();
+  }
+  BlockContents contents;
+  if (s.ok()) {
+    if (stored_data_block_type_ == kNoCompression) {
+      contents = std::move(stored);
+    } else if (rep->decompressor == nullptr) {
+      s = Status::Corruption("Compressed data block in a table without "
+                             "compression");
+    } else {
+      s = DecompressBlockData(stored.data.data(), stored.data.size(),
+                              stored_data_block_type_, *rep->decompressor,
+                              &contents, rep->ioptions, allocator);
+      stored_data_block_ = std::move(stored);
+    }
+  }
+  CachableEntry<Block> block;
+  if (s.ok()) {
+    std::unique_ptr<Block_kData> parsed;
+    BlockCreateContext create_context = rep->create_context;
+    create_context.Create(&parsed, std::move(contents));
+    block.As<Block_kData>().SetOwnedValue(std::move(parsed));
+    has_stored_data_block_ = true;
+  }
+  table_->NewDataBlockIterator<DataBlockIter>(read_options_, block,
+                                              &block_iter_, s);
+}
+
+bool BlockBasedTableIterator::GetReusableDataBlock(const Slice* limit,
+                                                   ReusableDataBlock* block) {
+  assert(Valid());
+  if (is_at_first_key_from_index_ || !has_stored_data_block_ ||
+      !IsIndexAtCurr() || !block_iter_.IsAtFirstEntry()) {
+    return false;
+  }
+  const BlockBasedTable::Rep* rep = table_->get_rep();
+  // Decided from the index key of the block, which is at or after its last
+  // key and before the first key of the next block of the table
+  const Slice separator_user_key = index_iter_->user_key();
+  if (limit != nullptr &&
+      user_comparator_.Compare(separator_user_key, *limit) >= 0) {
+    return false;
+  }
+  if (rep->index_key_includes_seq) {
+    const Slice separator = index_iter_->key();
+    block->separator.assign(separator.data(), separator.size());
+  } else {
+    // Index keys without sequence number are only used when no user key
+    // spans several blocks
+    block->separator.assign(separator_user_key.data(),
+                            separator_user_key.size());
+    PutFixed64(&block->separator,
+               PackSequenceAndType(0, kValueTypeForSeekForPrev));
+  }
+  const Slice contents = block_iter_.block_contents();
+  const Slice stored = stored_data_block_type_ == kNoCompression
+                           ? contents
+                           : stored_data_block_.data;
+  block->stored_contents.assign(stored.data(), stored.size());
+  block->compression_type = stored_data_block_type_;
+  block->uncompressed_size = contents.size();
+  block->format_version = rep->footer.format_version();
+  return true;
+}
+
 void BlockBasedTableIterator::AsyncInitDataBlock(bool is_first_pass) {
   BlockHandle data_block_handle;
   bool is_for_compaction =
@@ -563,6 +860,10 @@ void BlockBasedTableIterator::FindKeyForward() {
   } else {
     // This is the fast path that avoids a function call.
   }
+
+  if (scan_predicate_ != nullptr) {
+    SkipFilteredOutKeysForward();
+  }
 }
 
 void BlockBasedTableIterator::FindBlockForward() {
@@ -631,6 +932,22 @@ void BlockBasedTableIterator::FindBlockForward() {
       if (!index_iter_->Valid()) {
         return;
       }
+
+      if (CanSkipIndexBlock()) {
+        // The block is not read, so check here whether the blocks after it
+        // are out of bound, as CheckDataBlockWithinUpperBound() would.
+        if (read_options_.iterate_upper_bound != nullptr &&
+            user_comparator_.CompareWithoutTimestamp(
+                *read_options_.iterate_upper_bound, /*a_has_ts=*/false,
+                index_iter_->user_key(), /*b_has_ts=*/true) <= 0) {
+          index_iter_->Next();
+          if (index_iter_->Valid()) {
+            is_out_of_bound_ = true;
+          }
+          return;
+        }
+        continue;
+      }
       IndexValue v = index_iter_->value();
 
       if (!v.first_internal_key.empty() && allow_unprepared_value_) {
@@ -645,6 +962,14 @@ void BlockBasedTableIterator::FindBlockForward() {
 }
 
 void BlockBasedTableIterator::FindKeyBackward() {
+  FindBlockBackward();
+
+  if (scan_predicate_ != nullptr) {
+    SkipFilteredOutKeysBackward();
+  }
+}
+
+void BlockBasedTableIterator::FindBlockBackward() {
   while (!block_iter_.Valid()) {
     if (!block_iter_.status().ok()) {
       return;
@@ -654,6 +979,9 @@ void BlockBasedTableIterator::FindKeyBackward() {
     index_iter_->Prev();
 
     if (index_iter_->Valid()) {
+      if (CanSkipIndexBlock()) {
+        continue;
+      }
       InitDataBlock();
       block_iter_.SeekToLast();
     } else {
@@ -665,6 +993,125 @@ void BlockBasedTableIterator::FindKeyBackward() {
   // code simplicity.
 }
 
+const ScanPredicate* BlockBasedTableIterator::PushdownScanPredicate(
+    const BlockBasedTable* table, const ReadOptions& read_options,
+    TableReaderCaller caller) {
+  if (read_options.scan_predicate == nullptr ||
+      caller == TableReaderCaller::kCompaction) {
+    return nullptr;
+  }
+  // Dropping an entry must not change what the upper layers see for its key:
+  // merge operands need their base value, and with user-defined timestamps
+  // a key can have several versions with sequence number zero.
+  const BlockBasedTable::Rep* rep = table->get_rep();
+  if (rep->ioptions.merge_operator != nullptr ||
+      rep->internal_comparator.user_comparator()->timestamp_size() > 0) {
+    return nullptr;
+  }
+  return read_options.scan_predicate;
+}
+
+const DataBlockColumnStats* BlockBasedTableIterator::PushdownColumnStats(
+    const BlockBasedTable* table) {
+  const BlockBasedTable::Rep* rep = table->get_rep();
+  // The statistics were gathered with the sequence numbers the keys were
+  // written with, which a global sequence number overrides.
+  if (rep->global_seqno != kDisableGlobalSequenceNumber) {
+    return nullptr;
+  }
+  return rep->data_block_column_stats.get();
+}
+
+bool BlockBasedTableIterator::IsFilteredOut() const {
+  assert(scan_predicate_ != nullptr);
+  assert(block_iter_.Valid());
+
+  SequenceNumber seq = 0;
+  ValueType type = kTypeValue;
+  UnPackSequenceAndType(ExtractInternalKeyFooter(block_iter_.key()), &seq,
+                        &type);
+  if (seq != 0) {
+    return false;
+  }
+  if (type == kTypeValue) {
+    return !WideColumnsHelper::PlainValueMatches(*scan_predicate_,
+                                                 block_iter_.value());
+  }
+  if (type == kTypeWideColumnEntity) {
+    bool matches = false;
+    const Status s = WideColumnsHelper::EntityMatches(
+        *scan_predicate_, block_iter_.value(), &matches);
+    // Corrupted entities are left to the upper layers to report
+    return s.ok() && !matches;
+  }
+  return false;
+}
+
+bool BlockBasedTableIterator::CheckRangeMayMatch(const Slice& ikey,
+                                                 bool* filter_checked) {
+  if (table_->get_rep()->range_filter_handle.IsNull() ||
+      read_options_.iterate_upper_bound == nullptr) {
+    return true;
+  }
+  const Slice user_key = ExtractUserKey(ikey);
+  const Slice& upper_bound = *read_options_.iterate_upper_bound;
+  if (user_key.compare(upper_bound) >= 0) {
+    // An empty range is no use of the filter; the regular seek ends it
+    return true;
+  }
+  CachableEntry<Block_kMetaIndex> block;
+  Status s = table_->GetOrReadRangeFilterBlock(read_options_, &lookup_context_,
+                                               &block);
+  if (!s.ok()) {
+    // Like other filters, an unreadable range filter only costs performance
+    s.PermitUncheckedError();
+    return true;
+  }
+  *filter_checked = true;
+  const RangeFilter range_filter(block.GetValue());
+  if (range_filter.RangeMayMatch(user_key, upper_bound)) {
+    return true;
+  }
+  ResetDataIter();
+  // The next key is past the upper bound. Only report it if it is in this
+  // file: the largest key of the file may be the end of a range tombstone,
+  // in which case the next file can still have keys within the bound.
+  is_out_of_bound_ = range_filter.HasKeyAtOrAfter(upper_bound);
+  return false;
+}
+
+bool BlockBasedTableIterator::SkipFile() {
+  if (column_stats_ == nullptr ||
+      !column_stats_->CanSkipFile(*scan_predicate_)) {
+    return false;
+  }
+  ResetDataIter();
+  return true;
+}
+
+void BlockBasedTableIterator::SkipFilteredOutKeysForward() {
+  while (block_iter_points_to_real_block_ && block_iter_.Valid() &&
+         IsFilteredOut()) {
+    block_iter_.Next();
+    if (!block_iter_.Valid()) {
+      FindBlockForward();
+    }
+    // Do not skip past the upper bound
+    CheckOutOfBound();
+    if (is_out_of_bound_) {
+      return;
+    }
+  }
+}
+
+void BlockBasedTableIterator::SkipFilteredOutKeysBackward() {
+  while (block_iter_points_to_real_block_ && block_iter_.Valid() &&
+         IsFilteredOut()) {
+    block_iter_.Prev();
+    FindBlockBackward();
+  }
+}
+
 void BlockBasedTableIterator::CheckOutOfBound() {
   if (read_options_.iterate_upper_bound != nullptr &&
       block_upper_bound_check_ != BlockUpperBound::kUpperBoundBeyondCurBlock &&
@@ -40,7 +40,13 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
         block_prefetcher_(
             compaction_readahead_size,
             table_->get_rep()->table_options.initial_auto_readahead_size),
-        allow_unprepared_value_(allow_unprepared_value),
+        scan_predicate_(PushdownScanPredicate(table, read_options, caller)),
+        column_stats_(scan_predicate_ != nullptr
+                          ? PushdownColumnStats(table)
+                          : nullptr),
+        // Filtered entries are only known once their block is read
+        allow_unprepared_value_(allow_unprepared_value &&
+                                scan_predicate_ == nullptr),
         block_iter_points_to_real_block_(false),
         check_filter_(check_filter),
         need_upper_bound_check_(need_upper_bound_check),
@@ -189,6 +195,7 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
       }
       block_iter_.Invalidate(Status::OK());
       block_iter_points_to_real_block_ = false;
+      has_stored_data_block_ = false;
     }
     block_upper_bound_check_ = BlockUpperBound::kUnknown;
   }
@@ -226,6 +233,13 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
     return block_prefetcher_.prefetch_buffer();
   }
 
+  // Reads the data blocks of the scan ranges up front, reading adjacent
+  // blocks together, and keeps them pinned for the seeks that follow.
+  void Prepare(const std::vector<ScanOptions>* scan_opts) override;
+
+  bool GetReusableDataBlock(const Slice* limit,
+                            ReusableDataBlock* block) override;
+
   std::unique_ptr<InternalIteratorBase<IndexValue>> index_iter_;
 
  private:
@@ -294,6 +308,19 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
     std::unique_ptr<char[]> buf_;
   };
 
+  // The data blocks the scan ranges passed to Prepare() may touch, sorted by
+  // offset. Only the blocks in [loaded_begin, loaded_end), at most
+  // max_loaded_bytes of them, are read and pinned at a time. The next ones
+  // are loaded when the scan gets past them. Blocks are no longer pinned
+  // here once used.
+  struct MultiScanState {
+    std::vector<BlockHandle> handles;
+    std::vector<CachableEntry<Block>> blocks;
+    size_t loaded_begin = 0;
+    size_t loaded_end = 0;
+    size_t max_loaded_bytes = 0;
+  };
+
   bool IsIndexAtCurr() const { return is_index_at_curr_block_; }
 
   const BlockBasedTable* table_;
@@ -308,6 +335,12 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
 
   BlockPrefetcher block_prefetcher_;
 
+  // ReadOptions::scan_predicate if it can be evaluated on the entries of this
+  // table, see PushdownScanPredicate()
+  const ScanPredicate* const scan_predicate_;
+  // Set if scan_predicate_ is set and the table has usable statistics
+  const DataBlockColumnStats* const column_stats_;
+
   const bool allow_unprepared_value_;
   // True if block_iter_ is initialized and points to the same block
   // as index iterator.
@@ -353,6 +386,17 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   // is used to disable the lookup.
   IterDirection direction_ = IterDirection::kForward;
 
+  // Set by Prepare()
+  std::unique_ptr<MultiScanState> multi_scan_;
+
+  // For compactions reusing data blocks (see ReadsStoredDataBlocks()), the
+  // current data block as stored in the file if it is compressed. Otherwise
+  // the block is stored as block_iter_ iterates over it.
+  BlockContents stored_data_block_;
+  CompressionType stored_data_block_type_ = kNoCompression;
+  // Whether the current data block was read by ReadStoredDataBlock()
+  bool has_stored_data_block_ = false;
+
   // The prefix of the key called with SeekImpl().
   // This is for readahead trimming so no data blocks containing keys of a
   // different prefix are prefetched
@@ -365,12 +409,53 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
 
   void InitDataBlock();
   void AsyncInitDataBlock(bool is_first_pass);
+  // Whether data blocks are read by ReadStoredDataBlock(), for compactions
+  // reusing them (see GetReusableDataBlock())
+  bool ReadsStoredDataBlocks();
+  // Reads the data block at `handle` from the file without going through
+  // the block cache, keeping it as stored for GetReusableDataBlock()
+  void ReadStoredDataBlock(const BlockHandle& handle);
+  // Returns the block prepared for `handle` if it has not been used yet, or
+  // nullptr. Loads the prepared blocks from `handle` on if needed.
+  CachableEntry<Block>* FindPreparedBlock(const BlockHandle& handle);
+  // Releases the loaded prepared blocks not used yet, and loads the ones from
+  // multi_scan_->handles[first] on, up to multi_scan_->max_loaded_bytes
+  void LoadPreparedBlocks(size_t first);
   bool MaterializeCurrentBlock();
   void FindKeyForward();
   void FindBlockForward();
   void FindKeyBackward();
+  void FindBlockBackward();
   void CheckOutOfBound();
 
+  // *** BEGIN APIs relevant to ReadOptions::scan_predicate ***
+
+  static const ScanPredicate* PushdownScanPredicate(
+      const BlockBasedTable* table, const ReadOptions& read_options,
+      TableReaderCaller caller);
+  static const DataBlockColumnStats* PushdownColumnStats(
+      const BlockBasedTable* table);
+
+  // Whether the current entry of block_iter_ does not satisfy scan_predicate_
+  // and is the only version of its key, so it can be skipped.
+  bool IsFilteredOut() const;
+
+  // Whether the data block the index iterator points to can be skipped
+  // without reading it.
+  bool CanSkipIndexBlock() const {
+    return column_stats_ != nullptr &&
+           column_stats_->CanSkipBlock(*scan_predicate_,
+                                       index_iter_->value().handle.offset());
+  }
+
+  // Whether the whole file can be skipped; invalidates the iterator if so.
+  bool SkipFile();
+
+  void SkipFilteredOutKeysForward();
+  void SkipFilteredOutKeysBackward();
+
+  // *** END APIs relevant to ReadOptions::scan_predicate ***
+
   // Check if data block is fully within iterate_upper_bound.
   //
   // Note MyRocks may update iterate bounds between seek. To workaround it,
@@ -399,6 +484,10 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
     return true;
   }
 
+  // Returns false if the range filter of the table rules out keys in
+  // [ikey, iterate_upper_bound), leaving the iterator invalid.
+  bool CheckRangeMayMatch(const Slice& ikey, bool* filter_checked);
+
   // *** BEGIN APIs relevant to auto tuning of readahead_size ***
 
   // This API is called to lookup the data blocks ahead in the cache to tune
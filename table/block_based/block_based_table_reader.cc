@@ -29,6 +29,7 @@
 #include "file/file_util.h"
 #include "file/random_access_file_reader.h"
 #include "logging/logging.h"
+#include "monitoring/block_cache_heatmap.h"
 #include "monitoring/perf_context_imp.h"
 #include "parsed_full_filter_block.h"
 #include "port/lang.h"
@@ -56,6 +57,7 @@
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/full_filter_block.h"
 #include "table/block_based/hash_index_reader.h"
+#include "table/block_based/learned_index_reader.h"
 #include "table/block_based/partitioned_filter_block.h"
 #include "table/block_based/partitioned_index_reader.h"
 #include "table/block_fetcher.h"
@@ -134,6 +136,9 @@ namespace ROCKSDB_NAMESPACE {
 extern const uint64_t kBlockBasedTableMagicNumber;
 extern const std::string kHashIndexPrefixesBlock;
 extern const std::string kHashIndexPrefixesMetadataBlock;
+extern const std::string kLearnedIndexModelBlock;
+extern const std::string kDataBlockColumnStatsBlock;
+extern const std::string kRangeFilterBlock;
 
 BlockBasedTable::~BlockBasedTable() {
   auto ua = rep_->uncache_aggressiveness.LoadRelaxed();
@@ -265,6 +270,10 @@ void BlockBasedTable::UpdateCacheHitMetrics(BlockType block_type,
   PERF_COUNTER_ADD(block_cache_read_byte, usage);
   PERF_COUNTER_BY_LEVEL_ADD(block_cache_hit_count, 1,
                             static_cast<uint32_t>(rep_->level));
+  if (rep_->block_cache_heatmap) {
+    rep_->block_cache_heatmap->Record(rep_->level, rep_->file_number,
+                                      block_type, /*hit=*/true);
+  }
 
   if (get_context) {
     ++get_context->get_context_stats_.num_cache_hit;
@@ -327,6 +336,10 @@ void BlockBasedTable::UpdateCacheMissMetrics(BlockType block_type,
   // TODO: introduce aggregate (not per-level) block cache miss count
   PERF_COUNTER_BY_LEVEL_ADD(block_cache_miss_count, 1,
                             static_cast<uint32_t>(rep_->level));
+  if (rep_->block_cache_heatmap) {
+    rep_->block_cache_heatmap->Record(rep_->level, rep_->file_number,
+                                      block_type, /*hit=*/false);
+  }
 
   if (get_context) {
     ++get_context->get_context_stats_.num_cache_miss;
@@ -636,7 +649,8 @@ Status BlockBasedTable::Open(
     BlockCacheTracer* const block_cache_tracer,
     size_t max_file_size_for_l0_meta_pin, const std::string& cur_db_session_id,
     uint64_t cur_file_num, UniqueId64x2 expected_unique_id,
-    const bool user_defined_timestamps_persisted) {
+    const bool user_defined_timestamps_persisted,
+    BlockCacheHeatmap* block_cache_heatmap) {
   table_reader->reset();
 
   Status s;
@@ -708,6 +722,8 @@ Status BlockBasedTable::Open(
       file_size, level, immortal_table, user_defined_timestamps_persisted);
   rep->file = std::move(file);
   rep->footer = footer;
+  rep->block_cache_heatmap = block_cache_heatmap;
+  rep->file_number = cur_file_num;
 
   // Some ancient versions (~2.5 - 2.7, format_version=1) could compress the
   // metaindex block, so we need to allow for that
@@ -855,6 +871,12 @@ Status BlockBasedTable::Open(
   if (!s.ok()) {
     return s;
   }
+  new_table->ReadDataBlockColumnStats(ro, prefetch_buffer.get(),
+                                      metaindex_iter.get());
+  if (!skip_filters) {
+    new_table->ReadRangeFilter(ro, prefetch_buffer.get(),
+                               metaindex_iter.get());
+  }
   rep->verify_checksum_set_on_open = ro.verify_checksums;
   s = new_table->PrefetchIndexAndFilterBlocks(
       ro, prefetch_buffer.get(), metaindex_iter.get(), new_table.get(),
@@ -1112,6 +1134,82 @@ Status BlockBasedTable::ReadRangeDelBlock(
   return s;
 }
 
+void BlockBasedTable::ReadDataBlockColumnStats(
+    const ReadOptions& ro, FilePrefetchBuffer* prefetch_buffer,
+    InternalIterator* meta_iter) {
+  // The statistics only allow skipping data blocks, so from this point on a
+  // missing or unreadable block falls back to reading every data block.
+  BlockHandle handle;
+  Status s = FindOptionalMetaBlock(meta_iter, kDataBlockColumnStatsBlock,
+                                   &handle);
+  if (s.ok() && !handle.IsNull()) {
+    BlockContents contents;
+    BlockFetcher block_fetcher(
+        rep_->file.get(), prefetch_buffer, rep_->footer, ro, handle,
+        &contents, rep_->ioptions, false /* decompress */,
+        false /*maybe_compressed*/, BlockType::kProperties,
+        nullptr /* decompressor */, rep_->persistent_cache_options,
+        GetMemoryAllocator(rep_->table_options));
+    s = block_fetcher.ReadBlockContents();
+    if (s.ok()) {
+      s = DataBlockColumnStats::Create(contents.data,
+                                       &rep_->data_block_column_stats);
+    }
+  }
+  if (!s.ok()) {
+    ROCKS_LOG_WARN(rep_->ioptions.logger,
+                   "Failed to load data block column statistics: %s",
+                   s.ToString().c_str());
+  }
+}
+
+void BlockBasedTable::ReadRangeFilter(const ReadOptions& ro,
+                                      FilePrefetchBuffer* prefetch_buffer,
+                                      InternalIterator* meta_iter) {
+  // Like other filters, a missing or unreadable range filter only costs
+  // performance.
+  BlockHandle handle;
+  Status s = FindOptionalMetaBlock(meta_iter, kRangeFilterBlock, &handle);
+  if (s.ok() && !handle.IsNull()) {
+    // Read now even if cached, to warm the cache like the other filters
+    const bool use_cache = rep_->table_options.cache_index_and_filter_blocks;
+    CachableEntry<Block_kMetaIndex> block;
+    s = RetrieveBlock(prefetch_buffer, ro, handle, /*decomp=*/nullptr, &block,
+                      /*get_context=*/nullptr, /*lookup_context=*/nullptr,
+                      /*for_compaction=*/false, use_cache,
+                      /*async_read=*/false,
+                      /*use_block_cache_for_lookup=*/true);
+    if (s.ok()) {
+      rep_->range_filter_handle = handle;
+      if (!use_cache) {
+        rep_->range_filter_block = std::move(block);
+      }
+    }
+  }
+  if (!s.ok()) {
+    ROCKS_LOG_WARN(rep_->ioptions.logger, "Failed to load range filter: %s",
+                   s.ToString().c_str());
+  }
+}
+
+Status BlockBasedTable::GetOrReadRangeFilterBlock(
+    const ReadOptions& ro, BlockCacheLookupContext* lookup_context,
+    CachableEntry<Block_kMetaIndex>* block) const {
+  assert(block);
+  assert(!rep_->range_filter_handle.IsNull());
+
+  if (!rep_->range_filter_block.IsEmpty()) {
+    block->SetUnownedValue(rep_->range_filter_block.GetValue());
+    return Status::OK();
+  }
+  return RetrieveBlock(/*prefetch_buffer=*/nullptr, ro,
+                       rep_->range_filter_handle, /*decomp=*/nullptr, block,
+                       /*get_context=*/nullptr, lookup_context,
+                       /*for_compaction=*/false, /*use_cache=*/true,
+                       /*async_read=*/false,
+                       /*use_block_cache_for_lookup=*/true);
+}
+
 Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
     const ReadOptions& ro, FilePrefetchBuffer* prefetch_buffer,
     InternalIterator* meta_iter, BlockBasedTable* new_table, bool prefetch_all,
@@ -1304,6 +1402,12 @@ size_t BlockBasedTable::ApproximateMemoryUsage() const {
   if (rep_->table_properties) {
     usage += rep_->table_properties->ApproximateMemoryUsage();
   }
+  if (rep_->data_block_column_stats) {
+    usage += rep_->data_block_column_stats->ApproximateMemoryUsage();
+  }
+  if (rep_->range_filter_block.GetOwnValue()) {
+    usage += rep_->range_filter_block.GetValue()->ApproximateMemoryUsage();
+  }
   return usage;
 }
 
@@ -1600,6 +1704,177 @@ Status BlockBasedTable::LookupAndPinBlocksInCache(
   return s;
 }
 
+void BlockBasedTable::MultiReadDataBlocks(
+    const ReadOptions& ro, const std::vector<BlockHandle>& handles,
+    std::vector<CachableEntry<Block>>* results,
+    std::vector<Status>* statuses) const {
+  assert(results != nullptr && statuses != nullptr);
+  results->clear();
+  results->resize(handles.size());
+  statuses->assign(handles.size(), Status::OK());
+  if (handles.empty()) {
+    return;
+  }
+
+  RandomAccessFileReader* file = rep_->file.get();
+  const ImmutableOptions& ioptions = rep_->ioptions;
+  MemoryAllocator* memory_allocator = GetMemoryAllocator(rep_->table_options);
+
+  CachableEntry<DecompressorDict> dict;
+  Decompressor* decomp = rep_->decompressor.get();
+  if (rep_->uncompression_dict_reader) {
+    Status s =
+        rep_->uncompression_dict_reader->GetOrReadUncompressionDictionary(
+            /* prefetch_buffer= */ nullptr, ro, /* get_context= */ nullptr,
+            /* lookup_context= */ nullptr, &dict);
+    if (!s.ok()) {
+      statuses->assign(handles.size(), s);
+      return;
+    }
+    assert(dict.GetValue());
+    if (dict.GetValue()) {
+      decomp = dict.GetValue()->decompressor_.get();
+    }
+  }
+
+  if (ioptions.allow_mmap_reads) {
+    for (size_t i = 0; i < handles.size(); ++i) {
+      (*statuses)[i] = RetrieveBlock(
+          /* prefetch_buffer= */ nullptr, ro, handles[i], decomp,
+          &(*results)[i].As<Block_kData>(), /* get_context= */ nullptr,
+          /* lookup_context= */ nullptr, /* for_compaction= */ false,
+          /* use_cache= */ true, /* async_read= */ false,
+          /* use_block_cache_for_lookup= */ true);
+    }
+    return;
+  }
+
+  // Combine the reads of adjacent blocks. In direct IO mode the requests are
+  // realigned and merged by the file reader instead.
+  std::vector<FSReadRequest> read_reqs;
+  std::vector<size_t> req_idx_for_block(handles.size());
+  std::vector<size_t> req_offset_for_block(handles.size());
+  for (size_t i = 0; i < handles.size(); ++i) {
+    const BlockHandle& handle = handles[i];
+    const size_t block_size_with_trailer = BlockSizeWithTrailer(handle);
+    if (!read_reqs.empty() && !file->use_direct_io() &&
+        read_reqs.back().offset + read_reqs.back().len == handle.offset()) {
+      req_offset_for_block[i] = read_reqs.back().len;
+      read_reqs.back().len += block_size_with_trailer;
+    } else {
+      FSReadRequest req;
+      req.offset = handle.offset();
+      req.len = block_size_with_trailer;
+      read_reqs.emplace_back(std::move(req));
+      req_offset_for_block[i] = 0;
+    }
+    req_idx_for_block[i] = read_reqs.size() - 1;
+
+    PERF_COUNTER_ADD(block_read_count, 1);
+    PERF_COUNTER_ADD(block_read_byte, block_size_with_trailer);
+  }
+
+  std::vector<std::unique_ptr<char[]>> scratches;
+  if (!file->use_direct_io()) {
+    scratches.reserve(read_reqs.size());
+    for (FSReadRequest& req : read_reqs) {
+      scratches.emplace_back(new char[req.len]);
+      req.scratch = scratches.back().get();
+    }
+  }
+
+  AlignedBuf direct_io_buf;
+  {
+    IOOptions opts;
+    IODebugContext dbg;
+    IOStatus s = file->PrepareIOOptions(ro, opts, &dbg);
+    if (s.ok()) {
+      s = file->MultiRead(opts, read_reqs.data(), read_reqs.size(),
+                          &direct_io_buf, &dbg);
+    }
+    if (!s.ok()) {
+      for (FSReadRequest& req : read_reqs) {
+        req.status = s;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < handles.size(); ++i) {
+    const BlockHandle& handle = handles[i];
+    const FSReadRequest& req = read_reqs[req_idx_for_block[i]];
+    const size_t req_offset = req_offset_for_block[i];
+    Status s = req.status;
+    if (s.ok() &&
+        req_offset + BlockSizeWithTrailer(handle) > req.result.size()) {
+      s = Status::Corruption("truncated block read from " +
+                             file->file_name() + " offset " +
+                             std::to_string(handle.offset()) + ", expected " +
+                             std::to_string(req.len) + " bytes, got " +
+                             std::to_string(req.result.size()));
+    }
+    const char* data = req.result.data() + req_offset;
+    if (s.ok() && ro.verify_checksums) {
+      PERF_TIMER_GUARD(block_checksum_time);
+      s = VerifyBlockChecksum(rep_->footer, data, handle.size(),
+                              file->file_name(), handle.offset());
+      RecordTick(ioptions.stats, BLOCK_CHECKSUM_COMPUTE_COUNT);
+      if (!s.ok()) {
+        RecordTick(ioptions.stats, BLOCK_CHECKSUM_MISMATCH_COUNT);
+      }
+    }
+    if (!s.ok()) {
+      (*statuses)[i] = s;
+      continue;
+    }
+
+    // The read buffers are shared by the blocks of a request, so a block that
+    // is kept as is has to be copied out.
+    CompressionType compression_type =
+        GetBlockCompressionType(data, handle.size());
+    BlockContents serialized_block;
+    if (compression_type == kNoCompression) {
+      Slice serialized(data, BlockSizeWithTrailer(handle));
+      serialized_block = BlockContents(
+          CopyBufferToHeap(memory_allocator, serialized), handle.size());
+    } else {
+      serialized_block = BlockContents(Slice(data, handle.size()));
+    }
+#ifndef NDEBUG
+    serialized_block.has_trailer = true;
+#endif
+
+    CachableEntry<Block_kData>* block_entry = &(*results)[i].As<Block_kData>();
+    if (ro.fill_cache) {
+      // Since we're passing the serialized block contents, this avoids
+      // looking up the block cache again
+      s = MaybeReadBlockAndLoadToCache(
+          /* prefetch_buffer= */ nullptr, ro, handle, decomp,
+          /* for_compaction= */ false, block_entry, /* get_context= */ nullptr,
+          /* lookup_context= */ nullptr, &serialized_block,
+          /* async_read= */ false, /* use_block_cache_for_lookup= */ true);
+      if (!s.ok() || block_entry->GetValue() != nullptr) {
+        (*statuses)[i] = s;
+        continue;
+      }
+    }
+
+    BlockContents contents;
+    if (compression_type != kNoCompression) {
+      s = DecompressSerializedBlock(data, handle.size(), compression_type,
+                                    *decomp, &contents, ioptions,
+                                    memory_allocator);
+    } else {
+      contents = std::move(serialized_block);
+    }
+    if (s.ok()) {
+      block_entry->SetOwnedValue(std::make_unique<Block_kData>(
+          std::move(contents), rep_->table_options.read_amp_bytes_per_bit,
+          ioptions.stats));
+    }
+    (*statuses)[i] = s;
+  }
+}
+
 // If contents is nullptr, this function looks up the block caches for the
 // data block referenced by handle, and read the block from disk if necessary.
 // If contents is non-null, it skips the cache lookup and disk read, since
@@ -2251,6 +2526,68 @@ Status BlockBasedTable::ApproximateKeyAnchors(const ReadOptions& read_options,
   return Status::OK();
 }
 
+Status BlockBasedTable::GetCachedKeyRanges(
+    const ReadOptions& read_options,
+    std::vector<std::pair<std::string, std::string>>& ranges) {
+  Cache* const cache = rep_->table_options.block_cache.get();
+  if (cache == nullptr) {
+    return Status::OK();
+  }
+
+  IndexBlockIter iiter_on_stack;
+  auto iiter = NewIndexIterator(
+      read_options, /*disable_prefix_seek=*/false, &iiter_on_stack,
+      /*get_context=*/nullptr, /*lookup_context=*/nullptr);
+  std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
+  if (iiter != &iiter_on_stack) {
+    iiter_unique_ptr.reset(iiter);
+  }
+
+  // Index keys are only separators, which can cover keys of the neighboring
+  // blocks. The cached blocks themselves tell their exact first and last keys.
+  const Comparator* const ucmp = rep_->internal_comparator.user_comparator();
+  bool in_range = false;
+  for (iiter->SeekToFirst(); iiter->Valid(); iiter->Next()) {
+    const CacheKey key =
+        GetCacheKey(rep_->base_cache_key, iiter->value().handle);
+    Cache::Handle* const cache_handle = cache->Lookup(key.AsSlice());
+    if (cache_handle == nullptr) {
+      in_range = false;
+      continue;
+    }
+    if (cache->GetCacheItemHelper(cache_handle)->role !=
+        CacheEntryRole::kDataBlock) {
+      cache->Release(cache_handle);
+      in_range = false;
+      continue;
+    }
+    auto* const block = static_cast<Block_kData*>(cache->Value(cache_handle));
+    DataBlockIter biter;
+    block->NewDataIterator(ucmp, kDisableGlobalSequenceNumber, &biter,
+                           /*stats=*/nullptr, /*block_contents_pinned=*/false,
+                           rep_->user_defined_timestamps_persisted);
+    biter.SeekToFirst();
+    std::string first_key;
+    if (biter.Valid()) {
+      first_key = biter.user_key().ToString();
+      biter.SeekToLast();
+    }
+    if (biter.Valid()) {
+      if (!in_range) {
+        ranges.emplace_back(std::move(first_key), std::string());
+        in_range = true;
+      }
+      const Slice last_key = biter.user_key();
+      ranges.back().second.assign(last_key.data(), last_key.size());
+    } else {
+      // A corrupted cached block just contributes no range
+      in_range = false;
+    }
+    cache->Release(cache_handle);
+  }
+  return iiter->status();
+}
+
 bool BlockBasedTable::TimestampMayMatch(const ReadOptions& read_options) const {
   if (read_options.timestamp != nullptr && !rep_->min_timestamp.empty()) {
     RecordTick(rep_->ioptions.stats, TIMESTAMP_FILTER_TABLE_CHECKED);
@@ -2643,6 +2980,17 @@ BlockType BlockBasedTable::GetBlockTypeForMetaBlockByName(
     return BlockType::kIndex;
   }
 
+  if (meta_block_name == kLearnedIndexModelBlock) {
+    // Written alongside the index block it models
+    return BlockType::kIndex;
+  }
+
+  if (meta_block_name == kDataBlockColumnStatsBlock ||
+      meta_block_name == kRangeFilterBlock) {
+    // Uncompressed, like the properties block
+    return BlockType::kProperties;
+  }
+
   if (meta_block_name.starts_with(kObsoleteFilterBlockPrefix)) {
     // Obsolete but possible in old files
     return BlockType::kInvalid;
@@ -2806,6 +3154,11 @@ Status BlockBasedTable::CreateIndexReader(
                                        index_reader);
       }
     }
+    case BlockBasedTableOptions::kLearnedSearch: {
+      return LearnedIndexReader::Create(this, ro, prefetch_buffer, meta_iter,
+                                        use_cache, prefetch, pin,
+                                        lookup_context, index_reader);
+    }
     default: {
       std::string error_message =
           "Unrecognized index type: " + std::to_string(rep_->index_type);
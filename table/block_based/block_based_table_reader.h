@@ -25,6 +25,8 @@
 #include "table/block_based/block_cache.h"
 #include "table/block_based/block_type.h"
 #include "table/block_based/cachable_entry.h"
+#include "table/block_based/data_block_column_stats.h"
+#include "table/block_based/range_filter_block.h"
 #include "table/block_based/filter_block.h"
 #include "table/block_based/uncompression_dict_reader.h"
 #include "table/format.h"
@@ -40,6 +42,7 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+class BlockCacheHeatmap;
 class Cache;
 class FilterBlockReader;
 class FullFilterBlockReader;
@@ -115,7 +118,8 @@ class BlockBasedTable : public TableReader {
       size_t max_file_size_for_l0_meta_pin = 0,
       const std::string& cur_db_session_id = "", uint64_t cur_file_num = 0,
       UniqueId64x2 expected_unique_id = {},
-      const bool user_defined_timestamps_persisted = true);
+      const bool user_defined_timestamps_persisted = true,
+      BlockCacheHeatmap* block_cache_heatmap = nullptr);
 
   bool PrefixRangeMayMatch(const Slice& internal_key,
                            const ReadOptions& read_options,
@@ -185,6 +189,10 @@ class BlockBasedTable : public TableReader {
   Status ApproximateKeyAnchors(const ReadOptions& read_options,
                                std::vector<Anchor>& anchors) override;
 
+  Status GetCachedKeyRanges(
+      const ReadOptions& read_options,
+      std::vector<std::pair<std::string, std::string>>& ranges) override;
+
   bool EraseFromCache(const BlockHandle& handle) const;
 
   bool TEST_BlockInCache(const BlockHandle& handle) const;
@@ -299,6 +307,22 @@ class BlockBasedTable : public TableReader {
       const ReadOptions& ro, const BlockHandle& handle,
       CachableEntry<TBlocklike>* out_parsed_block) const;
 
+  // Reads the data blocks of `handles`, which must be sorted by offset, with
+  // one MultiRead(), reading adjacent blocks with a single request. Unlike
+  // RetrieveMultipleBlocks(), this does not look up the block cache first.
+  // The blocks are inserted into the block cache if ro.fill_cache, and are
+  // returned in `results` in any case.
+  void MultiReadDataBlocks(const ReadOptions& ro,
+                           const std::vector<BlockHandle>& handles,
+                           std::vector<CachableEntry<Block>>* results,
+                           std::vector<Status>* statuses) const;
+
+  // Sets `block` to the range filter block (see Rep::range_filter_handle),
+  // reading it through the block cache if it is not held by the table.
+  Status GetOrReadRangeFilterBlock(
+      const ReadOptions& ro, BlockCacheLookupContext* lookup_context,
+      CachableEntry<Block_kMetaIndex>* block) const;
+
   struct Rep;
 
   Rep* get_rep() { return rep_; }
@@ -501,6 +525,12 @@ class BlockBasedTable : public TableReader {
                            InternalIterator* meta_iter,
                            const InternalKeyComparator& internal_comparator,
                            BlockCacheLookupContext* lookup_context);
+  void ReadDataBlockColumnStats(const ReadOptions& ro,
+                                FilePrefetchBuffer* prefetch_buffer,
+                                InternalIterator* meta_iter);
+  void ReadRangeFilter(const ReadOptions& ro,
+                       FilePrefetchBuffer* prefetch_buffer,
+                       InternalIterator* meta_iter);
   // If index and filter blocks do not need to be pinned, `prefetch_all`
   // determines whether they will be read and add to cache.
   Status PrefetchIndexAndFilterBlocks(
@@ -627,6 +657,17 @@ struct BlockBasedTable::Rep {
 
   std::shared_ptr<FragmentedRangeTombstoneList> fragmented_range_dels;
 
+  // See BlockBasedTableOptions::data_block_column_stats. Only set if the
+  // file has the statistics.
+  std::unique_ptr<DataBlockColumnStats> data_block_column_stats;
+
+  // See BlockBasedTableOptions::range_filter. The handle is only set if the
+  // file has a range filter and filters are not skipped. Like other filter
+  // blocks, the block is held here without cache_index_and_filter_blocks,
+  // and read through the block cache on use otherwise.
+  BlockHandle range_filter_handle;
+  CachableEntry<Block_kMetaIndex> range_filter_block;
+
   // Context for block cache CreateCallback
   BlockCreateContext create_context;
 
@@ -644,6 +685,12 @@ struct BlockBasedTable::Rep {
   // move is involved
   int level;
 
+  // 0 if unknown
+  uint64_t file_number = 0;
+
+  // See TableReaderOptions::block_cache_heatmap
+  BlockCacheHeatmap* block_cache_heatmap = nullptr;
+
   // the timestamp range of table
   // Points into memory owned by TableProperties. This would need to change if
   // TableProperties become subject to cache eviction.
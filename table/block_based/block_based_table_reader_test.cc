@@ -525,6 +525,112 @@ TEST_P(BlockBasedTableReaderTest, NewIterator) {
   ASSERT_OK(iter->status());
 }
 
+TEST_P(BlockBasedTableReaderTest, PrepareMultiScan) {
+  Options options;
+  ReadOptions read_opts;
+  std::string dummy_ts(sizeof(uint64_t), '\0');
+  Slice read_timestamp = dummy_ts;
+  if (udt_enabled_) {
+    options.comparator = test::BytewiseComparatorWithU64TsWrapper();
+    read_opts.timestamp = &read_timestamp;
+  }
+  options.persist_user_defined_timestamps = persist_udt_;
+  size_t ts_sz = options.comparator->timestamp_size();
+  std::vector<std::pair<std::string, std::string>> kv =
+      BlockBasedTableReaderBaseTest::GenerateKVMap(
+          100 /* num_block */,
+          true /* mixed_with_human_readable_string_value */, ts_sz);
+
+  std::string table_name = "BlockBasedTableReaderTest_PrepareMultiScan" +
+                           CompressionTypeToString(compression_type_);
+
+  ImmutableOptions ioptions(options);
+  CreateTable(table_name, ioptions, compression_type_, kv,
+              compression_parallel_threads_, compression_dict_bytes_);
+
+  std::unique_ptr<BlockBasedTable> table;
+  FileOptions foptions;
+  foptions.use_direct_reads = use_direct_reads_;
+  InternalKeyComparator comparator(options.comparator);
+  NewBlockBasedTableReader(foptions, ioptions, comparator, table_name, &table,
+                           true /* bool prefetch_index_and_filter_in_cache */,
+                           nullptr /* status */, persist_udt_);
+
+  std::unique_ptr<InternalIterator> iter;
+  iter.reset(table->NewIterator(
+      read_opts, options_.prefix_extractor.get(), /*arena=*/nullptr,
+      /*skip_filters=*/false, TableReaderCaller::kUncategorized));
+
+  // Each block has 16 keys
+  std::vector<std::pair<std::string, std::string>> ranges = {
+      {"00000020", "00000050"}, {"00000600", "00000700"},
+      {"00000700", "00000701"}, {"00001000", "00001010"}};
+  std::vector<ScanOptions> scan_opts;
+  for (const auto& range : ranges) {
+    scan_opts.emplace_back(range.first, range.second);
+  }
+  PerfContext* perf_ctx = get_perf_context();
+  perf_ctx->Reset();
+  iter->Prepare(&scan_opts);
+  ASSERT_OK(iter->status());
+  auto data_block_read_count = [&]() {
+    return perf_ctx->block_read_count - perf_ctx->index_block_read_count -
+           perf_ctx->filter_block_read_count -
+           perf_ctx->compression_dict_block_read_count;
+  };
+  // 3 + 7 + 2 blocks, the third range being in the last block of the second
+  ASSERT_EQ(data_block_read_count(), 12);
+
+  auto verify_scans = [&]() {
+    for (const auto& range : ranges) {
+      std::string seek_key;
+      if (ts_sz > 0) {
+        AppendKeyWithMaxTimestamp(&seek_key, range.first, ts_sz);
+      } else {
+        seek_key = range.first;
+      }
+      AppendInternalKeyFooter(&seek_key, kMaxSequenceNumber, kValueTypeForSeek);
+      auto kv_iter = kv.begin();
+      while (kv_iter != kv.end() &&
+             ExtractUserKeyAndStripTimestamp(kv_iter->first, ts_sz)
+                     .compare(range.first) < 0) {
+        ++kv_iter;
+      }
+      for (iter->Seek(seek_key);
+           iter->Valid() &&
+           ExtractUserKeyAndStripTimestamp(iter->key(), ts_sz)
+                   .compare(range.second) < 0;
+           iter->Next(), ++kv_iter) {
+        ASSERT_TRUE(kv_iter != kv.end());
+        ASSERT_EQ(iter->key().ToString(), kv_iter->first);
+        ASSERT_EQ(iter->value().ToString(), kv_iter->second);
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_TRUE(kv_iter == kv.end() ||
+                  ExtractUserKeyAndStripTimestamp(kv_iter->first, ts_sz)
+                          .compare(range.second) >= 0);
+    }
+  };
+  perf_ctx->Reset();
+  verify_scans();
+  // All data blocks were read by Prepare()
+  ASSERT_EQ(data_block_read_count(), 0);
+
+  // With a readahead budget smaller than a block, blocks are prepared one at
+  // a time as the scans reach them
+  read_opts.readahead_size = 1;
+  iter.reset(table->NewIterator(
+      read_opts, options_.prefix_extractor.get(), /*arena=*/nullptr,
+      /*skip_filters=*/false, TableReaderCaller::kUncategorized));
+  perf_ctx->Reset();
+  iter->Prepare(&scan_opts);
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(data_block_read_count(), 1);
+  perf_ctx->Reset();
+  verify_scans();
+  ASSERT_EQ(data_block_read_count(), 11);
+}
+
 class ChargeTableReaderTest
     : public BlockBasedTableReaderBaseTest,
       public testing::WithParamInterface<
@@ -1008,7 +1114,8 @@ INSTANTIATE_TEST_CASE_P(
             BlockBasedTableOptions::IndexType::kBinarySearch,
             BlockBasedTableOptions::IndexType::kHashSearch,
             BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch,
-            BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey),
+            BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey,
+            BlockBasedTableOptions::IndexType::kLearnedSearch),
         ::testing::Values(false), ::testing::ValuesIn(test::GetUDTTestModes()),
         ::testing::Values(1, 2), ::testing::Values(0, 4096),
         ::testing::Values(false)));
@@ -1020,7 +1127,8 @@ INSTANTIATE_TEST_CASE_P(
             BlockBasedTableOptions::IndexType::kBinarySearch,
             BlockBasedTableOptions::IndexType::kHashSearch,
             BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch,
-            BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey),
+            BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey,
+            BlockBasedTableOptions::IndexType::kLearnedSearch),
         ::testing::Values(false), ::testing::ValuesIn(test::GetUDTTestModes()),
         ::testing::Values(1, 2), ::testing::Values(0, 4096),
         ::testing::Values(false, true)));
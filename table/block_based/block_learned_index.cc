@@ -0,0 +1,169 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/block_learned_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "table/block_based/restart_key_prefixes.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// start_key, first_pos, last_pos, slope
+constexpr size_t kEncodedSegmentSize = 8 + 4 + 4 + 8;
+
+uint64_t EncodeDouble(double d) {
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(d));
+  std::memcpy(&bits, &d, sizeof(bits));
+  return bits;
+}
+
+double DecodeDouble(uint64_t bits) {
+  double d;
+  std::memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+}  // namespace
+
+uint64_t BlockLearnedIndex::KeyToPosition(const Slice& user_key) {
+  return KeyPrefixAsUint64(user_key);
+}
+
+Status BlockLearnedIndex::Create(
+    const Slice& contents, std::unique_ptr<BlockLearnedIndex>* learned_index) {
+  Slice input = contents;
+  uint32_t max_error = 0;
+  uint32_t num_segments = 0;
+  if (!GetVarint32(&input, &max_error) ||
+      !GetVarint32(&input, &num_segments) ||
+      input.size() != num_segments * kEncodedSegmentSize ||
+      num_segments == 0) {
+    return Status::Corruption("Bad learned index model block");
+  }
+  std::vector<Segment> segments(num_segments);
+  const char* p = input.data();
+  for (auto& seg : segments) {
+    seg.start_key = DecodeFixed64(p);
+    seg.first_pos = DecodeFixed32(p + 8);
+    seg.last_pos = DecodeFixed32(p + 12);
+    seg.slope = DecodeDouble(DecodeFixed64(p + 16));
+    p += kEncodedSegmentSize;
+    if (seg.first_pos > seg.last_pos || !(seg.slope >= 0)) {
+      return Status::Corruption("Bad learned index model segment");
+    }
+  }
+  learned_index->reset(new BlockLearnedIndex(max_error, std::move(segments)));
+  return Status::OK();
+}
+
+void BlockLearnedIndex::Predict(const Slice& user_key, uint32_t* first,
+                                uint32_t* last) const {
+  assert(!segments_.empty());
+  const uint64_t x = KeyToPosition(user_key);
+  auto it = std::upper_bound(
+      segments_.begin(), segments_.end(), x,
+      [](uint64_t k, const Segment& seg) { return k < seg.start_key; });
+  uint32_t pos = 0;
+  if (it != segments_.begin()) {
+    const Segment& seg = *(it - 1);
+    // Positions past the last point of a segment belong to that point, so
+    // clamping to the segment's range never moves the prediction away from
+    // the answer.
+    const double predicted =
+        seg.first_pos + seg.slope * static_cast<double>(x - seg.start_key);
+    if (predicted >= seg.last_pos) {
+      pos = seg.last_pos;
+    } else {
+      pos = std::max(seg.first_pos, static_cast<uint32_t>(predicted));
+    }
+  }
+  // A key falling between two fitted points may be predicted anywhere
+  // between their two predictions, hence the extra slot on each side.
+  const uint32_t window = max_error_ + 1;
+  *first = pos > window ? pos - window : 0;
+  *last = pos < std::numeric_limits<uint32_t>::max() - window
+              ? pos + window
+              : std::numeric_limits<uint32_t>::max();
+}
+
+void BlockLearnedIndexBuilder::Add(const Slice& user_key, uint32_t pos) {
+  if (!monotonic_) {
+    return;
+  }
+  const uint64_t x = BlockLearnedIndex::KeyToPosition(user_key);
+  if (has_segment_ && x < last_key_) {
+    monotonic_ = false;
+    return;
+  }
+  last_key_ = x;
+  assert(!has_segment_ || pos >= last_pos_);
+
+  if (has_segment_) {
+    if (x == start_key_) {
+      if (pos - first_pos_ <= max_error_) {
+        last_pos_ = pos;
+        return;
+      }
+    } else {
+      const double dx = static_cast<double>(x - start_key_);
+      const double dy = static_cast<double>(pos - first_pos_);
+      const double lo = std::max(min_slope_, (dy - max_error_) / dx);
+      const double hi = std::min(max_slope_, (dy + max_error_) / dx);
+      if (lo <= hi) {
+        min_slope_ = lo;
+        max_slope_ = hi;
+        last_pos_ = pos;
+        return;
+      }
+    }
+    FlushSegment();
+  }
+
+  has_segment_ = true;
+  start_key_ = x;
+  first_pos_ = pos;
+  last_pos_ = pos;
+  min_slope_ = 0;
+  max_slope_ = std::numeric_limits<double>::infinity();
+}
+
+void BlockLearnedIndexBuilder::FlushSegment() {
+  assert(has_segment_);
+  BlockLearnedIndex::Segment seg;
+  seg.start_key = start_key_;
+  seg.first_pos = first_pos_;
+  seg.last_pos = last_pos_;
+  // A segment whose points all share one key is never extrapolated from.
+  seg.slope = max_slope_ == std::numeric_limits<double>::infinity()
+                  ? 0
+                  : (min_slope_ + max_slope_) / 2;
+  segments_.push_back(seg);
+  has_segment_ = false;
+}
+
+bool BlockLearnedIndexBuilder::Finish(std::string* contents) {
+  if (has_segment_) {
+    FlushSegment();
+  }
+  if (!monotonic_ || segments_.empty()) {
+    return false;
+  }
+  PutVarint32(contents, max_error_);
+  PutVarint32(contents, static_cast<uint32_t>(segments_.size()));
+  for (const auto& seg : segments_) {
+    PutFixed64(contents, seg.start_key);
+    PutFixed32(contents, seg.first_pos);
+    PutFixed32(contents, seg.last_pos);
+    PutFixed64(contents, EncodeDouble(seg.slope));
+  }
+  return true;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
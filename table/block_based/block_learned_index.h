@@ -0,0 +1,110 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A piecewise-linear model mapping a user key to the restart index of the
+// index block entry that covers it. The key is projected onto the integer
+// line by interpreting its first 8 bytes as a big-endian number (shorter keys
+// are zero padded), which preserves bytewise order. Each segment guarantees
+// that for every restart key it was fitted on, the predicted position is
+// within `max_error` of the actual one.
+//
+// The model only narrows down where IndexBlockIter starts its binary search;
+// the window it predicts is verified against the block before use, so a
+// misprediction (e.g. many keys sharing their first 8 bytes) costs extra
+// comparisons but never produces a wrong result.
+//
+// Serialized format:
+//
+// +-----------------------+--------------------------+
+// | max_error: varint32   | num_segments: varint32   |
+// +-----------------------+--------------------------+
+// <=segment 1
+// | start_key: 8 bytes | first_pos: 4 bytes | last_pos: 4 bytes | slope: 8 |
+// +--------------------+-------------------+------------------+-----------+
+// | ....                                                                   |
+// +--------------------+-------------------+------------------+-----------+
+class BlockLearnedIndex {
+ public:
+  // Projects `user_key` onto the line the model is fitted on.
+  static uint64_t KeyToPosition(const Slice& user_key);
+
+  static Status Create(const Slice& contents,
+                       std::unique_ptr<BlockLearnedIndex>* learned_index);
+
+  // Returns the inclusive range of restart indexes that can hold the last
+  // restart key <= `user_key`.
+  void Predict(const Slice& user_key, uint32_t* first, uint32_t* last) const;
+
+  size_t NumSegments() const { return segments_.size(); }
+
+  size_t ApproximateMemoryUsage() const {
+    return sizeof(BlockLearnedIndex) + segments_.capacity() * sizeof(Segment);
+  }
+
+ private:
+  friend class BlockLearnedIndexBuilder;
+
+  struct Segment {
+    uint64_t start_key;
+    uint32_t first_pos;
+    uint32_t last_pos;
+    double slope;
+  };
+
+  BlockLearnedIndex(uint32_t max_error, std::vector<Segment>&& segments)
+      : max_error_(max_error), segments_(std::move(segments)) {}
+
+  uint32_t max_error_;
+  std::vector<Segment> segments_;
+};
+
+// Fits a BlockLearnedIndex in a single pass with the greedy shrinking cone
+// algorithm: a segment is extended for as long as some line through its first
+// point stays within `max_error` of every point added to it.
+class BlockLearnedIndexBuilder {
+ public:
+  explicit BlockLearnedIndexBuilder(uint32_t max_error)
+      : max_error_(max_error) {}
+
+  // REQUIRES: `pos` is non-decreasing.
+  // If the projections of the added keys ever decrease, e.g. because the
+  // table uses a comparator that does not follow bytewise order, no model is
+  // produced.
+  void Add(const Slice& user_key, uint32_t pos);
+
+  // Serializes the model into `*contents`. Returns false if no usable model
+  // could be fitted.
+  bool Finish(std::string* contents);
+
+ private:
+  void FlushSegment();
+
+  const uint32_t max_error_;
+  std::vector<BlockLearnedIndex::Segment> segments_;
+  bool monotonic_ = true;
+  uint64_t last_key_ = 0;
+
+  // State of the segment being fitted.
+  bool has_segment_ = false;
+  uint64_t start_key_ = 0;
+  uint32_t first_pos_ = 0;
+  uint32_t last_pos_ = 0;
+  double min_slope_ = 0;
+  double max_slope_ = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
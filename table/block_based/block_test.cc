@@ -25,6 +25,7 @@
 #include "rocksdb/table.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/block_learned_index.h"
 #include "table/format.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
@@ -576,6 +577,212 @@ TEST_F(BlockTest, ReadAmpBitmapPow2) {
   ASSERT_EQ(BlockReadAmpBitmap(100, 35, stats.get()).GetBytesPerBit(), 32u);
 }
 
+TEST_F(BlockTest, RestartKeyPrefixes) {
+  Random rnd(301);
+  // Short keys, keys sharing their first 8 bytes and keys that only differ
+  // after the first 8 bytes all exercise the prefix comparisons.
+  std::set<std::string> user_keys;
+  while (user_keys.size() < 800) {
+    std::string key = test::RandomKey(&rnd, 1 + rnd.Uniform(12));
+    if (rnd.OneIn(3)) {
+      key = "samepref" + key;
+    }
+    user_keys.insert(std::move(key));
+  }
+  std::vector<std::string> keys;
+  SequenceNumber seq = 1000;
+  for (const auto& user_key : user_keys) {
+    keys.push_back(
+        InternalKey(user_key, seq--, kTypeValue).Encode().ToString());
+  }
+
+  std::vector<std::string> targets = {
+      InternalKey("", kMaxSequenceNumber, kValueTypeForSeek)
+          .Encode()
+          .ToString(),
+      InternalKey(std::string(9, '\xff'), 0, kTypeValue).Encode().ToString()};
+  for (const auto& key : keys) {
+    const Slice user_key = ExtractUserKey(key);
+    targets.push_back(key);
+    targets.push_back(InternalKey(user_key, 0, kTypeValue).Encode().ToString());
+    targets.push_back(InternalKey(user_key.ToString() + "\x01",
+                                  kMaxSequenceNumber, kValueTypeForSeek)
+                          .Encode()
+                          .ToString());
+  }
+
+  for (int restart_interval : {1, 4, 16}) {
+    for (auto index_type : {BlockBasedTableOptions::kDataBlockBinarySearch,
+                            BlockBasedTableOptions::kDataBlockBinaryAndHash}) {
+      for (size_t value_size : {size_t{10}, size_t{100}}) {
+        auto build = [&](bool use_restart_key_prefixes) {
+          BlockBuilder builder(restart_interval, true /* use_delta_encoding */,
+                               false /* use_value_delta_encoding */,
+                               index_type,
+                               0.75 /* data_block_hash_table_util_ratio */,
+                               0 /* ts_sz */, true /* persist_udt */,
+                               false /* is_user_key */,
+                               use_restart_key_prefixes);
+          for (const auto& key : keys) {
+            builder.Add(key, std::string(value_size, 'v'));
+          }
+          BlockContents contents;
+          contents.data = builder.Finish();
+          contents.allocation =
+              AllocateAndCopyBlock(contents.data, nullptr /* allocator */);
+          contents.data =
+              Slice(contents.allocation.get(), contents.data.size());
+          return std::make_unique<Block>(std::move(contents));
+        };
+        std::unique_ptr<Block> expected_block = build(false);
+        std::unique_ptr<Block> block = build(true);
+        ASSERT_FALSE(expected_block->HasRestartKeyPrefixes());
+        // Flags are only honored in blocks up to 64KiB
+        ASSERT_EQ(block->size() <= kMaxBlockSizeSupportedByHashIndex,
+                  block->HasRestartKeyPrefixes());
+        // The hash index also needs restart indexes of at most
+        // kMaxRestartSupportedByHashIndex, which 800 keys exceed at
+        // restart_interval 1
+        const size_t last_restart_index = (keys.size() - 1) / restart_interval;
+        ASSERT_EQ(
+            index_type == BlockBasedTableOptions::kDataBlockBinaryAndHash &&
+                block->size() <= kMaxBlockSizeSupportedByHashIndex &&
+                last_restart_index <= kMaxRestartSupportedByHashIndex,
+            block->IndexType() ==
+                BlockBasedTableOptions::kDataBlockBinaryAndHash);
+
+        std::unique_ptr<DataBlockIter> expected_iter{
+            expected_block->NewDataIterator(BytewiseComparator(),
+                                            kDisableGlobalSequenceNumber)};
+        std::unique_ptr<DataBlockIter> iter{block->NewDataIterator(
+            BytewiseComparator(), kDisableGlobalSequenceNumber)};
+        size_t count = 0;
+        for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+          ASSERT_EQ(keys[count++], iter->key());
+        }
+        ASSERT_EQ(keys.size(), count);
+
+        for (const auto& target : targets) {
+          expected_iter->Seek(target);
+          iter->Seek(target);
+          ASSERT_EQ(expected_iter->Valid(), iter->Valid());
+          if (iter->Valid()) {
+            ASSERT_EQ(expected_iter->key(), iter->key());
+          }
+          expected_iter->SeekForPrev(target);
+          iter->SeekForPrev(target);
+          ASSERT_EQ(expected_iter->Valid(), iter->Valid());
+          if (iter->Valid()) {
+            ASSERT_EQ(expected_iter->key(), iter->key());
+          }
+          ASSERT_EQ(expected_iter->SeekForGet(target),
+                    iter->SeekForGet(target));
+          ASSERT_EQ(expected_iter->Valid(), iter->Valid());
+          if (iter->Valid()) {
+            ASSERT_EQ(expected_iter->key(), iter->key());
+          }
+        }
+        ASSERT_OK(iter->status());
+      }
+    }
+  }
+}
+
+TEST_F(BlockTest, LearnedIndexSeek) {
+  Random rnd(301);
+  const int kRestartInterval = 4;
+  // Mix evenly spread keys with runs of keys sharing their first 8 bytes, so
+  // that some restart points cannot be told apart by the model.
+  std::set<std::string> key_set;
+  while (key_set.size() < 2000) {
+    std::string key = test::RandomKey(&rnd, 12);
+    if (rnd.OneIn(4)) {
+      key = "samepref" + key;
+    }
+    key_set.insert(std::move(key));
+  }
+  std::vector<std::string> keys(key_set.begin(), key_set.end());
+
+  BlockBuilder builder(kRestartInterval, true /* use_delta_encoding */,
+                       false /* use_value_delta_encoding */,
+                       BlockBasedTableOptions::kDataBlockBinarySearch,
+                       0.75 /* data_block_hash_table_util_ratio */,
+                       0 /* ts_sz */, true /* persist_udt */,
+                       true /* is_user_key */);
+  BlockLearnedIndexBuilder model_builder(4 /* max_error */);
+  // A model fitted on unrelated keys, so that all of its predictions are off.
+  BlockLearnedIndexBuilder bad_model_builder(4 /* max_error */);
+  uint64_t offset = 0;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    std::string encoded_entry;
+    IndexValue(BlockHandle(offset, 100), Slice())
+        .EncodeTo(&encoded_entry, false /* have_first_key */, nullptr);
+    builder.Add(keys[i], encoded_entry);
+    offset += 100 + BlockBasedTable::kBlockTrailerSize;
+    if (i % kRestartInterval == 0) {
+      const uint32_t pos = static_cast<uint32_t>(i / kRestartInterval);
+      model_builder.Add(keys[i], pos);
+      char bad_key[16];
+      snprintf(bad_key, sizeof(bad_key), "a%010d", static_cast<int>(i));
+      bad_model_builder.Add(bad_key, pos);
+    }
+  }
+  std::string model_contents;
+  ASSERT_TRUE(model_builder.Finish(&model_contents));
+  std::unique_ptr<BlockLearnedIndex> model;
+  ASSERT_OK(BlockLearnedIndex::Create(model_contents, &model));
+  // Far fewer segments than restart points.
+  ASSERT_LT(model->NumSegments(), keys.size() / kRestartInterval / 4);
+  std::string bad_model_contents;
+  ASSERT_TRUE(bad_model_builder.Finish(&bad_model_contents));
+  std::unique_ptr<BlockLearnedIndex> bad_model;
+  ASSERT_OK(BlockLearnedIndex::Create(bad_model_contents, &bad_model));
+
+  BlockContents contents;
+  contents.data = builder.Finish();
+  Block reader(std::move(contents));
+
+  auto new_iter = [&](const BlockLearnedIndex* learned_index) {
+    return std::unique_ptr<IndexBlockIter>(reader.NewIndexIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber, nullptr /* iter */,
+        nullptr /* stats */, true /* total_order_seek */,
+        false /* have_first_key */, false /* key_includes_seq */,
+        true /* value_is_full */, false /* block_contents_pinned */,
+        true /* user_defined_timestamps_persisted */,
+        nullptr /* prefix_index */, learned_index));
+  };
+  std::unique_ptr<IndexBlockIter> expected_iter = new_iter(nullptr);
+  std::unique_ptr<IndexBlockIter> iter = new_iter(model.get());
+  std::unique_ptr<IndexBlockIter> bad_iter = new_iter(bad_model.get());
+
+  std::vector<std::string> targets = {"", std::string(9, '\xff')};
+  for (size_t i = 0; i < keys.size(); ++i) {
+    targets.push_back(keys[i]);
+    // In between two keys
+    targets.push_back(keys[i] + "\x01");
+  }
+  for (int i = 0; i < 1000; ++i) {
+    targets.push_back(test::RandomKey(&rnd, 1 + rnd.Uniform(12)));
+  }
+  for (const auto& user_key : targets) {
+    const std::string target =
+        InternalKey(user_key, kMaxSequenceNumber, kValueTypeForSeek)
+            .Encode()
+            .ToString();
+    expected_iter->Seek(target);
+    for (IndexBlockIter* it : {iter.get(), bad_iter.get()}) {
+      it->Seek(target);
+      ASSERT_OK(it->status());
+      ASSERT_EQ(expected_iter->Valid(), it->Valid());
+      if (expected_iter->Valid()) {
+        ASSERT_EQ(expected_iter->key(), it->key());
+        ASSERT_EQ(expected_iter->value().handle.offset(),
+                  it->value().handle.offset());
+      }
+    }
+  }
+}
+
 class IndexBlockTest
     : public testing::Test,
       public testing::WithParamInterface<
@@ -0,0 +1,266 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/data_block_column_stats.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "db/dbformat.h"
+#include "db/wide/wide_column_serialization.h"
+#include "rocksdb/comparator.h"
+#include "rocksdb/options.h"
+#include "table/block_based/block.h"
+#include "table/format.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Longer values are truncated in the statistics. A prefix of the minimum is
+// still a lower bound, and the maximum is replaced by the shortest string
+// greater than all strings with its prefix.
+constexpr size_t kMaxStatsValueSize = 64;
+
+void PutMin(std::string* dst, const Slice& min) {
+  PutLengthPrefixedSlice(
+      dst, Slice(min.data(), std::min(min.size(), kMaxStatsValueSize)));
+}
+
+void PutMax(std::string* dst, const Slice& max) {
+  if (max.size() > kMaxStatsValueSize) {
+    std::string successor(max.data(), kMaxStatsValueSize);
+    while (!successor.empty() &&
+           static_cast<uint8_t>(successor.back()) == 0xff) {
+      successor.pop_back();
+    }
+    if (!successor.empty()) {
+      ++successor.back();
+      PutLengthPrefixedSlice(dst, successor);
+      return;
+    }
+  }
+  PutLengthPrefixedSlice(dst, max);
+}
+}  // namespace
+
+Status DataBlockColumnStats::Create(
+    const Slice& contents, std::unique_ptr<DataBlockColumnStats>* stats) {
+  assert(stats);
+  const Status corruption =
+      Status::Corruption("Bad data block column statistics");
+
+  std::unique_ptr<DataBlockColumnStats> result(new DataBlockColumnStats());
+  result->contents_.assign(contents.data(), contents.size());
+  Slice in = result->contents_;
+
+  uint32_t num_names = 0;
+  if (!GetVarint32(&in, &num_names) || num_names > in.size()) {
+    return corruption;
+  }
+  result->names_.resize(num_names);
+  for (auto& name : result->names_) {
+    if (!GetLengthPrefixedSlice(&in, &name)) {
+      return corruption;
+    }
+  }
+
+  uint32_t num_blocks = 0;
+  if (!GetVarint32(&in, &num_blocks) || num_blocks > in.size()) {
+    return corruption;
+  }
+  result->offsets_.reserve(num_blocks);
+  result->flags_.reserve(num_blocks);
+  result->ranges_.reserve(static_cast<size_t>(num_blocks) * num_names);
+  result->file_ranges_.resize(num_names);
+  for (uint32_t i = 0; i < num_blocks; ++i) {
+    uint64_t offset = 0;
+    if (!GetVarint64(&in, &offset) || in.empty() ||
+        (!result->offsets_.empty() && offset <= result->offsets_.back())) {
+      return corruption;
+    }
+    const uint8_t flags = static_cast<uint8_t>(in[0]);
+    in.remove_prefix(1);
+    result->offsets_.push_back(offset);
+    result->flags_.push_back(flags);
+    result->all_blocks_skippable_ &= (flags & kAllEntriesSkippable) != 0;
+
+    for (uint32_t j = 0; j < num_names; ++j) {
+      if (in.empty()) {
+        return corruption;
+      }
+      ColumnRange range;
+      range.present = in[0] != 0;
+      in.remove_prefix(1);
+      if (range.present && (!GetLengthPrefixedSlice(&in, &range.min) ||
+                             !GetLengthPrefixedSlice(&in, &range.max))) {
+        return corruption;
+      }
+      ColumnRange& file_range = result->file_ranges_[j];
+      if (range.present) {
+        if (!file_range.present || range.min.compare(file_range.min) < 0) {
+          file_range.min = range.min;
+        }
+        if (!file_range.present || range.max.compare(file_range.max) > 0) {
+          file_range.max = range.max;
+        }
+        file_range.present = true;
+      }
+      result->ranges_.push_back(range);
+    }
+  }
+  if (!in.empty()) {
+    return corruption;
+  }
+
+  *stats = std::move(result);
+  return Status::OK();
+}
+
+int DataBlockColumnStats::FindColumn(const Slice& column_name) const {
+  for (size_t i = 0; i < names_.size(); ++i) {
+    if (names_[i] == column_name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool DataBlockColumnStats::CanSkip(const ScanPredicate& predicate,
+                                   bool skippable, const ColumnRange& range) {
+  // An entry without the column never satisfies the predicate
+  return skippable &&
+         (!range.present || !predicate.MayMatch(range.min, range.max));
+}
+
+bool DataBlockColumnStats::CanSkipBlock(const ScanPredicate& predicate,
+                                        uint64_t offset) const {
+  const int column = FindColumn(predicate.column_name);
+  if (column < 0) {
+    return false;
+  }
+  auto it = std::lower_bound(offsets_.begin(), offsets_.end(), offset);
+  if (it == offsets_.end() || *it != offset) {
+    return false;
+  }
+  const size_t block = static_cast<size_t>(it - offsets_.begin());
+  return CanSkip(predicate, (flags_[block] & kAllEntriesSkippable) != 0,
+                 ranges_[block * names_.size() + column]);
+}
+
+bool DataBlockColumnStats::CanSkipFile(const ScanPredicate& predicate) const {
+  const int column = FindColumn(predicate.column_name);
+  if (column < 0 || offsets_.empty()) {
+    return false;
+  }
+  return CanSkip(predicate, all_blocks_skippable_, file_ranges_[column]);
+}
+
+size_t DataBlockColumnStats::ApproximateMemoryUsage() const {
+  return sizeof(DataBlockColumnStats) + contents_.capacity() +
+         names_.capacity() * sizeof(Slice) +
+         offsets_.capacity() * sizeof(uint64_t) + flags_.capacity() +
+         (ranges_.capacity() + file_ranges_.capacity()) * sizeof(ColumnRange);
+}
+
+DataBlockColumnStatsBuilder::DataBlockColumnStatsBuilder(
+    std::vector<std::string> column_names)
+    : column_names_(std::move(column_names)) {
+  std::sort(column_names_.begin(), column_names_.end());
+  column_names_.erase(std::unique(column_names_.begin(), column_names_.end()),
+                      column_names_.end());
+}
+
+void DataBlockColumnStatsBuilder::ComputeBlockStats(
+    const Slice& block, std::string* block_stats) const {
+  assert(block_stats);
+
+  struct ValueRange {
+    bool present = false;
+    Slice min;
+    Slice max;
+  };
+  std::vector<ValueRange> ranges(column_names_.size());
+  bool skippable = true;
+
+  Block row_block(BlockContents{block});
+  std::unique_ptr<DataBlockIter> iter{row_block.NewDataIterator(
+      BytewiseComparator(), kDisableGlobalSequenceNumber)};
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    SequenceNumber seq = 0;
+    ValueType type = kTypeValue;
+    UnPackSequenceAndType(ExtractInternalKeyFooter(iter->key()), &seq, &type);
+    if (type != kTypeValue && type != kTypeWideColumnEntity) {
+      skippable = false;
+      continue;
+    }
+    skippable &= seq == 0;
+
+    for (size_t i = 0; i < column_names_.size(); ++i) {
+      const Slice column_name = column_names_[i];
+      Slice value;
+      bool found = false;
+      if (type == kTypeValue) {
+        found = column_name == kDefaultWideColumnName;
+        value = iter->value();
+      } else {
+        Slice input = iter->value();
+        const Status s = WideColumnSerialization::GetValueOfColumn(
+            input, column_name, value, found);
+        if (!s.ok()) {
+          // Leave it to the readers to report the corruption
+          skippable = false;
+          found = false;
+        }
+      }
+      if (!found) {
+        continue;
+      }
+      ValueRange& range = ranges[i];
+      if (!range.present || value.compare(range.min) < 0) {
+        range.min = value;
+      }
+      if (!range.present || value.compare(range.max) > 0) {
+        range.max = value;
+      }
+      range.present = true;
+    }
+  }
+  if (!iter->status().ok()) {
+    skippable = false;
+  }
+
+  block_stats->clear();
+  block_stats->push_back(
+      static_cast<char>(skippable ? DataBlockColumnStats::kAllEntriesSkippable
+                                  : 0));
+  for (const ValueRange& range : ranges) {
+    block_stats->push_back(range.present ? 1 : 0);
+    if (range.present) {
+      PutMin(block_stats, range.min);
+      PutMax(block_stats, range.max);
+    }
+  }
+}
+
+void DataBlockColumnStatsBuilder::AddBlock(uint64_t offset,
+                                           const Slice& block_stats) {
+  PutVarint64(&blocks_, offset);
+  blocks_.append(block_stats.data(), block_stats.size());
+  ++num_blocks_;
+}
+
+Slice DataBlockColumnStatsBuilder::Finish() {
+  contents_.clear();
+  PutVarint32(&contents_, static_cast<uint32_t>(column_names_.size()));
+  for (const auto& name : column_names_) {
+    PutLengthPrefixedSlice(&contents_, name);
+  }
+  PutVarint32(&contents_, num_blocks_);
+  contents_.append(blocks_);
+  return contents_;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
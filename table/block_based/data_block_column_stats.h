@@ -0,0 +1,109 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct ScanPredicate;
+
+// Minimum and maximum value of selected wide columns in each data block (see
+// BlockBasedTableOptions::data_block_column_stats), used by iterators with a
+// ReadOptions::scan_predicate to skip data blocks without reading them.
+//
+// Dropping an entry from a scan is only correct if no older version of its
+// key can show through, so a block is only skippable if all of its entries
+// are values or entities with sequence number zero, i.e. the only version of
+// their key. Whether this holds is recorded along with the statistics.
+//
+// Meta block format (all integers are varint32 unless noted otherwise):
+//
+// COLUMN_STATS: [NAMES BLOCKS]
+//
+// NAMES:  count, then each column name as a length-prefixed slice
+// BLOCKS: count, then for each data block, in file order: its offset
+//         (varint64), flags (1 byte, kAllEntriesSkippable), then for each
+//         column a presence byte and, if the column is present in the block,
+//         its minimum and maximum value as length-prefixed slices
+class DataBlockColumnStats {
+ public:
+  enum Flags : uint8_t {
+    // All entries are values or entities with sequence number zero
+    kAllEntriesSkippable = 1 << 0,
+  };
+
+  static Status Create(const Slice& contents,
+                       std::unique_ptr<DataBlockColumnStats>* stats);
+
+  // Whether no entry of the data block at `offset` can satisfy `predicate`,
+  // and the block can be skipped. False for unknown blocks.
+  bool CanSkipBlock(const ScanPredicate& predicate, uint64_t offset) const;
+
+  // Whether every data block of the file can be skipped.
+  bool CanSkipFile(const ScanPredicate& predicate) const;
+
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  struct ColumnRange {
+    bool present = false;
+    Slice min;
+    Slice max;
+  };
+
+  DataBlockColumnStats() = default;
+
+  // Index of the column `column_name` in names_, or -1 if there are no
+  // statistics for it.
+  int FindColumn(const Slice& column_name) const;
+  static bool CanSkip(const ScanPredicate& predicate, bool skippable,
+                      const ColumnRange& range);
+
+  std::string contents_;
+  std::vector<Slice> names_;
+  std::vector<uint64_t> offsets_;
+  std::vector<uint8_t> flags_;
+  // ranges_[block * names_.size() + column]
+  std::vector<ColumnRange> ranges_;
+  // Over all blocks
+  bool all_blocks_skippable_ = true;
+  std::vector<ColumnRange> file_ranges_;
+};
+
+// Collects the statistics of the data blocks of a table as they are written.
+class DataBlockColumnStatsBuilder {
+ public:
+  explicit DataBlockColumnStatsBuilder(std::vector<std::string> column_names);
+
+  // Computes the statistics of the row-format data block `block` into
+  // `*block_stats`. Thread-safe, so it can run on the compression threads.
+  void ComputeBlockStats(const Slice& block, std::string* block_stats) const;
+
+  // Records the statistics computed by ComputeBlockStats() for the data block
+  // written at `offset`. Blocks must be added in file order.
+  void AddBlock(uint64_t offset, const Slice& block_stats);
+
+  bool empty() const { return num_blocks_ == 0; }
+
+  // Returns the contents of the meta block, valid until the builder is
+  // destroyed.
+  Slice Finish();
+
+ private:
+  std::vector<std::string> column_names_;
+  uint32_t num_blocks_ = 0;
+  std::string blocks_;
+  std::string contents_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -13,13 +13,17 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+// The block footer is NUM_RESTARTS with the MSB flagging the data block hash
+// index and the next bit flagging the restart key prefix array. Like the hash
+// index, the prefix array is only used in blocks smaller than 64KiB, whose
+// NUM_RESTARTS never reaches into those bits.
 uint32_t PackIndexTypeAndNumRestarts(
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    uint32_t num_restarts);
+    uint32_t num_restarts, bool has_restart_key_prefixes = false);
 
 void UnPackIndexTypeAndNumRestarts(
     uint32_t block_footer,
     BlockBasedTableOptions::DataBlockIndexType* index_type,
-    uint32_t* num_restarts);
+    uint32_t* num_restarts, bool* has_restart_key_prefixes = nullptr);
 
 }  // namespace ROCKSDB_NAMESPACE
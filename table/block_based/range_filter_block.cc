@@ -0,0 +1,91 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/range_filter_block.h"
+
+#include <algorithm>
+
+#include "table/block_based/block.h"
+#include "table/format.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Denser restart points than data blocks, as the truncated keys are short
+constexpr int kRangeFilterRestartInterval = 16;
+}  // namespace
+
+bool RangeFilter::RangeMayMatch(const Slice& lower, const Slice& upper) const {
+  if (lower.compare(upper) >= 0) {
+    return false;
+  }
+  std::unique_ptr<MetaBlockIter> iter(block_->NewMetaIterator());
+  iter->Seek(lower);
+  if (iter->Valid()) {
+    // The smallest key that starts with the truncated key is the truncated
+    // key itself.
+    if (iter->key().compare(upper) < 0) {
+      return true;
+    }
+    iter->Prev();
+  } else if (iter->status().ok()) {
+    iter->SeekToLast();
+  }
+  if (!iter->status().ok()) {
+    // Be conservative with a corrupted filter
+    return true;
+  }
+  // Keys that start with a truncated key < lower are only >= lower if lower
+  // starts with it too.
+  return iter->Valid() && lower.starts_with(iter->key());
+}
+
+bool RangeFilter::HasKeyAtOrAfter(const Slice& key) const {
+  std::unique_ptr<MetaBlockIter> iter(block_->NewMetaIterator());
+  iter->SeekToLast();
+  // The last truncated key is a lower bound of the last key of the table. A
+  // corrupted filter does not tell.
+  return iter->Valid() && iter->key().compare(key) >= 0;
+}
+
+RangeFilterBuilder::RangeFilterBuilder(uint32_t suffix_bytes)
+    : suffix_bytes_(suffix_bytes), block_(kRangeFilterRestartInterval) {}
+
+void RangeFilterBuilder::AddKey(const Slice& user_key) {
+  size_t common_prefix = 0;
+  if (has_pending_key_) {
+    if (user_key == pending_key_) {
+      return;
+    }
+    assert(Slice(pending_key_).compare(user_key) < 0);
+    common_prefix = Slice(pending_key_).difference_offset(user_key);
+    AddPendingKey(common_prefix);
+  }
+  pending_key_.assign(user_key.data(), user_key.size());
+  pending_prev_common_prefix_ = common_prefix;
+  has_pending_key_ = true;
+}
+
+void RangeFilterBuilder::AddPendingKey(size_t next_common_prefix) {
+  assert(has_pending_key_);
+  // The first byte past the longer common prefix tells the key apart from
+  // both neighbors.
+  const size_t length =
+      std::min(pending_key_.size(),
+               std::max(pending_prev_common_prefix_, next_common_prefix) + 1 +
+                   suffix_bytes_);
+  block_.Add(Slice(pending_key_.data(), length), Slice());
+  ++num_keys_;
+}
+
+Slice RangeFilterBuilder::Finish() {
+  if (has_pending_key_) {
+    AddPendingKey(0);
+    has_pending_key_ = false;
+  }
+  return block_.Finish();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
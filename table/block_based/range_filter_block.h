@@ -0,0 +1,81 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "table/block_based/block_builder.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class Block;
+
+// Range filter over the user keys of a table (see
+// BlockBasedTableOptions::range_filter), answering whether the table may hold
+// a key in a given range without reading index or data blocks.
+//
+// Like SuRF, the filter truncates each key to the shortest prefix that
+// distinguishes it from its neighbors, plus a configurable number of suffix
+// bytes. Truncated keys are sorted the same way as the keys, and every key
+// lies within the keys that start with its truncated key, so a range [lower,
+// upper) may hold a key if and only if the first truncated key >= lower is
+// < upper, or the last truncated key < lower is a prefix of lower. Instead of
+// a succinct trie, the truncated keys are stored front coded in a meta block
+// with the regular block format, binary searched through its restart points.
+//
+// Only valid with the bytewise order of user keys. The meta block is read
+// like the other filter blocks, i.e. through the block cache with
+// cache_index_and_filter_blocks, so this is only a view of it.
+class RangeFilter {
+ public:
+  // `block` must outlive the filter
+  explicit RangeFilter(Block* block) : block_(block) {}
+
+  // Whether the table may hold a user key in [lower, upper)
+  bool RangeMayMatch(const Slice& lower, const Slice& upper) const;
+
+  // Whether the table definitely holds a user key >= `key`
+  bool HasKeyAtOrAfter(const Slice& key) const;
+
+ private:
+  Block* const block_;
+};
+
+// Builds a RangeFilter from the user keys of a table, as they are added.
+class RangeFilterBuilder {
+ public:
+  explicit RangeFilterBuilder(uint32_t suffix_bytes);
+
+  // REQUIRES: keys are added in bytewise order. Repeated keys (other
+  // versions of the same user key) are ignored.
+  void AddKey(const Slice& user_key);
+
+  bool empty() const { return !has_pending_key_ && num_keys_ == 0; }
+
+  // Returns the contents of the meta block, valid until the builder is
+  // destroyed.
+  Slice Finish();
+
+ private:
+  // Adds the truncated pending key, given the length of the common prefix
+  // with the next key.
+  void AddPendingKey(size_t next_common_prefix);
+
+  const size_t suffix_bytes_;
+  BlockBuilder block_;
+  uint64_t num_keys_ = 0;
+  // The last key is only added once the next one is known
+  bool has_pending_key_ = false;
+  std::string pending_key_;
+  // Length of the common prefix of the pending key and the key before it
+  size_t pending_prev_common_prefix_ = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,128 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/restart_key_prefixes.h"
+
+#include <cassert>
+
+#include "port/port.h"
+#include "util/coding_lean.h"
+#include "util/math.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Up to this many restart points the prefixes are counted with a linear
+// (vectorized where available) scan, which beats binary search's unpredictable
+// branches on the typical 4-16KiB data block.
+constexpr uint32_t kMaxLinearScanRestarts = 64;
+
+inline uint64_t PrefixAt(const char* prefixes, uint32_t i) {
+  return DecodeFixed64(prefixes + i * sizeof(uint64_t));
+}
+
+// First index in [begin, end) whose prefix is not less than (or, with
+// `inclusive`, not greater than) `target`.
+inline uint32_t PartitionPoint(const char* prefixes, uint32_t begin,
+                               uint32_t end, uint64_t target, bool inclusive) {
+  while (begin < end) {
+    const uint32_t mid = begin + (end - begin) / 2;
+    const uint64_t p = PrefixAt(prefixes, mid);
+    if (p < target || (inclusive && p == target)) {
+      begin = mid + 1;
+    } else {
+      end = mid;
+    }
+  }
+  return begin;
+}
+
+void LinearScan(const char* prefixes, uint32_t num_restarts, uint64_t target,
+                uint32_t* lower, uint32_t* upper) {
+  uint32_t lt = 0;
+  uint32_t le = 0;
+  uint32_t i = 0;
+  // The prefixes are sorted, so the scan can stop at the first group holding
+  // a prefix greater than `target`.
+#ifdef __AVX2__
+  if (port::kLittleEndian) {
+    // AVX2 only has signed 64-bit compares; flipping the sign bit of both
+    // sides maps unsigned order onto signed order.
+    const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+    const __m256i t = _mm256_xor_si256(
+        _mm256_set1_epi64x(static_cast<long long>(target)), sign);
+    for (; i + 4 <= num_restarts; i += 4) {
+      const __m256i p = _mm256_xor_si256(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+              prefixes + i * sizeof(uint64_t))),
+          sign);
+      const int lt_mask =
+          _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(t, p)));
+      const int gt_mask =
+          _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(p, t)));
+      lt += BitsSetToOne(static_cast<unsigned>(lt_mask));
+      le += 4 - BitsSetToOne(static_cast<unsigned>(gt_mask));
+      if (gt_mask != 0) {
+        *lower = lt;
+        *upper = le;
+        return;
+      }
+    }
+  }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  if (port::kLittleEndian) {
+    const uint64x2_t t = vdupq_n_u64(target);
+    for (; i + 2 <= num_restarts; i += 2) {
+      const uint64x2_t p = vreinterpretq_u64_u8(vld1q_u8(
+          reinterpret_cast<const uint8_t*>(prefixes + i * sizeof(uint64_t))));
+      // Lanes are all ones where the comparison holds
+      const uint64x2_t lt_lanes = vshrq_n_u64(vcltq_u64(p, t), 63);
+      const uint64x2_t le_lanes = vshrq_n_u64(vcleq_u64(p, t), 63);
+      lt += static_cast<uint32_t>(vaddvq_u64(lt_lanes));
+      const uint32_t le_in_group = static_cast<uint32_t>(vaddvq_u64(le_lanes));
+      le += le_in_group;
+      if (le_in_group != 2) {
+        *lower = lt;
+        *upper = le;
+        return;
+      }
+    }
+  }
+#endif
+  for (; i < num_restarts; ++i) {
+    const uint64_t p = PrefixAt(prefixes, i);
+    if (p > target) {
+      break;
+    }
+    lt += p < target;
+    ++le;
+  }
+  *lower = lt;
+  *upper = le;
+}
+}  // namespace
+
+void FindRestartKeyPrefixRange(const char* prefixes, uint32_t num_restarts,
+                               uint64_t target, uint32_t* lower,
+                               uint32_t* upper) {
+  assert(prefixes != nullptr);
+  if (num_restarts <= kMaxLinearScanRestarts) {
+    LinearScan(prefixes, num_restarts, target, lower, upper);
+  } else {
+    *lower = PartitionPoint(prefixes, 0, num_restarts, target,
+                            false /* inclusive */);
+    *upper = PartitionPoint(prefixes, *lower, num_restarts, target,
+                            true /* inclusive */);
+  }
+  assert(*lower <= *upper && *upper <= num_restarts);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,46 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+// Restart key prefixes are an optional addition to data blocks that lets
+// DataBlockIter narrow a seek down to the restart interval(s) that can hold
+// the target without decoding any key. The new block data format is:
+//
+// DATA_BLOCK: [RI RI RI ... RI RI_IDX PREFIXES [HASH_IDX] FOOTER]
+//
+// PREFIXES: NUM_RESTARTS fixed64 values, the i-th being the first 8 bytes of
+//           the user key at restart point i read as a big-endian integer
+//           (zero padded if shorter). Its presence is flagged in FOOTER (see
+//           data_block_footer.h).
+//
+// For a bytewise ordered user key space, comparing two such prefixes agrees
+// with comparing the keys whenever the prefixes differ, so the prefix array
+// is sorted and only restart keys whose prefix equals the target's need an
+// actual key comparison.
+
+// Returns the first 8 bytes of `key` as a big-endian integer, zero padded.
+inline uint64_t KeyPrefixAsUint64(const Slice& key) {
+  uint64_t result = 0;
+  const size_t n = key.size() < sizeof(result) ? key.size() : sizeof(result);
+  for (size_t i = 0; i < n; ++i) {
+    result = (result << 8) | static_cast<unsigned char>(key[i]);
+  }
+  return n == 0 ? 0 : result << (8 * (sizeof(result) - n));
+}
+
+// Given the `num_restarts` sorted prefixes encoded at `prefixes`, sets
+// `*lower` to the number of prefixes < `target` and `*upper` to the number of
+// prefixes <= `target`.
+void FindRestartKeyPrefixRange(const char* prefixes, uint32_t num_restarts,
+                               uint64_t target, uint32_t* lower,
+                               uint32_t* upper);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -6,6 +6,7 @@
 #include "table/compaction_merging_iterator.h"
 
 #include "db/internal_stats.h"
+#include "table/reusable_data_block.h"
 
 namespace ROCKSDB_NAMESPACE {
 class CompactionMergingIterator : public InternalIterator {
@@ -131,6 +132,26 @@ class CompactionMergingIterator : public InternalIterator {
     return current_->type == HeapItem::DELETE_RANGE_START;
   }
 
+  // The block must also end before the next key of the other inputs,
+  // including the start keys of their range tombstones, which would
+  // otherwise be merged with its entries
+  bool GetReusableDataBlock(const Slice* limit,
+                            ReusableDataBlock* block) override {
+    assert(Valid());
+    if (current_->type != HeapItem::ITERATOR) {
+      return false;
+    }
+    Slice next_user_key;
+    if (minHeap_.size() > 1) {
+      next_user_key = ExtractUserKey(minHeap_.second_top()->key());
+      if (limit == nullptr || comparator_->user_comparator()->Compare(
+                                  next_user_key, *limit) < 0) {
+        limit = &next_user_key;
+      }
+    }
+    return current_->iter.GetReusableDataBlock(limit, block);
+  }
+
   // Compaction uses the above subset of InternalIterator interface.
   void SeekToLast() override { assert(false); }
 
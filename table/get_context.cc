@@ -10,6 +10,7 @@
 #include "db/pinned_iterators_manager.h"
 #include "db/read_callback.h"
 #include "db/wide/wide_column_serialization.h"
+#include "db/wide/wide_columns_helper.h"
 #include "monitoring/file_read_sample.h"
 #include "monitoring/perf_context_imp.h"
 #include "monitoring/statistics_impl.h"
@@ -341,11 +342,20 @@ bool GetContext::SaveValue(const ParsedInternalKey& parsed_key,
               }
             } else if (columns_ != nullptr) {
               if (type == kTypeWideColumnEntity) {
-                if (!columns_->SetWideColumnValue(unpacked_value, value_pinner)
-                         .ok()) {
+                const Status s =
+                    column_projection_
+                        ? WideColumnsHelper::SetProjectedWideColumnValue(
+                              unpacked_value, *column_projection_, *columns_)
+                        : columns_->SetWideColumnValue(unpacked_value,
+                                                       value_pinner);
+                if (!s.ok()) {
                   state_ = kCorrupt;
                   return false;
                 }
+              } else if (column_projection_) {
+                WideColumnsHelper::SetProjectedPlainValue(
+                    unpacked_value, value_pinner, *column_projection_,
+                    *columns_);
               } else {
                 columns_->SetPlainValue(unpacked_value, value_pinner);
               }
@@ -498,6 +508,11 @@ void GetContext::PostprocessMerge(const Status& merge_status) {
 
   if (LIKELY(pinnable_val_ != nullptr)) {
     pinnable_val_->PinSelf();
+  } else if (columns_ != nullptr && column_projection_ != nullptr) {
+    if (!WideColumnsHelper::ProjectColumns(*column_projection_, *columns_)
+             .ok()) {
+      state_ = kCorrupt;
+    }
   }
 }
 
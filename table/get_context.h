@@ -5,6 +5,7 @@
 
 #pragma once
 #include <string>
+#include <vector>
 
 #include "db/read_callback.h"
 #include "rocksdb/types.h"
@@ -165,6 +166,12 @@ class GetContext {
   // another GetContext with replayGetContextLog.
   void SetReplayLog(std::string* replay_log) { replay_log_ = replay_log; }
 
+  // If non-null, only the wide columns named in `projection` are returned in
+  // the columns output. See ReadOptions::column_projection.
+  void SetColumnProjection(const std::vector<Slice>* projection) {
+    column_projection_ = projection;
+  }
+
   // Do we need to fetch the SequenceNumber for this key?
   bool NeedToReadSequence() const { return (seq_ != nullptr); }
 
@@ -223,6 +230,7 @@ class GetContext {
   PinnableSlice ukey_with_ts_found_;
   PinnableSlice* pinnable_val_;
   PinnableWideColumns* columns_;
+  const std::vector<Slice>* column_projection_ = nullptr;
   std::string* timestamp_;
   bool ts_from_rangetombstone_{false};
   bool* value_found_;  // Is value set correctly? Used by KeyMayExist
@@ -0,0 +1,57 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/hot_key_ranges.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ROCKSDB_NAMESPACE {
+
+HotKeyRanges::HotKeyRanges(
+    const Comparator* ucmp,
+    std::vector<std::pair<std::string, std::string>> ranges,
+    uint64_t budget_bytes)
+    : ucmp_(ucmp), remaining_budget_(budget_bytes) {
+  assert(ucmp_);
+  std::sort(ranges.begin(), ranges.end(),
+            [this](const std::pair<std::string, std::string>& a,
+                   const std::pair<std::string, std::string>& b) {
+              return ucmp_->Compare(a.first, b.first) < 0;
+            });
+  for (auto& range : ranges) {
+    if (!ranges_.empty() &&
+        ucmp_->Compare(range.first, ranges_.back().second) <= 0) {
+      if (ucmp_->Compare(range.second, ranges_.back().second) > 0) {
+        ranges_.back().second = std::move(range.second);
+      }
+    } else {
+      ranges_.push_back(std::move(range));
+    }
+  }
+}
+
+bool HotKeyRanges::Contains(const Slice& user_key, size_t* cursor) const {
+  assert(cursor);
+  while (*cursor < ranges_.size() &&
+         ucmp_->Compare(ranges_[*cursor].second, user_key) < 0) {
+    ++*cursor;
+  }
+  return *cursor < ranges_.size() &&
+         ucmp_->Compare(ranges_[*cursor].first, user_key) <= 0;
+}
+
+bool HotKeyRanges::TryCharge(size_t bytes) {
+  uint64_t remaining = remaining_budget_.load(std::memory_order_relaxed);
+  while (remaining >= bytes) {
+    if (remaining_budget_.compare_exchange_weak(remaining, remaining - bytes,
+                                                std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,48 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rocksdb/comparator.h"
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Ranges of user keys whose data blocks were in the block cache in the input
+// files of a compaction, so that the data blocks of the output files covering
+// them can be inserted into the block cache as they are written (see
+// BlockBasedTableOptions::PrepopulateBlockCache::kFlushAndCompaction). Shared
+// by the table builders of all subcompactions, which draw from a common
+// budget.
+class HotKeyRanges {
+ public:
+  // `ranges` are inclusive and may overlap and be in any order.
+  HotKeyRanges(const Comparator* ucmp,
+               std::vector<std::pair<std::string, std::string>> ranges,
+               uint64_t budget_bytes);
+
+  // Returns true if `user_key` is in one of the ranges. Keys must be passed
+  // in increasing order for the same `*cursor`, which starts at 0.
+  bool Contains(const Slice& user_key, size_t* cursor) const;
+
+  // Returns true and consumes `bytes` of the budget if enough of it is left.
+  bool TryCharge(size_t bytes);
+
+  size_t NumRanges() const { return ranges_.size(); }
+
+ private:
+  const Comparator* const ucmp_;
+  // Sorted and non-overlapping
+  std::vector<std::pair<std::string, std::string>> ranges_;
+  std::atomic<uint64_t> remaining_budget_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -19,6 +19,7 @@
 namespace ROCKSDB_NAMESPACE {
 
 class PinnedIteratorsManager;
+struct ReusableDataBlock;
 
 template <class TValue>
 class InternalIteratorBase : public Cleanable {
@@ -202,6 +203,17 @@ class InternalIteratorBase : public Cleanable {
 
   virtual void Prepare(const std::vector<ScanOptions>* /*scan_opts*/) {}
 
+  // Used by compactions reusing the data blocks of their input tables, see
+  // ReusableDataBlock. If the current entry is the first one of a data block
+  // that can be written to another table in its stored form, and the user
+  // key of its index entry, which bounds its keys, is less than `*limit` (if
+  // not null), fills `block` and returns true.
+  // REQUIRES: Valid()
+  virtual bool GetReusableDataBlock(const Slice* /*limit*/,
+                                    ReusableDataBlock* /*block*/) {
+    return false;
+  }
+
  protected:
   void SeekForPrevImpl(const Slice& target, const CompareInterface* cmp) {
     Seek(target);
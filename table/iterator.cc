@@ -30,6 +30,36 @@ Status Iterator::GetProperty(std::string prop_name, std::string* prop) {
   return Status::InvalidArgument("Unidentified property.");
 }
 
+size_t Iterator::NextBatch(size_t max_entries, size_t max_bytes, Slice* keys,
+                           Slice* values, std::string* buf) {
+  assert(buf);
+  buf->clear();
+  size_t num_entries = 0;
+  size_t num_bytes = 0;
+  while (num_entries < max_entries &&
+         (num_entries == 0 || num_bytes < max_bytes) && Valid() &&
+         PrepareValue()) {
+    const Slice key_slice = key();
+    const Slice value_slice = value();
+    buf->append(key_slice.data(), key_slice.size());
+    buf->append(value_slice.data(), value_slice.size());
+    keys[num_entries] = Slice(nullptr, key_slice.size());
+    values[num_entries] = Slice(nullptr, value_slice.size());
+    num_bytes += key_slice.size() + value_slice.size();
+    ++num_entries;
+    Next();
+  }
+  // Point the slices to their copies, now that `buf` will not move anymore
+  const char* pos = buf->data();
+  for (size_t i = 0; i < num_entries; ++i) {
+    keys[i] = Slice(pos, keys[i].size());
+    pos += keys[i].size();
+    values[i] = Slice(pos, values[i].size());
+    pos += values[i].size();
+  }
+  return num_entries;
+}
+
 namespace {
 class EmptyIterator : public Iterator {
  public:
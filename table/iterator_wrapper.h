@@ -195,6 +195,11 @@ class IteratorWrapperBase {
     return iter_->IsDeleteRangeSentinelKey();
   }
 
+  bool GetReusableDataBlock(const Slice* limit, ReusableDataBlock* block) {
+    assert(Valid());
+    return iter_->GetReusableDataBlock(limit, block);
+  }
+
   // scan_opts lifetime is guaranteed until the iterator is destructed, or
   // Prepare() is called with a new scan_opts
   void Prepare(const std::vector<ScanOptions>* scan_opts) {
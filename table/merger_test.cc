@@ -99,9 +99,15 @@ class MergerTest : public testing::Test {
 
   void Generate(size_t num_iterators, size_t strings_per_iterator,
                 int letters_per_string) {
+    Generate(std::vector<size_t>(num_iterators, strings_per_iterator),
+             letters_per_string);
+  }
+
+  void Generate(const std::vector<size_t>& strings_per_iterator,
+                int letters_per_string) {
     std::vector<InternalIterator*> small_iterators;
-    for (size_t i = 0; i < num_iterators; ++i) {
-      auto strings = GenerateStrings(strings_per_iterator, letters_per_string);
+    for (size_t num_strings : strings_per_iterator) {
+      auto strings = GenerateStrings(num_strings, letters_per_string);
       small_iterators.push_back(new VectorIterator(strings, strings, &icomp_));
       all_keys_.insert(all_keys_.end(), strings.begin(), strings.end());
     }
@@ -137,6 +143,19 @@ TEST_F(MergerTest, SeekToRandomNextSmallStringsTest) {
   }
 }
 
+TEST_F(MergerTest, SeekToRandomNextDominantIteratorTest) {
+  // Long runs of keys from the first iterator, interrupted by the others
+  Generate({20000, 100, 10, 1}, 5);
+  for (int i = 0; i < 10; ++i) {
+    SeekToRandom();
+    AssertEquivalence();
+    Next(50000);
+    SeekToRandom();
+    NextAndPrev(100);
+    Next(1000);
+  }
+}
+
 TEST_F(MergerTest, SeekToRandomPrevTest) {
   Generate(1000, 50, 50);
   for (int i = 0; i < 10; ++i) {
@@ -362,10 +362,14 @@ class MergingIterator : public InternalIterator {
     // as the current points to the current record. move the iterator forward.
     current_->Next();
     if (current_->Valid()) {
+      assert(current_->status().ok());
+      if (ContinuesRun()) {
+        // current_ is still the top of minHeap_ and its key is visible.
+        return;
+      }
       // current is still valid after the Next() call above.  Call
       // replace_top() to restore the heap property.  When the same child
       // iterator yields a sequence of keys, this is cheap.
-      assert(current_->status().ok());
       minHeap_.replace_top(minHeap_.top());
     } else {
       // current stopped being valid, remove it from the heap.
@@ -676,6 +680,24 @@ class MergingIterator : public InternalIterator {
 
   void SwitchToForward();
 
+  // Fast path of Next() for runs of consecutive keys from the same child,
+  // e.g. a compacted bottommost level. Returns true if the key current_ was
+  // just advanced to is smaller than everything else in minHeap_, so the heap
+  // needs no maintenance, and is visible. As no range tombstone is active and
+  // every tombstone start key in minHeap_ is after the current key, it cannot
+  // be covered. Only compares the current key to the second smallest item of
+  // minHeap_, which does not change for as long as the run lasts.
+  bool ContinuesRun() {
+    assert(direction_ == kForward);
+    assert(current_ == &minHeap_.top()->iter);
+    if (!active_.empty() || current_->IsDeleteRangeSentinelKey()) {
+      return false;
+    }
+    return minHeap_.size() == 1 ||
+           MinHeapItemComparator(comparator_)(minHeap_.second_top(),
+                                              minHeap_.top());
+  }
+
   // Switch the direction from forward to backward without changing the
   // position. Iterator should still be valid.
   void SwitchToBackward();
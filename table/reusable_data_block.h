@@ -0,0 +1,45 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "rocksdb/compression_type.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A data block of an input table of a compaction, which might be written to
+// an output table as stored instead of being built and compressed again (see
+// BlockBasedTableOptions::reuse_data_blocks_in_compaction).
+//
+// InternalIterator::GetReusableDataBlock() fills it when the iterator is at
+// the first entry of the block and the index key of the block is before the
+// next user key of the other inputs, so that no other entry can be merged
+// with the entries of the block. The compaction then hands it to
+// TableBuilder::SetReusableDataBlock() along with that entry.
+//
+// The entries of the block still come out of the compaction and are added
+// to the table builder, which accounts for them in filters, index and table
+// properties, but not in a data block. The compaction checks that each of
+// them is an input entry left unchanged, and that no input entry is skipped
+// until the first entry after `separator`. Otherwise, e.g. for snapshots,
+// tombstones, compaction filters or sequence number zeroing, it calls
+// TableBuilder::AbandonReusableDataBlock(), and the entries added so far are
+// built into a data block as usual.
+struct ReusableDataBlock {
+  // As stored in the input table, without the block trailer
+  std::string stored_contents;
+  CompressionType compression_type = kNoCompression;
+  uint64_t uncompressed_size = 0;
+  // Of the input table, which determines the format of compressed blocks
+  uint32_t format_version = 0;
+  // Internal key at or after the last entry of the block, and before any
+  // entry coming after the block in the compaction
+  std::string separator;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -27,6 +27,9 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+class BlockCacheHeatmap;
+class HotKeyRanges;
+struct ReusableDataBlock;
 class Slice;
 class Status;
 
@@ -97,6 +100,10 @@ struct TableReaderOptions {
 
   // Whether the key in the table contains user-defined timestamps.
   bool user_defined_timestamps_persisted;
+
+  // Where to record the block cache hits and misses of the table, if
+  // anywhere
+  BlockCacheHeatmap* block_cache_heatmap = nullptr;
 };
 
 struct TableBuilderOptions : public TablePropertiesCollectorFactory::Context {
@@ -163,6 +170,9 @@ struct TableBuilderOptions : public TablePropertiesCollectorFactory::Context {
   // in the table options of the ioptions.table_factory
   bool skip_filters = false;
   const uint64_t cur_file_num;
+  // Set by compactions carrying the block cache hotness of their inputs over
+  // to their outputs, see HotKeyRanges
+  HotKeyRanges* hot_key_ranges = nullptr;
 };
 
 // TableBuilder provides the interface used to build a Table
@@ -182,6 +192,17 @@ class TableBuilder {
   // REQUIRES: Finish(), Abandon() have not been called
   virtual void Add(const Slice& key, const Slice& value) = 0;
 
+  // Used by compactions, see ReusableDataBlock. Announces that the entries
+  // added from the next call to Add() on, up to `block.separator`, are the
+  // entries of `block`, so that the table can store them as `block` is
+  // stored. Table formats without data blocks ignore it.
+  virtual void SetReusableDataBlock(ReusableDataBlock&& /*block*/) {}
+
+  // Used by compactions, see ReusableDataBlock. The entries added since the
+  // last call to SetReusableDataBlock() are not all the entries of the block
+  // left unchanged, so they are to be stored as any other entry.
+  virtual void AbandonReusableDataBlock() {}
+
   // Return non-ok iff some error has been detected.
   virtual Status status() const = 0;
 
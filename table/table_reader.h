@@ -109,6 +109,15 @@ class TableReader {
     return Status::NotSupported("ApproximateKeyAnchors() not supported.");
   }
 
+  // Appends to `ranges`, in order, the inclusive ranges of user keys from the
+  // first to the last key of runs of data blocks that are currently in the
+  // block cache.
+  virtual Status GetCachedKeyRanges(
+      const ReadOptions& /*read_options*/,
+      std::vector<std::pair<std::string, std::string>>& /*ranges*/) {
+    return Status::NotSupported("GetCachedKeyRanges() not supported.");
+  }
+
   // Set up the table for Compaction. Might change some parameters with
   // posix_fadvise
   virtual void SetupForCompaction() = 0;
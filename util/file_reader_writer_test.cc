@@ -228,6 +228,90 @@ TEST_F(WritableFileWriterTest, IncrementalBuffer) {
   }
 }
 
+TEST_F(WritableFileWriterTest, GatheredAppend) {
+  class FakeWF : public FSWritableFile {
+   public:
+    explicit FakeWF(std::string* _file_data) : file_data_(_file_data) {}
+    ~FakeWF() override = default;
+
+    using FSWritableFile::Append;
+    IOStatus Append(const Slice& data, const IOOptions& /*options*/,
+                    IODebugContext* /*dbg*/) override {
+      file_data_->append(data.data(), data.size());
+      size_ += data.size();
+      return IOStatus::OK();
+    }
+    IOStatus AppendV(const Slice* data, size_t num_slices,
+                     const IOOptions& /*options*/,
+                     IODebugContext* /*dbg*/) override {
+      ++num_appendv_;
+      for (size_t i = 0; i < num_slices; ++i) {
+        EXPECT_FALSE(data[i].empty());
+        file_data_->append(data[i].data(), data[i].size());
+        size_ += data[i].size();
+      }
+      return IOStatus::OK();
+    }
+    IOStatus Close(const IOOptions& /*options*/,
+                   IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+    IOStatus Flush(const IOOptions& /*options*/,
+                   IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+    IOStatus Sync(const IOOptions& /*options*/,
+                  IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+    uint64_t GetFileSize(const IOOptions& /*options*/,
+                         IODebugContext* /*dbg*/) override {
+      return size_;
+    }
+
+    std::string* file_data_;
+    size_t size_ = 0;
+    int num_appendv_ = 0;
+  };
+
+  EnvOptions env_options;
+  env_options.writable_file_max_buffer_size = 4096;
+  std::string actual;
+  auto* wf = new FakeWF(&actual);
+  std::unique_ptr<WritableFileWriter> writer(new WritableFileWriter(
+      std::unique_ptr<FSWritableFile>(wf), "" /* don't care */, env_options));
+
+  Random r(301);
+  std::string target;
+  // Fits in the buffer
+  std::string small1 = r.RandomString(100);
+  std::string small2 = r.RandomString(200);
+  Slice small[] = {small1, Slice(), small2};
+  ASSERT_OK(writer->Append(IOOptions(), small, 3));
+  target += small1 + small2;
+  ASSERT_EQ(0, wf->num_appendv_);
+  ASSERT_EQ(target.size(), writer->GetFileSize());
+
+  // Written together with the buffered data in one call
+  std::string large1 = r.RandomString(3000);
+  std::string large2 = r.RandomString(5000);
+  Slice large[] = {large1, large2};
+  ASSERT_OK(writer->Append(IOOptions(), large, 2));
+  target += large1 + large2;
+  ASSERT_EQ(1, wf->num_appendv_);
+  ASSERT_EQ(target, actual);
+  ASSERT_EQ(target.size(), writer->GetFileSize());
+
+  // Buffering resumes afterwards
+  std::string tail = r.RandomString(10);
+  ASSERT_OK(writer->Append(IOOptions(), tail));
+  target += tail;
+  ASSERT_OK(writer->Flush(IOOptions()));
+  ASSERT_OK(writer->Close(IOOptions()));
+  ASSERT_EQ(1, wf->num_appendv_);
+  ASSERT_EQ(target, actual);
+}
+
 TEST_F(WritableFileWriterTest, AlignedBufferedWrites) {
   class FakeWF : public FSWritableFile {
    public:
@@ -59,6 +59,22 @@ class BinaryHeap {
     return data_.front();
   }
 
+  // Returns the smallest element other than top().
+  // REQUIRES: size() > 1
+  const T& second_top() {
+    assert(size() > 1);
+    if (root_cmp_cache_ >= data_.size()) {
+      const size_t left_child = get_left(get_root());
+      const size_t right_child = left_child + 1;
+      root_cmp_cache_ = left_child;
+      if (right_child < data_.size() &&
+          cmp_(data_[left_child], data_[right_child])) {
+        root_cmp_cache_ = right_child;
+      }
+    }
+    return data_[root_cmp_cache_];
+  }
+
   void replace_top(const T& value) {
     assert(!empty());
     data_.front() = value;